@@ -3,27 +3,47 @@
 
 #include <string>
 #include <iostream>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include <Eigen/Core>
 
 #include <matlabCppInterface/internal/helpers.hpp>
 #include <matlabCppInterface/internal/MxArrayWrapper.hpp>
 #include <matlabCppInterface/internal/MxArrayNDimWrapper.hpp>
-
-#include <engine.h>
+#include <matlabCppInterface/internal/WorkerThread.hpp>
+#include <matlabCppInterface/VariableBatch.hpp>
+#include <matlabCppInterface/EngineBackend.hpp>
+#include <matlabCppInterface/SharedMemorySegment.hpp>
+#include <matlabCppInterface/Statistics.hpp>
+#include <matlabCppInterface/MxArrayPool.hpp>
+#include <matlabCppInterface/VariableInfo.hpp>
 
 namespace matlab {
 
 // Settings
 enum SETTINGS {
-	OUTPUT_BUFFER_SIZE = 256,
+	OUTPUT_BUFFER_SIZE = 256, // deprecated and unused, the output buffer grows as needed
 	INPUT_BUFFER_SIZE = 256
 };
 
+// How the output of commands is captured
+enum OUTPUT_CAPTURE {
+	CAPTURE_BUFFERED = 0, // output goes to a buffer, an output that does not fit is cut and the buffer grows for the next ones
+	CAPTURE_ALL, // the complete output is returned, no matter how long, by logging it to a file (slower)
+	CAPTURE_NONE // output is discarded without being buffered, e.g. for hot loops
+};
+
 ///
 /// @class Engine
 /// @brief a class that wraps the matlab C engine.
-/// @todo describe how this wrapper work
+///
+/// Values are converted to mxArrays here and handed to an EngineBackend that holds the
+/// session, by default the C engine library. A LoopbackBackend runs without Matlab.
 ///
 class Engine
 {
@@ -38,6 +58,11 @@ public:
   ///
   Engine(bool startMatlabAtInitialization);
 
+  ///
+  /// Constructor. Runs the session on the given backend, e.g. a LoopbackBackend
+  ///
+  explicit Engine(std::unique_ptr<EngineBackend> backend);
+
   ///
   /// Initialization
   ///
@@ -69,20 +94,14 @@ public:
   /// @param visible defines if Matlab is visible
   /// @return true if successful
   ///
-  bool setVisibility(bool visible) { return engSetVisible(_engine, static_cast<int>(visible)) == 0; }
+  bool setVisibility(bool visible);
 
   ///
   /// The Matlab instance is set to visible/invisible (Windows only!)
   ///
   /// @return true if successful
   ///
-  bool isVisible()
-  {
-	bool visible;
-	int success = engSetVisible(_engine, visible);
-	assert(success == 0 && "Determining the visibility was not possible. Matlab error");
-	return visible;
-  }
+  bool isVisible();
 #endif
 
   ///
@@ -93,6 +112,27 @@ public:
   ///
   std::string executeCommand(const std::string& command);
 
+  ///
+  /// Executes a command in Matlab, reusing the storage of output
+  ///
+  /// @param command The command to be executed (in Matlab syntax)
+  /// @param output is replaced by the Matlab output of the command
+  ///
+  void executeCommand(const std::string& command, std::string& output);
+
+  ///
+  /// Selects if and how completely the output of commands is captured
+  ///
+  void setOutputCapture(OUTPUT_CAPTURE outputCapture);
+  OUTPUT_CAPTURE getOutputCapture() const { return _outputCapture; }
+
+  ///
+  /// Sets a callback that receives the output in pieces while a command is still running
+  /// (in addition to the complete output being returned). An empty function disables it.
+  /// The callback is invoked from a helper thread, the output is captured like with CAPTURE_ALL.
+  ///
+  void setOutputCallback(const std::function<void(const std::string&)>& callback) { _outputCallback = callback; }
+
   ///
   /// Opens Matlab's workspace window
   ///
@@ -113,8 +153,53 @@ public:
   ///
   void openCommandLine();
 
+  ///
+  /// Selects the Matlab class numeric data is stored in by put
+  ///
+  /// @param numericStorage STORE_AS_DOUBLE (default) widens everything to double,
+  ///        STORE_NATIVE keeps the matching class, e.g. single for float
+  ///
+  void setNumericStorage(NUMERIC_STORAGE numericStorage) { _numericStorage = numericStorage; }
+  NUMERIC_STORAGE getNumericStorage() const { return _numericStorage; }
+
+  ///
+  /// The backend that holds the session
+  ///
+  EngineBackend& backend() { return *_backend; }
+
+  ///
+  /// Per-call counters and latencies of put, get, executeCommand, initialize and stop.
+  /// Disabled by default, enable with statistics().setEnabled(true)
+  ///
+  Statistics& statistics() { return _statistics; }
+  Statistics::Snapshot stats() const { return _statistics.snapshot(); }
+
+  ///
+  /// Recycles the mxArrays of put and putAsync, so a loop that puts same-shaped matrices
+  /// does not allocate a new array each time. Bounded by its capacity, 0 disables it
+  ///
+  MxArrayPool& arrayPool() { return _arrayPool; }
+
+  ///
+  /// Dense real numeric arrays of at least this many bytes are put and got through a shared
+  /// memory file that Matlab maps with memmapfile, only a short command goes through the engine.
+  /// Gets describe the variable first to decide. 0 (default) sends everything through the engine
+  ///
+  void setSharedMemoryThreshold(uint64_t bytes) { _sharedMemoryThreshold = bytes; }
+  uint64_t getSharedMemoryThreshold() const { return _sharedMemoryThreshold; }
+
+  ///
+  /// Where the shared memory files are created, /dev/shm by default. Should be a tmpfs
+  /// that Matlab can read, otherwise the data goes through the disk
+  ///
+  void setSharedMemoryDirectory(const std::string& directory) { _sharedMemoryDirectory = directory; }
+  const std::string& getSharedMemoryDirectory() const { return _sharedMemoryDirectory; }
+
 
   // TESTERS
+  //
+  // Only the metadata of the variable is transferred, not its data. isScalar, isEmpty
+  // and isCharOrString throw a std::runtime_error if the variable does not exist.
 
   bool exists(const std::string& name);
   bool isScalar(const std::string& name);
@@ -122,11 +207,23 @@ public:
   bool isCharOrString(const std::string& name);
   bool getDimensions(const std::string& name, size_t& rows, size_t& cols);
 
+  ///
+  /// Class, dimensions and size of several variables with a single query
+  ///
+  /// @return per name, the info of the variable, VariableInfo::exists is false if it does not exist
+  ///
+  std::vector<VariableInfo> describe(const std::vector<std::string>& names);
+  VariableInfo describe(const std::string& name);
+
 
   // SETTERS
+  // reflected structs (see StructTraits) are put as structs, std::vectors of them as struct arrays
+  // Eigen::SparseMatrix is put as a double sparse matrix, only its non-zeros are copied
+  // complex matrices, scalars and std::vectors of them are put as complex arrays, both parts in one transfer
   template <typename ValueType>
   bool put(const std::string& name, const ValueType& value);
 
+  // Eigen matrices and arrays of any scalar type, fixed size ones are checked and filled in place without allocating
   template <typename ValueType>
   bool get(const std::string& name, ValueType& rValue);
 
@@ -136,17 +233,120 @@ public:
   template <typename ValueType, typename AllocatorType>
   bool get(const std::string& name, std::vector<ValueType, AllocatorType>& rValue);
 
+  ///
+  /// Puts all values of a batch with a single transfer and a single command
+  ///
+  /// @return per put of the batch, true if the variable was set
+  ///
+  std::vector<bool> putMany(VariableBatch& batch);
+
+  ///
+  /// Gets all registered variables of a batch with a single command and a single transfer
+  ///
+  /// @return per get of the batch, true if the variable existed and could be converted
+  ///
+  std::vector<bool> getMany(VariableBatch& batch);
+
+
+  // ASYNCHRONOUS OPERATIONS
+  //
+  // Queued operations are executed in order by a worker thread, the caller can keep
+  // working meanwhile. Synchronous calls first wait for all queued operations and then
+  // run on the calling thread, so the order of all calls is preserved and the backend
+  // is never used by two threads at once. It is used from more than one thread though,
+  // the engine handle is not owned by the worker.
+
+  ///
+  /// Queues a command
+  ///
+  /// @param command The command to be executed (in Matlab syntax)
+  /// @return future of the Matlab output of the command
+  ///
+  std::future<std::string> executeCommandAsync(const std::string& command);
+
+  ///
+  /// Queues a put. The value is converted right away, it may be changed as soon as this returns
+  ///
+  /// @return future that is true if the variable was sent successfully
+  ///
+  template <typename ValueType>
+  std::future<bool> putAsync(const std::string& name, const ValueType& value);
+
+  ///
+  /// Queues a get
+  ///
+  /// @return future of the value, holds a std::runtime_error if the variable does not exist or does not fit the value
+  ///
+  template <typename ValueType>
+  std::future<ValueType> getAsync(const std::string& name);
+
+  ///
+  /// Blocks until all queued operations have been executed
+  ///
+  void waitForAsync();
+
 
 
 private:
   void assertIsInitialized() const;
 
-  /// The handle for the matlab engine
-  ::Engine *_engine;
+  /// The info of an existing variable, throws a std::runtime_error otherwise
+  VariableInfo describeExisting(const std::string& name);
+
+  /// Evaluates a command and captures its output, without waiting for queued operations
+  void evaluate(const std::string& command, std::string& output, Statistics::Call& call);
+
+  /// Sends the array through a shared memory file if it is above the threshold, otherwise through the backend
+  bool transferPut(const std::string& name, const mxArray* value);
+
+  /// Sends the array in the segment, through the backend if the file cannot be mapped on the other side
+  bool transferPut(const std::string& name, const SharedMemorySegment& segment, const SharedArrayDescriptor& array);
+
+  /// Fetches the variable like transferPut sends it, NULL if it does not exist
+  mxArray* transferGet(const std::string& name);
 
-  /// The output buffer in which returns of a command are stored
-  char _outputBuffer[OUTPUT_BUFFER_SIZE+1];
-  char _inputBuffer[OUTPUT_BUFFER_SIZE+1];
+  /// Creates a shared memory file for the elements if they are above the threshold and of a mappable class, NULL otherwise
+  template <typename Scalar>
+  std::shared_ptr<SharedMemorySegment> createShared(size_t nElements, SharedArrayDescriptor& rArray);
+
+  /// Converts a large dense matrix or vector of them straight into a shared memory file, NULL if it is sent as an mxArray
+  template <typename ValueType>
+  std::shared_ptr<SharedMemorySegment> convertShared(const ValueType& value, SharedArrayDescriptor& rArray)
+  { return convertSharedDense(value, rArray, IsDenseEigen<ValueType>()); }
+  template <typename ValueType, typename AllocatorType>
+  std::shared_ptr<SharedMemorySegment> convertShared(const std::vector<ValueType, AllocatorType>& value, SharedArrayDescriptor& rArray)
+  { return convertSharedSlices(value, rArray, IsDenseEigen<ValueType>()); }
+
+  template <typename ValueType>
+  std::shared_ptr<SharedMemorySegment> convertSharedDense(const ValueType& value, SharedArrayDescriptor& rArray, std::true_type isDense);
+  template <typename ValueType>
+  std::shared_ptr<SharedMemorySegment> convertSharedDense(const ValueType& value, SharedArrayDescriptor& rArray, std::false_type isDense) { return nullptr; }
+  template <typename ValueType, typename AllocatorType>
+  std::shared_ptr<SharedMemorySegment> convertSharedSlices(const std::vector<ValueType, AllocatorType>& value, SharedArrayDescriptor& rArray, std::true_type isDense);
+  template <typename ValueType, typename AllocatorType>
+  std::shared_ptr<SharedMemorySegment> convertSharedSlices(const std::vector<ValueType, AllocatorType>& value, SharedArrayDescriptor& rArray, std::false_type isDense) { return nullptr; }
+
+  /// The session, commands and variables go through it
+  std::unique_ptr<EngineBackend> _backend;
+
+  OUTPUT_CAPTURE _outputCapture;
+  std::function<void(const std::string&)> _outputCallback;
+
+  char _inputBuffer[INPUT_BUFFER_SIZE+1];
+
+  /// The class numeric data is stored in by put
+  NUMERIC_STORAGE _numericStorage;
+
+  Statistics _statistics;
+
+  /// Arrays of finished puts, reused by the next put of the same class and dimensions
+  MxArrayPool _arrayPool;
+
+  uint64_t _sharedMemoryThreshold;
+  std::string _sharedMemoryDirectory;
+
+  /// Executes the asynchronous operations, declared last so it is stopped first
+  WorkerThread _worker;
 };
 
 
@@ -155,16 +355,31 @@ bool Engine::put(const std::string& name, const ValueType& value)
 {
 	assertIsInitialized();
 	helpers::assertValidVariableName(name);
+	waitForAsync();
 
-	MxArrayWrapper<ValueType> mxArray(value);
+	Statistics::Call call(_statistics, Statistics::PUT);
+	call.conversion();
 
-	// send data and verify
-	int success = engPutVariable(_engine, name.c_str(), mxArray.mxArrayPtr());
-	if (success == 0)
+	// large dense matrices are converted straight into the shared memory file, without an mxArray
+	SharedArrayDescriptor descriptor;
+	std::shared_ptr<SharedMemorySegment> segment = convertShared(value, descriptor);
+	if (segment)
 	{
-		return true;
+		call.addBytes(segment->size());
+		call.transport();
+		bool success = transferPut(name, *segment, descriptor);
+		call.setSucceeded(success);
+		return success;
 	}
-	return false;
+
+	MxArrayWrapper<ValueType> mxArray(value, _numericStorage, &_arrayPool);
+	call.addArray(mxArray.mxArrayPtr());
+
+	// send data and verify
+	call.transport();
+	bool success = transferPut(name, mxArray.mxArrayPtr());
+	call.setSucceeded(success);
+	return success;
 }
 
 template <typename ValueType>
@@ -172,16 +387,23 @@ bool Engine::get(const std::string& name, ValueType& rValue)
 {
 	assertIsInitialized();
 	helpers::assertValidVariableName(name);
+	waitForAsync();
+
+	Statistics::Call call(_statistics, Statistics::GET);
+	call.transport();
 
 	// Get variable from matlab
 	MxArrayWrapper<ValueType> mxArrayWrapped;
-	mxArrayWrapped.mxArrayPtr() = engGetVariable(_engine, name.c_str());
+	mxArrayWrapped.mxArrayPtr() = transferGet(name);
 	if(mxArrayWrapped.mxArrayPtr() == NULL)
 	{
 		return false;
 	}
+	call.addArray(mxArrayWrapped.mxArrayPtr());
 
+	call.conversion();
 	mxArrayWrapped.get(rValue);
+	call.setSucceeded(true);
 	return true;
 }
 
@@ -192,16 +414,30 @@ bool Engine::put(const std::string& name, const std::vector<ValueType, Allocator
 {
 	assertIsInitialized();
 	helpers::assertValidVariableName(name);
+	waitForAsync();
 
-	MxArrayNDimWrapper<ValueType, AllocatorType> mxArray(value);
+	Statistics::Call call(_statistics, Statistics::PUT);
+	call.conversion();
 
-	// send data and verify
-	int success = engPutVariable(_engine, name.c_str(), mxArray.mxArrayPtr());
-	if (success == 0)
+	SharedArrayDescriptor descriptor;
+	std::shared_ptr<SharedMemorySegment> segment = convertShared(value, descriptor);
+	if (segment)
 	{
-		return true;
+		call.addBytes(segment->size());
+		call.transport();
+		bool success = transferPut(name, *segment, descriptor);
+		call.setSucceeded(success);
+		return success;
 	}
-	return false;
+
+	MxArrayNDimWrapper<ValueType, AllocatorType> mxArray(value, _numericStorage, &_arrayPool);
+	call.addArray(mxArray.mxArrayPtr());
+
+	// send data and verify
+	call.transport();
+	bool success = transferPut(name, mxArray.mxArrayPtr());
+	call.setSucceeded(success);
+	return success;
 }
 
 
@@ -210,17 +446,161 @@ bool Engine::get(const std::string& name, std::vector<ValueType, AllocatorType>&
 {
 	assertIsInitialized();
 	helpers::assertValidVariableName(name);
+	waitForAsync();
+
+	Statistics::Call call(_statistics, Statistics::GET);
+	call.transport();
 
 	// Get variable from matlab
 	MxArrayNDimWrapper<ValueType, AllocatorType> mxArrayNDimWrapped;
-	mxArrayNDimWrapped.mxArrayPtr() = engGetVariable(_engine, name.c_str());
+	mxArrayNDimWrapped.mxArrayPtr() = transferGet(name);
 	if(mxArrayNDimWrapped.mxArrayPtr() == NULL)
 	{
 		return false;
 	}
+	call.addArray(mxArrayNDimWrapped.mxArrayPtr());
 
-	mxArrayNDimWrapped.get(rValue);
-	return true;
+	call.conversion();
+	bool success = mxArrayNDimWrapped.get(rValue);
+	call.setSucceeded(success);
+	return success;
+}
+
+template <typename ValueType>
+std::future<bool> Engine::putAsync(const std::string& name, const ValueType& value)
+{
+	assertIsInitialized();
+	helpers::assertValidVariableName(name);
+
+	// the call is recorded when the queued task finishes, the time in the queue is not attributed
+	std::shared_ptr<Statistics::Call> call = std::make_shared<Statistics::Call>(_statistics, Statistics::PUT);
+
+	// convert now, the queued task takes over the shared memory file or the mxArray
+	call->conversion();
+	SharedArrayDescriptor descriptor;
+	std::shared_ptr<SharedMemorySegment> segment = convertShared(value, descriptor);
+	if (segment)
+	{
+		call->addBytes(segment->size());
+		call->pause();
+		return _worker.submit([this, name, segment, descriptor, call]()
+		{
+			call->transport();
+			bool success = transferPut(name, *segment, descriptor);
+			call->setSucceeded(success);
+			call->finish();
+			return success;
+		});
+	}
+
+	typename MxArrayWrapperFor<ValueType>::type mxArrayWrapped(value, _numericStorage, &_arrayPool);
+	std::shared_ptr<mxArray> array = sharedArray(&_arrayPool, mxArrayWrapped.release());
+	call->addArray(array.get());
+	call->pause();
+
+	// the worker is stopped before the engine is destroyed
+	return _worker.submit([this, name, array, call]()
+	{
+		call->transport();
+		bool success = transferPut(name, array.get());
+		call->setSucceeded(success);
+		call->finish();
+		return success;
+	});
+}
+
+template <typename Scalar>
+std::shared_ptr<SharedMemorySegment> Engine::createShared(size_t nElements, SharedArrayDescriptor& rArray)
+{
+	const char* className = SharedMemorySegment::className(storageClass<Scalar>(_numericStorage));
+	size_t bytes = nElements * (_numericStorage == STORE_NATIVE ? sizeof(Scalar) : sizeof(double));
+	if (_sharedMemoryThreshold == 0 || bytes < _sharedMemoryThreshold || className == NULL) { return nullptr; }
+
+	// falls back to an mxArray if the file cannot be created or mapped
+	std::shared_ptr<SharedMemorySegment> segment = std::make_shared<SharedMemorySegment>();
+	if (!segment->create(_sharedMemoryDirectory, bytes)) { return nullptr; }
+
+	rArray.file = segment->file();
+	rArray.className = className;
+	return segment;
+}
+
+template <typename ValueType>
+std::shared_ptr<SharedMemorySegment> Engine::convertSharedDense(const ValueType& value, SharedArrayDescriptor& rArray, std::true_type isDense)
+{
+	typedef typename ValueType::Scalar Scalar;
+	std::shared_ptr<SharedMemorySegment> segment = createShared<Scalar>(value.size(), rArray);
+	if (!segment) { return nullptr; }
+
+	rArray.dims = { static_cast<size_t>(value.rows()), static_cast<size_t>(value.cols()) };
+	if (_numericStorage == STORE_NATIVE)
+	{
+		evaluateInto(static_cast<Scalar*>(segment->data()), value);
+	} else
+	{
+		evaluateInto(static_cast<double*>(segment->data()), value);
+	}
+	return segment;
+}
+
+template <typename ValueType, typename AllocatorType>
+std::shared_ptr<SharedMemorySegment> Engine::convertSharedSlices(const std::vector<ValueType, AllocatorType>& value, SharedArrayDescriptor& rArray, std::true_type isDense)
+{
+	// empty vectors and slices of different sizes are reported by the mxArray conversion
+	if (value.empty()) { return nullptr; }
+	for (size_t i=1; i<value.size(); i++)
+	{
+		if (value[i].rows() != value[0].rows() || value[i].cols() != value[0].cols()) { return nullptr; }
+	}
+
+	typedef typename ValueType::Scalar Scalar;
+	std::shared_ptr<SharedMemorySegment> segment = createShared<Scalar>(value.size() * value[0].size(), rArray);
+	if (!segment) { return nullptr; }
+
+	rArray.dims = { static_cast<size_t>(value[0].rows()), static_cast<size_t>(value[0].cols()), value.size() };
+	if (_numericStorage == STORE_NATIVE)
+	{
+		castSlicesInto(static_cast<Scalar*>(segment->data()), value);
+	} else
+	{
+		castSlicesInto(static_cast<double*>(segment->data()), value);
+	}
+	return segment;
+}
+
+template <typename ValueType>
+std::future<ValueType> Engine::getAsync(const std::string& name)
+{
+	assertIsInitialized();
+	helpers::assertValidVariableName(name);
+
+	std::shared_ptr<Statistics::Call> call = std::make_shared<Statistics::Call>(_statistics, Statistics::GET);
+
+	return _worker.submit([this, name, call]() -> ValueType
+	{
+		call->transport();
+		typename MxArrayWrapperFor<ValueType>::type mxArrayWrapped;
+		mxArrayWrapped.mxArrayPtr() = transferGet(name);
+		if (mxArrayWrapped.mxArrayPtr() == NULL)
+		{
+			call->setSucceeded(false);
+			call->finish();
+			throw std::runtime_error("Variable " + name + " does not exist.");
+		}
+		call->addArray(mxArrayWrapped.mxArrayPtr());
+
+		call->conversion();
+		ValueType value;
+		if (!getWrapped(mxArrayWrapped, value))
+		{
+			call->setSucceeded(false);
+			call->finish();
+			throw std::runtime_error("Variable " + name + " does not fit the slices of the vector.");
+		}
+		call->setSucceeded(true);
+		call->finish();
+		return value;
+	});
 }
 
 
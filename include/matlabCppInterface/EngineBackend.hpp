@@ -0,0 +1,133 @@
+/*
+ * EngineBackend.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef ENGINEBACKEND_HPP_
+#define ENGINEBACKEND_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <matlabCppInterface/VariableInfo.hpp>
+#include <matlabCppInterface/SharedMemorySegment.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+///
+/// @class EngineBackend
+/// @brief the transport under matlab::Engine: a session that evaluates commands and holds a workspace.
+///
+/// Engine converts values to mxArrays and hands them to the backend, so the cost of the
+/// conversion can be measured apart from the cost of the transport. Calls are never made
+/// concurrently, Engine serializes them.
+///
+class EngineBackend
+{
+public:
+	typedef std::function<void(const std::string&)> OutputCallback;
+
+	virtual ~EngineBackend() {}
+
+	///
+	/// Starts the session, returns false if that was not possible
+	///
+	virtual bool open() = 0;
+
+	///
+	/// Ends the session, true if it was not open
+	///
+	virtual bool close() = 0;
+
+	virtual bool isOpen() const = 0;
+
+	///
+	/// Evaluates a command. Errors in the command are reported in the output like on the
+	/// command line, false means the session itself failed.
+	///
+	/// @param output is appended the complete output, NULL if it is not needed
+	/// @param callback if set, receives the output in pieces while the command runs
+	///
+	virtual bool evaluate(const std::string& command, std::string* output, const OutputCallback& callback) = 0;
+
+	///
+	/// Selects if output that does not fit a buffer is captured completely, at some extra cost
+	/// per command. Backends without such a buffer ignore it.
+	///
+	virtual void setUnboundedOutput(bool unboundedOutput) {}
+
+	///
+	/// Copies value into the workspace
+	///
+	virtual bool putVariable(const std::string& name, const mxArray* value) = 0;
+
+	///
+	/// @return a copy of the variable that is owned by the caller, NULL if it does not exist
+	///
+	virtual mxArray* getVariable(const std::string& name) = 0;
+
+	///
+	/// Loads a variable from a shared memory file, the caller removes the file afterwards.
+	/// Backends that cannot map files return false, Engine then falls back to putVariable.
+	///
+	virtual bool putVariableShared(const std::string& name, const SharedArrayDescriptor& array) { return false; }
+
+	///
+	/// Writes a variable into a shared memory file of its class and size, which the caller created.
+	/// False if the variable does not match the descriptor or the backend cannot map files.
+	///
+	virtual bool getVariableShared(const std::string& name, const SharedArrayDescriptor& array) { return false; }
+
+	///
+	/// Puts several variables at once and takes over the arrays. Names are unique.
+	/// By default the variables are put one after another.
+	///
+	virtual bool putVariables(const std::vector<std::string>& names, const std::vector<mxArray*>& values)
+	{
+		bool success = true;
+		for (size_t i=0; i<names.size(); i++)
+		{
+			success = putVariable(names[i], values[i]) && success;
+			mxDestroyArray(values[i]);
+		}
+		return success;
+	}
+
+	///
+	/// Gets several variables at once, missing ones are NULL. The caller owns the arrays.
+	/// By default the variables are fetched one after another.
+	///
+	virtual std::vector<mxArray*> getVariables(const std::vector<std::string>& names)
+	{
+		std::vector<mxArray*> values(names.size(), NULL);
+		for (size_t i=0; i<names.size(); i++)
+		{
+			values[i] = getVariable(names[i]);
+		}
+		return values;
+	}
+
+	///
+	/// Describes variables without handing out their data, missing ones do not exist.
+	/// By default each variable is fetched and thrown away, backends should do better.
+	///
+	virtual std::vector<VariableInfo> describeVariables(const std::vector<std::string>& names)
+	{
+		std::vector<VariableInfo> infos(names.size());
+		for (size_t i=0; i<names.size(); i++)
+		{
+			mxArray* value = getVariable(names[i]);
+			infos[i] = VariableInfo::describe(names[i], value);
+			if (value != NULL) { mxDestroyArray(value); }
+		}
+		return infos;
+	}
+};
+
+} // namespace matlab
+
+#endif /* ENGINEBACKEND_HPP_ */
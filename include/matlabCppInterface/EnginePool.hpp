@@ -0,0 +1,354 @@
+/*
+ * EnginePool.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef ENGINEPOOL_HPP_
+#define ENGINEPOOL_HPP_
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace matlab {
+
+// include matlabCppInterface/Engine.hpp to use the default engine type, the pool
+// itself does not depend on libeng
+class Engine;
+
+///
+/// @class EnginePool
+/// @brief runs jobs on N engine sessions in parallel.
+///
+/// Every session is owned by one worker thread. Jobs are queued per session; a
+/// worker that runs out of jobs steals from the back of the other queues. Jobs
+/// that depend on workspace state are pinned to a session and are never stolen.
+/// A job is any callable taking an EngineType&, its result is returned as a future.
+///
+/// EngineType needs a default constructor and initialize(), executeCommand(),
+/// put() and get() with the signatures of matlab::Engine, so the pool can be
+/// run against a stand-in engine.
+///
+template <class EngineType = Engine>
+class EnginePool
+{
+public:
+	struct Utilization
+	{
+		size_t jobsExecuted;
+		size_t jobsStolen; // executed jobs that were queued at another session
+		double busySeconds;
+		double utilization; // busy time relative to the lifetime of the pool
+	};
+
+	///
+	/// Starts and initializes nEngines sessions (in parallel)
+	///
+	explicit EnginePool(size_t nEngines);
+
+	///
+	/// Finishes all queued jobs and stops the sessions
+	///
+	~EnginePool();
+
+	size_t size() const { return _engines.size(); }
+
+	///
+	/// Queues a job on any session
+	///
+	template <typename Job>
+	std::future<typename std::result_of<Job(EngineType&)>::type> submit(Job job);
+
+	///
+	/// Queues a job on the given session, e.g. because it needs variables put there before
+	///
+	template <typename Job>
+	std::future<typename std::result_of<Job(EngineType&)>::type> submit(size_t engineIndex, Job job);
+
+	std::future<std::string> executeCommand(const std::string& command);
+
+	std::future<std::string> executeCommand(size_t engineIndex, const std::string& command);
+
+	// the value is copied into the job
+	template <typename ValueType>
+	std::future<bool> put(size_t engineIndex, const std::string& name, const ValueType& value);
+
+	// holds a std::runtime_error if the variable does not exist
+	template <typename ValueType>
+	std::future<ValueType> get(size_t engineIndex, const std::string& name);
+
+	///
+	/// Blocks until all queued jobs have been executed
+	///
+	void waitUntilIdle();
+
+	std::vector<Utilization> utilization();
+
+private:
+	typedef std::function<void(EngineType&)> QueuedJob;
+
+	struct Worker
+	{
+		Worker() : jobsExecuted(0), jobsStolen(0), busySeconds(0.0) {}
+
+		std::deque<QueuedJob> jobs; // can be stolen
+		std::deque<QueuedJob> pinnedJobs;
+		size_t jobsExecuted;
+		size_t jobsStolen;
+		double busySeconds;
+		std::thread thread;
+	};
+
+	template <typename Job>
+	std::future<typename std::result_of<Job(EngineType&)>::type> enqueue(size_t engineIndex, bool pinned, Job job);
+
+	// own pinned jobs first, then own jobs in order, then the newest job of another session
+	bool takeJob(size_t engineIndex, QueuedJob& job, bool& stolen);
+
+	void run(size_t engineIndex);
+
+	EnginePool(const EnginePool&);
+	EnginePool& operator=(const EnginePool&);
+
+	std::vector<std::unique_ptr<EngineType> > _engines;
+	std::vector<std::unique_ptr<Worker> > _workers;
+	std::mutex _mutex;
+	std::condition_variable _jobAvailable;
+	std::condition_variable _idle;
+	size_t _nextEngine;
+	size_t _nQueued;
+	size_t _nRunning;
+	bool _stopping;
+	std::chrono::steady_clock::time_point _start;
+};
+
+
+template <class EngineType>
+EnginePool<EngineType>::EnginePool(size_t nEngines) :
+	_nextEngine(0),
+	_nQueued(0),
+	_nRunning(0),
+	_stopping(false),
+	_start(std::chrono::steady_clock::now())
+{
+	if (nEngines == 0) { throw std::runtime_error("An engine pool needs at least one engine"); }
+
+	for (size_t i=0; i<nEngines; i++)
+	{
+		_engines.push_back(std::unique_ptr<EngineType>(new EngineType()));
+		_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+	}
+
+	// starting a session takes seconds, start them all at once
+	std::vector<char> initialized(nEngines, 0);
+	std::vector<std::thread> starters;
+	for (size_t i=0; i<nEngines; i++)
+	{
+		starters.push_back(std::thread([this, i, &initialized]() { initialized[i] = _engines[i]->initialize(); }));
+	}
+	for (size_t i=0; i<nEngines; i++) { starters[i].join(); }
+
+	for (size_t i=0; i<nEngines; i++)
+	{
+		if (!initialized[i]) { throw std::runtime_error("Could not initialize all engines of the pool"); }
+	}
+
+	for (size_t i=0; i<nEngines; i++)
+	{
+		_workers[i]->thread = std::thread(&EnginePool::run, this, i);
+	}
+}
+
+template <class EngineType>
+EnginePool<EngineType>::~EnginePool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_jobAvailable.notify_all();
+
+	for (size_t i=0; i<_workers.size(); i++)
+	{
+		if (_workers[i]->thread.joinable()) { _workers[i]->thread.join(); }
+	}
+}
+
+template <class EngineType>
+template <typename Job>
+std::future<typename std::result_of<Job(EngineType&)>::type> EnginePool<EngineType>::submit(Job job)
+{
+	// spread the jobs, idle sessions steal the rest
+	size_t engineIndex;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		engineIndex = _nextEngine;
+		_nextEngine = (_nextEngine + 1) % _engines.size();
+	}
+	return enqueue(engineIndex, false, job);
+}
+
+template <class EngineType>
+template <typename Job>
+std::future<typename std::result_of<Job(EngineType&)>::type> EnginePool<EngineType>::submit(size_t engineIndex, Job job)
+{
+	if (engineIndex >= _engines.size()) { throw std::runtime_error("Engine index out of range"); }
+	return enqueue(engineIndex, true, job);
+}
+
+template <class EngineType>
+std::future<std::string> EnginePool<EngineType>::executeCommand(const std::string& command)
+{
+	return submit([command](EngineType& engine) { return engine.executeCommand(command); });
+}
+
+template <class EngineType>
+std::future<std::string> EnginePool<EngineType>::executeCommand(size_t engineIndex, const std::string& command)
+{
+	return submit(engineIndex, [command](EngineType& engine) { return engine.executeCommand(command); });
+}
+
+template <class EngineType>
+template <typename ValueType>
+std::future<bool> EnginePool<EngineType>::put(size_t engineIndex, const std::string& name, const ValueType& value)
+{
+	return submit(engineIndex, [name, value](EngineType& engine) { return engine.put(name, value); });
+}
+
+template <class EngineType>
+template <typename ValueType>
+std::future<ValueType> EnginePool<EngineType>::get(size_t engineIndex, const std::string& name)
+{
+	return submit(engineIndex, [name](EngineType& engine) -> ValueType
+	{
+		ValueType value;
+		if (!engine.get(name, value)) { throw std::runtime_error("Variable " + name + " does not exist."); }
+		return value;
+	});
+}
+
+template <class EngineType>
+void EnginePool<EngineType>::waitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle.wait(lock, [this]() { return _nQueued == 0 && _nRunning == 0; });
+}
+
+template <class EngineType>
+std::vector<typename EnginePool<EngineType>::Utilization> EnginePool<EngineType>::utilization()
+{
+	double lifetime = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<Utilization> result(_workers.size());
+	for (size_t i=0; i<_workers.size(); i++)
+	{
+		result[i].jobsExecuted = _workers[i]->jobsExecuted;
+		result[i].jobsStolen = _workers[i]->jobsStolen;
+		result[i].busySeconds = _workers[i]->busySeconds;
+		result[i].utilization = (lifetime > 0.0) ? _workers[i]->busySeconds / lifetime : 0.0;
+	}
+	return result;
+}
+
+template <class EngineType>
+template <typename Job>
+std::future<typename std::result_of<Job(EngineType&)>::type> EnginePool<EngineType>::enqueue(size_t engineIndex, bool pinned, Job job)
+{
+	typedef typename std::result_of<Job(EngineType&)>::type Result;
+
+	// std::function needs a copyable target, packaged tasks are move only
+	std::shared_ptr<std::packaged_task<Result(EngineType&)> > task = std::make_shared<std::packaged_task<Result(EngineType&)> >(job);
+	std::future<Result> result = task->get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		Worker& worker = *_workers[engineIndex];
+		(pinned ? worker.pinnedJobs : worker.jobs).push_back([task](EngineType& engine) { (*task)(engine); });
+		_nQueued++;
+	}
+	// the session the job was queued at might be busy, any idle one may steal it
+	_jobAvailable.notify_all();
+
+	return result;
+}
+
+template <class EngineType>
+bool EnginePool<EngineType>::takeJob(size_t engineIndex, QueuedJob& job, bool& stolen)
+{
+	Worker& worker = *_workers[engineIndex];
+	stolen = false;
+
+	if (!worker.pinnedJobs.empty())
+	{
+		job = worker.pinnedJobs.front();
+		worker.pinnedJobs.pop_front();
+		return true;
+	}
+	if (!worker.jobs.empty())
+	{
+		job = worker.jobs.front();
+		worker.jobs.pop_front();
+		return true;
+	}
+
+	for (size_t i=1; i<_workers.size(); i++)
+	{
+		Worker& victim = *_workers[(engineIndex + i) % _workers.size()];
+		if (!victim.jobs.empty())
+		{
+			job = victim.jobs.back();
+			victim.jobs.pop_back();
+			stolen = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+template <class EngineType>
+void EnginePool<EngineType>::run(size_t engineIndex)
+{
+	Worker& worker = *_workers[engineIndex];
+	EngineType& engine = *_engines[engineIndex];
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true)
+	{
+		QueuedJob job;
+		bool stolen = false;
+		_jobAvailable.wait(lock, [&]() { return takeJob(engineIndex, job, stolen) || _stopping; });
+
+		// the queues are drained before stopping
+		if (!job) { return; }
+
+		_nQueued--;
+		_nRunning++;
+		lock.unlock();
+
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		job(engine);
+		double busySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		lock.lock();
+		_nRunning--;
+		worker.jobsExecuted++;
+		worker.jobsStolen += stolen ? 1 : 0;
+		worker.busySeconds += busySeconds;
+		if (_nQueued == 0 && _nRunning == 0) { _idle.notify_all(); }
+	}
+}
+
+} // namespace matlab
+
+#endif /* ENGINEPOOL_HPP_ */
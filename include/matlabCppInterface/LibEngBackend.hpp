@@ -0,0 +1,99 @@
+/*
+ * LibEngBackend.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef LIBENGBACKEND_HPP_
+#define LIBENGBACKEND_HPP_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <matlabCppInterface/EngineBackend.hpp>
+
+#include <engine.h>
+
+namespace matlab {
+
+///
+/// @class LibEngBackend
+/// @brief runs a Matlab session through the C engine library (libeng), the default backend.
+///
+/// Output goes to a buffer that grows after an output did not fit. With unbounded output
+/// or an output callback, it is logged with Matlab's diary to a temporary file instead.
+///
+class LibEngBackend : public EngineBackend
+{
+public:
+	LibEngBackend();
+	virtual ~LibEngBackend();
+
+	virtual bool open();
+	virtual bool close();
+	virtual bool isOpen() const { return _engine != NULL; }
+
+	virtual bool evaluate(const std::string& command, std::string* output, const OutputCallback& callback);
+	virtual void setUnboundedOutput(bool unboundedOutput) { _unboundedOutput = unboundedOutput; }
+
+	virtual bool putVariable(const std::string& name, const mxArray* value);
+	virtual mxArray* getVariable(const std::string& name);
+
+	///
+	/// Maps the file with memmapfile in Matlab, only the command goes through the engine
+	///
+	virtual bool putVariableShared(const std::string& name, const SharedArrayDescriptor& array);
+	virtual bool getVariableShared(const std::string& name, const SharedArrayDescriptor& array);
+
+	///
+	/// Sends all variables as fields of a single struct and unpacks them with one command
+	///
+	virtual bool putVariables(const std::vector<std::string>& names, const std::vector<mxArray*>& values);
+
+	///
+	/// Packs all variables into a single struct that is fetched with one transfer
+	///
+	virtual std::vector<mxArray*> getVariables(const std::vector<std::string>& names);
+
+	///
+	/// Runs whos in Matlab and fetches only its result
+	///
+	virtual std::vector<VariableInfo> describeVariables(const std::vector<std::string>& names);
+
+	/// The handle of the session, NULL if it is not open
+	::Engine* handle() { return _engine; }
+
+private:
+	/// Prepares the output capture of a new session
+	void setUpOutput();
+	void tearDownOutput();
+
+	/// Evaluates a command with the output going to the buffer
+	bool evaluateBuffered(const std::string& command, std::string& output);
+
+	/// Evaluates a command logged by the diary, callback may be empty
+	bool evaluateLogged(const std::string& command, std::string& output, const OutputCallback& callback);
+
+	/// Runs a shared memory transfer command, true if Matlab completed it without an error
+	bool evaluateTransfer(const std::string& command);
+
+	/// Appends everything the diary file holds beyond offset to output, returns the new offset
+	size_t readDiary(FILE* diary, size_t offset, std::string& output);
+
+	LibEngBackend(const LibEngBackend&);
+	LibEngBackend& operator=(const LibEngBackend&);
+
+	::Engine* _engine;
+
+	/// Output of commands is written here by Matlab, the last byte stays the terminator
+	std::vector<char> _outputBuffer;
+
+	/// Output of commands is logged to this file with Matlab's diary, created when needed
+	std::string _diaryFile;
+	bool _unboundedOutput;
+};
+
+} // namespace matlab
+
+#endif /* LIBENGBACKEND_HPP_ */
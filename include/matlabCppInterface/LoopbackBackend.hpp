@@ -0,0 +1,83 @@
+/*
+ * LoopbackBackend.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef LOOPBACKBACKEND_HPP_
+#define LOOPBACKBACKEND_HPP_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <matlabCppInterface/EngineBackend.hpp>
+
+namespace matlab {
+
+///
+/// @class LoopbackBackend
+/// @brief an in-process workspace with a minimal evaluator, to run Engine without Matlab.
+///
+/// Put and get copy mxArrays in and out of a local workspace. Commands are evaluated
+/// deterministically and support what is needed to profile and load-test put, eval and get:
+/// - statements separated by "," ";" or new lines, ";" suppresses the display
+/// - assignments "y = x", expressions without assignment set ans
+/// - + - * / .* ./ ^ .^ ' on real numeric values, with scalar expansion
+/// - matrix literals like [1 2; 3 4], strings 'text', indexing x(i) and x(i, j)
+/// - zeros, ones, eye, size, numel, disp, pi, Inf, NaN and the command "clear [names]"
+///
+/// Results of arithmetic are double. Errors are reported in the output, the rest of the
+/// command is skipped.
+///
+class LoopbackBackend : public EngineBackend
+{
+public:
+	LoopbackBackend();
+	virtual ~LoopbackBackend();
+
+	virtual bool open();
+
+	///
+	/// Ends the session and clears the workspace
+	///
+	virtual bool close();
+	virtual bool isOpen() const { return _open; }
+
+	virtual bool evaluate(const std::string& command, std::string* output, const OutputCallback& callback);
+
+	virtual bool putVariable(const std::string& name, const mxArray* value);
+	virtual mxArray* getVariable(const std::string& name);
+
+	///
+	/// Stand-in of the Matlab side of the shared memory transfer, maps the file in process
+	///
+	virtual bool putVariableShared(const std::string& name, const SharedArrayDescriptor& array);
+	virtual bool getVariableShared(const std::string& name, const SharedArrayDescriptor& array);
+
+	///
+	/// Moves the arrays into the workspace without copying them
+	///
+	virtual bool putVariables(const std::vector<std::string>& names, const std::vector<mxArray*>& values);
+
+	///
+	/// Reads the workspace without copying the arrays
+	///
+	virtual std::vector<VariableInfo> describeVariables(const std::vector<std::string>& names);
+
+	size_t numberOfVariables() const { return _workspace.size(); }
+
+	/// Variables are shared between names after an assignment, they are never changed in place
+	typedef std::map<std::string, std::shared_ptr<mxArray> > Workspace;
+
+private:
+	LoopbackBackend(const LoopbackBackend&);
+	LoopbackBackend& operator=(const LoopbackBackend&);
+
+	Workspace _workspace;
+	bool _open;
+};
+
+} // namespace matlab
+
+#endif /* LOOPBACKBACKEND_HPP_ */
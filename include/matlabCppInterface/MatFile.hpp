@@ -13,6 +13,12 @@
 #include <matlabCppInterface/internal/helpers.hpp>
 #include <matlabCppInterface/internal/MxArrayWrapper.hpp>
 #include <matlabCppInterface/internal/MxArrayNDimWrapper.hpp>
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+#include <matlabCppInterface/internal/MatV5Reader.hpp>
+#include <matlabCppInterface/internal/MatV5Directory.hpp>
+#include <matlabCppInterface/internal/MatSliceReader.hpp>
+#include <matlabCppInterface/Statistics.hpp>
+#include <matlabCppInterface/MxArrayPool.hpp>
 
 #include <mat.h>
 
@@ -26,7 +32,10 @@ public:
 		UPDATE,
 		WRITE, // normal write
 		WRITE_COMPRESSED, // write compressed (Matlab standard)
-		WRITE_HDF5 // for big data > 2GB
+		WRITE_HDF5, // for big data > 2GB
+		WRITE_NATIVE, // uncompressed, written by the built-in writer without libmat (write only)
+		READ_MAPPED, // read only, memory mapped without libmat (compressed variables are read through libmat)
+		WRITE_NATIVE_COMPRESSED // like WRITE_NATIVE, variables are compressed on several threads
 	};
 
 	MatFile();
@@ -48,6 +57,20 @@ public:
 
 	bool close();
 
+	// class numeric data is stored in by put and append, STORE_AS_DOUBLE by default
+	// STORE_NATIVE keeps the matching class, e.g. single for float
+	void setNumericStorage(NUMERIC_STORAGE numericStorage);
+	NUMERIC_STORAGE getNumericStorage() const { return _numericStorage; }
+
+	// zlib level of WRITE_NATIVE_COMPRESSED, 1 (fastest) to 9 (smallest), 6 by default, also applies to the following puts of an open file
+	// libmat chooses the level of WRITE_COMPRESSED itself
+	void setCompressionLevel(int level);
+	int getCompressionLevel() const { return _compressionLevel; }
+
+	// threads of WRITE_NATIVE_COMPRESSED, defaults to the number of cores
+	void setCompressionThreads(size_t threads) { _nativeWriter.setCompressionThreads(threads); }
+
+	// reflected structs (see StructTraits) are stored as structs, std::vectors of them as struct arrays
 	template <typename ValueType>
 	bool put(const std::string& name, const ValueType& value, bool globalVariable = false);
 
@@ -60,21 +83,77 @@ public:
 	template <typename ValueType, typename AllocatorType>
 	bool get(const std::string& name, std::vector<ValueType, AllocatorType>& rValue);
 
+	// reads a block of a real numeric variable, N-dimensional arrays are treated as rows x (numel/rows)
+	// only the block is read for Level 5 files and, if built with HDF5, for v7.3 files
+	// not available in WRITE_NATIVE mode
+	template <typename Derived>
+	bool getSlice(const std::string& name, IndexRange rows, IndexRange cols, Eigen::PlainObjectBase<Derived>& rValue);
+
+	// grows a numeric variable along its last dimension, only in WRITE_NATIVE and WRITE_NATIVE_COMPRESSED mode
+	// the data goes straight into the file in blocks of 64 KB per variable, appended variables are not compressed
+	// only variables created by append since the file was opened can grow, false for a name that was put
+	template <typename ValueType>
+	bool append(const std::string& name, const ValueType& value);
+
+	// zero-copy view on an uncompressed double variable, only in READ_MAPPED mode
+	// the view is valid until the file is closed
+	bool getMap(const std::string& name, Eigen::Map<const Eigen::MatrixXd>& view);
+
 	bool deleteVariable(const std::string& name);
 
+	// the metadata queries are answered from an index that is built when the file is opened,
+	// they are not available in WRITE_NATIVE mode
 	bool getVariableList(std::vector<std::string>& variableList);
 
 	void printVariableList(bool verbose = true);
 
 	bool getVariableInfo(const std::string& variableName, int& dimensions, bool& isGlobalVariable);
 
+	bool getVariableDims(const std::string& variableName, std::vector<size_t>& dims);
+
+	// per-call counters and latencies of open, close, put, append, get and getMap, disabled by default
+	Statistics& statistics() { return _statistics; }
+	Statistics::Snapshot stats() const { return _statistics.snapshot(); }
+
+	// recycles the mxArrays of repeated puts and appends, 0 capacity disables it
+	MxArrayPool& arrayPool() { return _arrayPool; }
+
 
 private:
+	// bytes of a variable in the mapped file, 0 if it does not exist
+	uint64_t mappedBytes(const std::string& name) const;
+
+	// builds the index of an existing file, with libmat for files that are not Level 5
+	void indexVariables(const std::string& filename);
+
+	// updates the index after a variable was written through libmat
+	void indexVariable(const std::string& name, const mxArray* array, bool globalVariable);
+
+	// reflected structs, sparse and complex matrices and vectors of strings are converted to an mxArray first,
+	// the writer streams all other types
+	template <typename ValueType>
+	bool writeNative(const std::string& name, const ValueType& value, bool globalVariable, std::false_type asMxArray);
+	template <typename ValueType>
+	bool writeNative(const std::string& name, const ValueType& value, bool globalVariable, std::true_type asMxArray);
+
+	// the mapped reader only reads dense numeric, logical and char variables
+	template <typename ValueType>
+	bool readMapped(const std::string& name, ValueType& rValue, std::false_type asMxArray) { return _mappedReader.read(name, rValue); }
+	template <typename ValueType>
+	bool readMapped(const std::string& name, ValueType& rValue, std::true_type asMxArray) { return false; }
+
 	MATFile* _file;
+	MatV5Writer _nativeWriter;
+	MatV5Reader _mappedReader;
+	MatV5Directory _directory;
 	std::string _filename;
 	bool _isOpen;
 	bool _isWritable;
 	bool _isModifyable;
+	NUMERIC_STORAGE _numericStorage;
+	int _compressionLevel;
+	Statistics _statistics;
+	MxArrayPool _arrayPool;
 };
 
 
@@ -84,9 +163,25 @@ bool MatFile::put(const std::string& name, const ValueType& value, bool globalVa
 	if (!_isOpen || !_isWritable) { return false; }
 	helpers::assertValidVariableName(name);
 
-	MxArrayWrapper<ValueType> mxArray(value);
+	Statistics::Call call(_statistics, Statistics::PUT);
+
+	if (_nativeWriter.isOpen())
+	{
+		// converted while written, there is no separate conversion
+		call.transport();
+		uint64_t bytesWritten = _nativeWriter.bytesWritten();
+		bool success = writeNative(name, value, globalVariable, typename IsWrittenAsMxArray<ValueType>::type());
+		call.addBytes(_nativeWriter.bytesWritten() - bytesWritten);
+		call.setSucceeded(success);
+		return success;
+	}
+
+	call.conversion();
+	MxArrayWrapper<ValueType> mxArray(value, _numericStorage, &_arrayPool);
+	call.addArray(mxArray.mxArrayPtr());
 
 	// send data and verify
+	call.transport();
 	int success = -1;
 	if (globalVariable)
 	{
@@ -96,42 +191,158 @@ bool MatFile::put(const std::string& name, const ValueType& value, bool globalVa
 		success = matPutVariable(_file, name.c_str(), mxArray.mxArrayPtr());
 	}
 
+	call.setSucceeded(success == 0);
 	if (success == 0)
 	{
+		indexVariable(name, mxArray.mxArrayPtr(), globalVariable);
 		return true;
 	}
 	return false;
 }
 
+template <typename ValueType>
+bool MatFile::writeNative(const std::string& name, const ValueType& value, bool globalVariable, std::false_type asMxArray)
+{
+	return _nativeWriter.write(name, value, globalVariable);
+}
+
+template <typename ValueType>
+bool MatFile::writeNative(const std::string& name, const ValueType& value, bool globalVariable, std::true_type asMxArray)
+{
+	typename MxArrayWrapperFor<ValueType>::type mxArray(value, _numericStorage, &_arrayPool);
+	return _nativeWriter.write(name, mxArray.mxArrayPtr(), globalVariable);
+}
+
 template <typename ValueType>
 bool MatFile::get(const std::string& name, ValueType& rValue)
 {
 	if (!_isOpen) { return false; }
 	helpers::assertValidVariableName(name);
 
+	Statistics::Call call(_statistics, Statistics::GET);
+
+	if (_mappedReader.isOpen() && _mappedReader.find(name) != NULL)
+	{
+		// the data is copied out of the mapping, reading the file is left to the page cache
+		call.conversion();
+		bool success = readMapped(name, rValue, typename IsWrittenAsMxArray<ValueType>::type());
+		if (call.isEnabled()) { call.addBytes(mappedBytes(name)); }
+		call.setSucceeded(success);
+		return success;
+	}
+
+	if (!_file) { return false; }
+
 	// Get variable from matlab
+	call.transport();
 	MxArrayWrapper<ValueType> mxArray;
 	mxArray.mxArrayPtr() = matGetVariable(_file, name.c_str());
 
-	mxArray.get(rValue);
-
 	if(mxArray.mxArrayPtr() == NULL)
 	{
 		return false;
 	}
+	call.addArray(mxArray.mxArrayPtr());
 
+	call.conversion();
+	mxArray.get(rValue);
+	call.setSucceeded(true);
 	return true;
 }
 
+template <typename Derived>
+bool MatFile::getSlice(const std::string& name, IndexRange rows, IndexRange cols, Eigen::PlainObjectBase<Derived>& rValue)
+{
+	if (!_isOpen || _nativeWriter.isOpen()) { return false; }
+	helpers::assertValidVariableName(name);
+
+	const MatV5Directory::Entry* entry = _directory.find(name);
+	if (entry == NULL || entry->dims.empty() || !entry->isNumeric() || entry->isComplex()) { return false; }
+
+	size_t nRows = entry->dims[0];
+	size_t nCols = (nRows == 0) ? 0 : entry->numberOfElements() / nRows;
+	if (!rows.resolve(nRows) || !cols.resolve(nCols)) { return false; }
+	if (Derived::RowsAtCompileTime != Eigen::Dynamic && size_t(Derived::RowsAtCompileTime) != rows.size) { return false; }
+	if (Derived::ColsAtCompileTime != Eigen::Dynamic && size_t(Derived::ColsAtCompileTime) != cols.size) { return false; }
+
+	Statistics::Call call(_statistics, Statistics::GET);
+	call.transport();
+
+	typedef typename Derived::Scalar Scalar;
+	Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> block(rows.size, cols.size);
+
+	bool success;
+	if (entry->offset != 0)
+	{
+		success = MatSliceReader::readV5(_filename, *entry, rows, cols, block.data());
+		call.addBytes(block.size()*sizeof(Scalar));
+	} else
+	{
+		// v7.3 files, or variables written through libmat since the file was opened
+		success = MatSliceReader::readHdf5(_filename, name, rows, cols, block.data());
+		if (success) { call.addBytes(block.size()*sizeof(Scalar)); }
+		if (!success && _file)
+		{
+			// libmat reads the whole variable, the block is cut out of it as rows x (numel/rows)
+			mxArray* variable = matGetVariable(_file, name.c_str());
+			call.addArray(variable);
+			success = variable != NULL && mxIsNumeric(variable) && !mxIsComplex(variable) && !mxIsSparse(variable)
+					&& mxGetM(variable) == nRows && mxGetNumberOfElements(variable) == nRows*nCols;
+
+			call.conversion();
+			for (size_t j=0; success && j<cols.size; j++)
+			{
+				copyFromMxArray(variable, (cols.first + j)*nRows + rows.first, rows.size, block.col(j).data());
+			}
+			if (variable != NULL) { mxDestroyArray(variable); }
+		}
+	}
+
+	call.setSucceeded(success);
+	if (success) { rValue = block; }
+	return success;
+}
+
+template <typename ValueType>
+bool MatFile::append(const std::string& name, const ValueType& value)
+{
+	if (!_isOpen || !_isWritable || !_nativeWriter.isOpen()) { return false; }
+	helpers::assertValidVariableName(name);
+
+	Statistics::Call call(_statistics, Statistics::PUT);
+	call.transport();
+	uint64_t bytesWritten = _nativeWriter.bytesWritten();
+	bool success = _nativeWriter.append(name, value);
+	call.addBytes(_nativeWriter.bytesWritten() - bytesWritten);
+	call.setSucceeded(success);
+	return success;
+}
+
 template <typename ValueType, typename AllocatorType>
 bool MatFile::put(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable)
 {
-	if (!_isOpen) { return false; }
+	if (!_isOpen || !_isWritable) { return false; }
 	helpers::assertValidVariableName(name);
 
-	MxArrayNDimWrapper<ValueType, AllocatorType> mxArray(value);
+	Statistics::Call call(_statistics, Statistics::PUT);
+
+	if (_nativeWriter.isOpen())
+	{
+		// converted while written, there is no separate conversion
+		call.transport();
+		uint64_t bytesWritten = _nativeWriter.bytesWritten();
+		bool success = writeNative(name, value, globalVariable, typename IsVectorWrittenAsMxArray<ValueType>::type());
+		call.addBytes(_nativeWriter.bytesWritten() - bytesWritten);
+		call.setSucceeded(success);
+		return success;
+	}
+
+	call.conversion();
+	MxArrayNDimWrapper<ValueType, AllocatorType> mxArray(value, _numericStorage, &_arrayPool);
+	call.addArray(mxArray.mxArrayPtr());
 
 	// send data and verify
+	call.transport();
 	int success = -1;
 	if (globalVariable)
 	{
@@ -141,8 +352,10 @@ bool MatFile::put(const std::string& name, const std::vector<ValueType, Allocato
 		success = matPutVariable(_file, name.c_str(), mxArray.mxArrayPtr());
 	}
 
+	call.setSucceeded(success == 0);
 	if (success == 0)
 	{
+		indexVariable(name, mxArray.mxArrayPtr(), globalVariable);
 		return true;
 	}
 
@@ -156,7 +369,22 @@ bool MatFile::get(const std::string& name, std::vector<ValueType, AllocatorType>
 	if (!_isOpen) { return false; }
 	helpers::assertValidVariableName(name);
 
+	Statistics::Call call(_statistics, Statistics::GET);
+
+	if (_mappedReader.isOpen() && _mappedReader.find(name) != NULL)
+	{
+		// the data is copied out of the mapping, reading the file is left to the page cache
+		call.conversion();
+		bool success = readMapped(name, rValue, typename IsWrittenAsMxArray<ValueType>::type());
+		if (call.isEnabled()) { call.addBytes(mappedBytes(name)); }
+		call.setSucceeded(success);
+		return success;
+	}
+
+	if (!_file) { return false; }
+
 	// Get variable from matlab
+	call.transport();
 	MxArrayNDimWrapper<ValueType, AllocatorType> mxArrayNDimWrapped;
 	mxArrayNDimWrapped.mxArrayPtr() = matGetVariable(_file, name.c_str());
 
@@ -164,9 +392,12 @@ bool MatFile::get(const std::string& name, std::vector<ValueType, AllocatorType>
 	{
 		return false;
 	}
+	call.addArray(mxArrayNDimWrapped.mxArrayPtr());
 
-	mxArrayNDimWrapped.get(rValue);
-	return true;
+	call.conversion();
+	bool success = mxArrayNDimWrapped.get(rValue);
+	call.setSucceeded(success);
+	return success;
 }
 
 
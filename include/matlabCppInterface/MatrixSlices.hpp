@@ -0,0 +1,109 @@
+/*
+ * MatrixSlices.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATRIXSLICES_HPP_
+#define MATRIXSLICES_HPP_
+
+#include <cassert>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace matlab {
+
+///
+/// @class MatrixSlices
+/// @brief a 3-D (or N-D) numeric array in one contiguous column major buffer, the alternative to std::vector<Matrix>.
+///
+/// The slices lie side by side in a rows x (cols*slices) matrix, exactly like Matlab stores
+/// the array, so put and get copy the data in one pass and math over the whole batch can
+/// use matrix(). slice(i) is a Map on the i-th rows x cols matrix. Dimensions after the
+/// third are numbered through as slices, dims() keeps the original shape.
+///
+/// Mapped MAT-files need no copy at all: MatFile::getMap views a 3-D variable in the same
+/// rows x (cols*slices) layout, slice i being view.middleCols(i*cols, cols).
+///
+template <typename Scalar_>
+class MatrixSlices
+{
+public:
+	typedef Scalar_ Scalar;
+	typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+	typedef Eigen::Map<Matrix> SliceMap;
+	typedef Eigen::Map<const Matrix> ConstSliceMap;
+
+	MatrixSlices() : _dims(3, 0) {}
+
+	MatrixSlices(Eigen::Index rows, Eigen::Index cols, Eigen::Index slices) { resize(rows, cols, slices); }
+
+	explicit MatrixSlices(const std::vector<size_t>& dims) { resize(dims); }
+
+	void resize(Eigen::Index rows, Eigen::Index cols, Eigen::Index slices)
+	{
+		std::vector<size_t> dims(3);
+		dims[0] = rows;
+		dims[1] = cols;
+		dims[2] = slices;
+		resize(dims);
+	}
+
+	// at least two dimensions, the buffer is only reallocated if the number of elements changes
+	void resize(const std::vector<size_t>& dims)
+	{
+		assert(dims.size() >= 2);
+		_dims = dims;
+		size_t cols = 1;
+		for (size_t i=1; i<dims.size(); i++) { cols *= dims[i]; }
+		_data.resize(dims[0], cols);
+	}
+
+	Eigen::Index rows() const { return _dims[0]; }
+	Eigen::Index cols() const { return _dims[1]; }
+
+	Eigen::Index slices() const
+	{
+		size_t slices = 1;
+		for (size_t i=2; i<_dims.size(); i++) { slices *= _dims[i]; }
+		return slices;
+	}
+
+	const std::vector<size_t>& dims() const { return _dims; }
+
+	Eigen::Index size() const { return _data.size(); }
+
+	SliceMap slice(Eigen::Index i)
+	{
+		assert(i >= 0 && i < slices());
+		return SliceMap(_data.data() + i*rows()*cols(), rows(), cols());
+	}
+
+	ConstSliceMap slice(Eigen::Index i) const
+	{
+		assert(i >= 0 && i < slices());
+		return ConstSliceMap(_data.data() + i*rows()*cols(), rows(), cols());
+	}
+
+	// all slices side by side, rows x (cols*slices); resize through MatrixSlices only
+	Matrix& matrix() { return _data; }
+	const Matrix& matrix() const { return _data; }
+
+	Scalar* data() { return _data.data(); }
+	const Scalar* data() const { return _data.data(); }
+
+	bool operator==(const MatrixSlices& other) const { return _dims == other._dims && _data == other._data; }
+	bool operator!=(const MatrixSlices& other) const { return !(*this == other); }
+
+private:
+	std::vector<size_t> _dims;
+	Matrix _data;
+};
+
+typedef MatrixSlices<double> MatrixSlicesXd;
+typedef MatrixSlices<float> MatrixSlicesXf;
+
+} // namespace matlab
+
+#endif /* MATRIXSLICES_HPP_ */
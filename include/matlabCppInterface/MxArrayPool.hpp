@@ -0,0 +1,133 @@
+/*
+ * MxArrayPool.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXARRAYPOOL_HPP_
+#define MXARRAYPOOL_HPP_
+
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "matrix.h"
+
+namespace matlab {
+
+///
+/// @class MxArrayPool
+/// @brief recycles the dense numeric arrays of repeated puts, keyed by class, complexity and dimensions.
+///
+/// Puts of the same shape every cycle reuse the array of the previous cycle instead of
+/// allocating (and page faulting) a new one. Released arrays are kept up to the capacity
+/// in bytes, beyond it and for other arrays (sparse, cells, structs, ...) they are destroyed.
+/// Recycled arrays are not initialized, the conversions overwrite every element.
+/// Thread safe, asynchronous puts release their arrays on the worker thread.
+///
+class MxArrayPool
+{
+public:
+	struct Counters
+	{
+		Counters() : hits(0), misses(0), recycled(0), discarded(0) {}
+
+		uint64_t hits; // acquired arrays that were recycled
+		uint64_t misses; // acquired arrays that had to be created
+		uint64_t recycled; // released arrays that were kept
+		uint64_t discarded; // released arrays that were destroyed
+	};
+
+	enum { DEFAULT_CAPACITY = 64 << 20 };
+
+	explicit MxArrayPool(uint64_t capacity = DEFAULT_CAPACITY);
+
+	// destroys the kept arrays
+	~MxArrayPool();
+
+	///
+	/// An uninitialized dense array, recycled if one of the same class, complexity and dimensions was released
+	///
+	mxArray* acquire(size_t nDims, const size_t* dims, mxClassID classId, mxComplexity complexity);
+
+	///
+	/// Takes the array back, the caller must not use it anymore
+	///
+	void release(mxArray* array);
+
+	///
+	/// Bytes of data the pool keeps at most, 0 disables the pool. Kept arrays beyond it are destroyed.
+	///
+	void setCapacity(uint64_t capacity);
+	uint64_t capacity() const;
+
+	// bytes of data of the kept arrays
+	uint64_t pooledBytes() const;
+
+	Counters counters() const;
+	void resetCounters();
+
+	// destroys all kept arrays
+	void clear();
+
+private:
+	struct Key
+	{
+		mxClassID classId;
+		bool isComplex;
+		std::vector<size_t> dims;
+
+		bool operator<(const Key& other) const;
+	};
+
+	static Key keyOf(const mxArray* array);
+
+	// destroys kept arrays until the capacity is met, the lock is held
+	void trim();
+
+	MxArrayPool(const MxArrayPool&);
+	MxArrayPool& operator=(const MxArrayPool&);
+
+	mutable std::mutex _mutex;
+	std::map<Key, std::vector<mxArray*> > _arrays;
+	uint64_t _capacity;
+	uint64_t _pooledBytes;
+	Counters _counters;
+};
+
+///
+/// Creates an uninitialized numeric array, from the pool if there is one
+///
+inline mxArray* createUninitArray(MxArrayPool* pool, size_t nDims, const size_t* dims, mxClassID classId, mxComplexity complexity)
+{
+	if (pool != NULL) { return pool->acquire(nDims, dims, classId, complexity); }
+	return mxCreateUninitNumericArray(nDims, dims, classId, complexity);
+}
+
+///
+/// Destroys the array or hands it back to the pool if there is one
+///
+inline void destroyArray(MxArrayPool* pool, mxArray* array)
+{
+	if (array == NULL) { return; }
+	if (pool != NULL)
+	{
+		pool->release(array);
+		return;
+	}
+	mxDestroyArray(array);
+}
+
+///
+/// Owns an array like the wrappers do, e.g. while it waits for an asynchronous put
+///
+inline std::shared_ptr<mxArray> sharedArray(MxArrayPool* pool, mxArray* array)
+{
+	return std::shared_ptr<mxArray>(array, [pool](mxArray* array) { destroyArray(pool, array); });
+}
+
+} // namespace matlab
+
+#endif /* MXARRAYPOOL_HPP_ */
@@ -0,0 +1,87 @@
+/*
+ * SharedMemorySegment.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef SHAREDMEMORYSEGMENT_HPP_
+#define SHAREDMEMORYSEGMENT_HPP_
+
+#include <string>
+#include <vector>
+
+#include "matrix.h"
+
+namespace matlab {
+
+///
+/// A dense real numeric array in a shared memory file, in Matlab's column major layout.
+/// Only this descriptor goes through the engine, Matlab maps the file with memmapfile.
+///
+struct SharedArrayDescriptor
+{
+	std::string file;
+	std::string className; // as returned by class() in Matlab, e.g. "double" or "uint8"
+	std::vector<size_t> dims;
+};
+
+///
+/// @class SharedMemorySegment
+/// @brief a file on a tmpfs (/dev/shm by default) that is memory mapped, to hand large arrays to Matlab without the engine pipe.
+///
+/// The creator of a segment removes its file when the segment is closed, segments that
+/// only open an existing file leave it in place.
+///
+class SharedMemorySegment
+{
+public:
+	static const char* DEFAULT_DIRECTORY;
+
+	SharedMemorySegment();
+
+	// unmaps the file and removes it if it was created
+	~SharedMemorySegment();
+
+	///
+	/// Creates a new file of bytes in the directory and maps it writable, false if that was not possible
+	///
+	bool create(const std::string& directory, size_t bytes);
+
+	///
+	/// Maps an existing file that has at least bytes
+	///
+	bool open(const std::string& file, size_t bytes, bool writable);
+
+	void close();
+
+	bool isOpen() const { return _data != NULL; }
+
+	void* data() { return _data; }
+	const void* data() const { return _data; }
+	size_t size() const { return _size; }
+	const std::string& file() const { return _file; }
+
+	///
+	/// The class of a dense real numeric array that can be transferred through a segment,
+	/// mxUNKNOWN_CLASS for all other classes (logical, char, cell, struct, ...)
+	///
+	static mxClassID numericClass(const std::string& className);
+
+	///
+	/// The inverse of numericClass, NULL for the classes that cannot be transferred
+	///
+	static const char* className(mxClassID classId);
+
+private:
+	SharedMemorySegment(const SharedMemorySegment&);
+	SharedMemorySegment& operator=(const SharedMemorySegment&);
+
+	std::string _file;
+	void* _data;
+	size_t _size;
+	bool _created;
+};
+
+} // namespace matlab
+
+#endif /* SHAREDMEMORYSEGMENT_HPP_ */
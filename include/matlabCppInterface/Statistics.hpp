@@ -0,0 +1,216 @@
+/*
+ * Statistics.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef STATISTICS_HPP_
+#define STATISTICS_HPP_
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "matrix.h"
+
+namespace matlab {
+
+///
+/// @class LatencyHistogram
+/// @brief latencies in power of two buckets of nanoseconds, bucket i holds [2^i, 2^(i+1))
+///
+class LatencyHistogram
+{
+public:
+	enum { NUMBER_OF_BUCKETS = 40 }; // up to about 18 minutes
+
+	LatencyHistogram() { reset(); }
+
+	void reset();
+
+	void record(uint64_t nanoseconds);
+
+	uint64_t count() const { return _count; }
+	uint64_t bucket(size_t i) const { return _buckets[i]; }
+	uint64_t minimum() const { return _count > 0 ? _minimum : 0; }
+	uint64_t maximum() const { return _maximum; }
+	double mean() const { return _count > 0 ? static_cast<double>(_total) / _count : 0.0; }
+
+	///
+	/// Upper bound of the bucket that contains the given fraction of calls, e.g. 0.99
+	///
+	uint64_t percentile(double fraction) const;
+
+private:
+	uint64_t _buckets[NUMBER_OF_BUCKETS];
+	uint64_t _count;
+	uint64_t _total;
+	uint64_t _minimum;
+	uint64_t _maximum;
+};
+
+///
+/// The statistics of one kind of call
+///
+struct OperationStatistics
+{
+	OperationStatistics() :
+		calls(0), failures(0), bytes(0), arrays(0), conversionNanoseconds(0), transportNanoseconds(0)
+	{}
+
+	uint64_t calls;
+	uint64_t failures;
+	uint64_t bytes; // payload of the mxArrays, commands and output or file data
+	uint64_t arrays; // mxArrays created for or received by the calls
+	uint64_t conversionNanoseconds; // between C++ types and mxArrays
+	uint64_t transportNanoseconds; // in libeng, libmat or the file
+	LatencyHistogram latency; // of complete calls, including time waiting in the queue for asynchronous calls
+};
+
+///
+/// @class Statistics
+/// @brief per-call instrumentation of Engine and MatFile, disabled by default.
+///
+/// While disabled a call costs a single flag check. Enabled, every call takes a few
+/// clock readings and a lock to record them.
+///
+class Statistics
+{
+public:
+	enum Operation {
+		PUT = 0,
+		GET,
+		EXECUTE_COMMAND,
+		OPEN,
+		CLOSE,
+		DESCRIBE,
+		NUMBER_OF_OPERATIONS
+	};
+
+	static const char* operationName(Operation operation);
+
+	struct Snapshot
+	{
+		Snapshot() : seconds(0.0) {}
+
+		const OperationStatistics& operator[](Operation operation) const { return operations[operation]; }
+
+		/// A table with one line per operation that was called
+		std::string toString() const;
+
+		OperationStatistics operations[NUMBER_OF_OPERATIONS];
+		double seconds; // since the statistics were enabled or reset
+	};
+
+	typedef std::function<void(const Snapshot&)> DumpCallback;
+
+	///
+	/// @class Call
+	/// @brief measures one call, the time after conversion() or transport() is attributed to it
+	///
+	/// A call is recorded as failed unless setSucceeded(true) is called, e.g. when a conversion throws.
+	///
+	class Call
+	{
+	public:
+		Call(Statistics& statistics, Operation operation);
+		~Call() { finish(); }
+
+		void conversion() { if (_statistics) { switchPhase(CONVERSION); } }
+		void transport() { if (_statistics) { switchPhase(TRANSPORT); } }
+		/// the time after this is not attributed, e.g. while waiting in a queue
+		void pause() { if (_statistics) { switchPhase(NONE); } }
+
+		/// counts an array and its payload
+		void addArray(const mxArray* array) { if (_statistics && array) { _arrays++; _bytes += payloadBytes(array); } }
+		void addBytes(uint64_t bytes) { _bytes += bytes; }
+		void setSucceeded(bool succeeded) { _succeeded = succeeded; }
+
+		bool isEnabled() const { return _statistics != NULL; }
+
+		/// records the call, done by the destructor if not before
+		void finish() { if (_statistics) { record(); } }
+
+	private:
+		enum Phase { NONE, CONVERSION, TRANSPORT };
+
+		void switchPhase(Phase phase);
+		void record();
+
+		Call(const Call&);
+		Call& operator=(const Call&);
+
+		Statistics* _statistics;
+		Operation _operation;
+		Phase _phase;
+		std::chrono::steady_clock::time_point _start;
+		std::chrono::steady_clock::time_point _phaseStart;
+		uint64_t _conversionNanoseconds;
+		uint64_t _transportNanoseconds;
+		uint64_t _bytes;
+		uint64_t _arrays;
+		bool _succeeded;
+	};
+
+	Statistics();
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+	void reset();
+
+	Snapshot snapshot() const;
+
+	///
+	/// Calls callback with a snapshot whenever interval has passed since the last dump. It is
+	/// invoked by the thread that finishes a call, there is no timer thread. An empty function
+	/// disables it.
+	///
+	void setDumpCallback(const DumpCallback& callback, std::chrono::milliseconds interval);
+
+	/// A dump callback that prints the table to std::cout
+	static void printSnapshot(const Snapshot& snapshot);
+
+	/// The payload of an mxArray, including fields and cells
+	static uint64_t payloadBytes(const mxArray* array);
+
+private:
+	void record(Operation operation, uint64_t nanoseconds, uint64_t conversionNanoseconds, uint64_t transportNanoseconds,
+			uint64_t bytes, uint64_t arrays, bool succeeded);
+
+	Snapshot snapshotLocked() const;
+
+	Statistics(const Statistics&);
+	Statistics& operator=(const Statistics&);
+
+	std::atomic<bool> _enabled;
+	mutable std::mutex _mutex;
+	OperationStatistics _operations[NUMBER_OF_OPERATIONS];
+	std::chrono::steady_clock::time_point _start;
+
+	DumpCallback _dumpCallback;
+	std::chrono::milliseconds _dumpInterval;
+	std::chrono::steady_clock::time_point _lastDump;
+};
+
+
+inline Statistics::Call::Call(Statistics& statistics, Operation operation) :
+	_statistics(statistics.isEnabled() ? &statistics : NULL),
+	_operation(operation),
+	_phase(NONE),
+	_conversionNanoseconds(0),
+	_transportNanoseconds(0),
+	_bytes(0),
+	_arrays(0),
+	_succeeded(false)
+{
+	// the clock is only read if the statistics are enabled
+	if (_statistics) { _start = _phaseStart = std::chrono::steady_clock::now(); }
+}
+
+} // namespace matlab
+
+#endif /* STATISTICS_HPP_ */
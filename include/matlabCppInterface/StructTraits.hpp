@@ -0,0 +1,60 @@
+/*
+ * StructTraits.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef STRUCTTRAITS_HPP_
+#define STRUCTTRAITS_HPP_
+
+#include <type_traits>
+
+namespace matlab {
+
+///
+/// Describes the fields of a C++ struct that is converted to and from a Matlab struct.
+/// Not reflected by default, use the macros below (at global scope) to describe a type:
+///
+///   MATLAB_STRUCT_BEGIN(Config)
+///     MATLAB_STRUCT_FIELD(gain)
+///     MATLAB_STRUCT_FIELD(weights)
+///   MATLAB_STRUCT_END()
+///
+/// A reflected struct is put as a 1x1 struct, a std::vector of it as a 1xN struct array.
+/// Fields can have any type the interface converts, including other reflected structs.
+/// Gets accept struct arrays and cell arrays of scalar structs, additional fields are ignored.
+///
+template <typename Type>
+struct StructTraits
+{
+	static const bool isReflected = false;
+
+	// calls visitor(const char* name, FieldType Type::* member) for each field
+	template <typename Visitor>
+	static void visitFields(Visitor& visitor) {}
+};
+
+template <typename Type>
+struct IsReflectedStruct : std::integral_constant<bool, StructTraits<Type>::isReflected> {};
+
+} // namespace matlab
+
+#define MATLAB_STRUCT_BEGIN(Type) \
+	namespace matlab { \
+	template <> struct StructTraits<Type> \
+	{ \
+		static const bool isReflected = true; \
+		typedef Type StructType; \
+		template <typename Visitor> \
+		static void visitFields(Visitor& visitor) \
+		{
+
+#define MATLAB_STRUCT_FIELD(field) \
+			visitor(#field, &StructType::field);
+
+#define MATLAB_STRUCT_END() \
+		} \
+	}; \
+	}
+
+#endif /* STRUCTTRAITS_HPP_ */
@@ -0,0 +1,145 @@
+/*
+ * VariableBatch.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef VARIABLEBATCH_HPP_
+#define VARIABLEBATCH_HPP_
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <matlabCppInterface/internal/helpers.hpp>
+#include <matlabCppInterface/internal/MxArrayWrapper.hpp>
+#include <matlabCppInterface/internal/MxArrayNDimWrapper.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+class Engine;
+
+///
+/// @class VariableBatch
+/// @brief collects named values for Engine::putMany and destinations for Engine::getMany.
+///
+/// All values of a batch travel in a single struct, i.e. one transfer and one
+/// evaluated command per batch instead of one transfer per variable.
+///
+/// Values are converted when they are added and handed over by putMany, which
+/// clears the puts of the batch. Gets stay registered, so a batch can fetch the
+/// same variables repeatedly. The destinations have to outlive the batch.
+///
+class VariableBatch
+{
+public:
+	VariableBatch(NUMERIC_STORAGE numericStorage = STORE_AS_DOUBLE) :
+		_numericStorage(numericStorage)
+	{}
+
+	~VariableBatch()
+	{
+		clear();
+	}
+
+	///
+	/// Converts and adds a value, values that cannot be converted are reported as failed by putMany
+	///
+	template <typename ValueType>
+	void put(const std::string& name, const ValueType& value);
+
+	///
+	/// Registers a destination, filled by getMany
+	///
+	template <typename ValueType>
+	void get(const std::string& name, ValueType& rValue);
+
+	size_t numberOfPuts() const { return _puts.size(); }
+	size_t numberOfGets() const { return _gets.size(); }
+
+	void clear()
+	{
+		for (size_t i=0; i<_puts.size(); i++)
+		{
+			if (_puts[i].value != NULL) { mxDestroyArray(_puts[i].value); }
+		}
+		_puts.clear();
+		_gets.clear();
+	}
+
+private:
+	friend class Engine;
+
+	struct Put
+	{
+		std::string name;
+		mxArray* value; // NULL if the conversion failed
+	};
+
+	struct Get
+	{
+		std::string name;
+		std::function<bool(mxArray*)> receive;
+	};
+
+	VariableBatch(const VariableBatch&);
+	VariableBatch& operator=(const VariableBatch&);
+
+	NUMERIC_STORAGE _numericStorage;
+	std::vector<Put> _puts;
+	std::vector<Get> _gets;
+};
+
+
+template <typename ValueType>
+void VariableBatch::put(const std::string& name, const ValueType& value)
+{
+	helpers::assertValidVariableName(name);
+
+	Put entry;
+	entry.name = name;
+	try
+	{
+		typename MxArrayWrapperFor<ValueType>::type mxArrayWrapped(value, _numericStorage);
+		entry.value = mxArrayWrapped.release();
+	}
+	catch (...)
+	{
+		entry.value = NULL;
+	}
+	_puts.push_back(entry);
+}
+
+template <typename ValueType>
+void VariableBatch::get(const std::string& name, ValueType& rValue)
+{
+	helpers::assertValidVariableName(name);
+
+	Get entry;
+	entry.name = name;
+	entry.receive = [&rValue](mxArray* array)
+	{
+		// the array stays owned by the engine
+		typename MxArrayWrapperFor<ValueType>::type mxArrayWrapped;
+		mxArrayWrapped.mxArrayPtr() = array;
+		bool success = false;
+		try
+		{
+			success = getWrapped(mxArrayWrapped, rValue);
+		}
+		catch (const std::runtime_error&)
+		{
+			success = false;
+		}
+		mxArrayWrapped.release();
+		return success;
+	};
+	_gets.push_back(entry);
+}
+
+} // namespace matlab
+
+#endif /* VARIABLEBATCH_HPP_ */
@@ -0,0 +1,78 @@
+/*
+ * VariableInfo.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef VARIABLEINFO_HPP_
+#define VARIABLEINFO_HPP_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <matlabCppInterface/Statistics.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+///
+/// @class VariableInfo
+/// @brief class, size and memory of a workspace variable, queried without transferring its data.
+///
+struct VariableInfo
+{
+	VariableInfo() :
+		exists(false), bytes(0), isComplex(false), isSparse(false), isGlobal(false)
+	{}
+
+	std::string name;
+	bool exists; // all other members are only set if the variable exists
+	std::string className; // as returned by class() in Matlab, e.g. "double", "char" or "struct"
+	std::vector<size_t> dims; // at least two
+	uint64_t bytes; // memory of the data as reported by whos
+	bool isComplex;
+	bool isSparse;
+	bool isGlobal;
+
+	size_t rows() const { return dims.empty() ? 0 : dims[0]; }
+
+	/// the product of all but the first dimension, like mxGetN
+	size_t cols() const
+	{
+		if (dims.empty()) { return 0; }
+		size_t n = 1;
+		for (size_t i=1; i<dims.size(); i++) { n *= dims[i]; }
+		return n;
+	}
+
+	size_t numberOfElements() const { return rows() * cols(); }
+	bool isEmpty() const { return numberOfElements() == 0; }
+	bool isScalar() const { return numberOfElements() == 1; }
+	bool isCharOrString() const { return className == "char" || className == "string"; }
+
+	///
+	/// Describes a local array, bytes are the payload of the array
+	///
+	static VariableInfo describe(const std::string& name, const mxArray* array)
+	{
+		VariableInfo info;
+		info.name = name;
+		if (array == NULL) { return info; }
+
+		info.exists = true;
+		info.className = mxGetClassName(array);
+		const mwSize* dims = mxGetDimensions(array);
+		info.dims.assign(dims, dims + mxGetNumberOfDimensions(array));
+		info.bytes = Statistics::payloadBytes(array);
+		info.isComplex = mxIsComplex(array);
+		info.isSparse = mxIsSparse(array);
+		info.isGlobal = mxIsFromGlobalWS(array);
+		return info;
+	}
+};
+
+} // namespace matlab
+
+#endif /* VARIABLEINFO_HPP_ */
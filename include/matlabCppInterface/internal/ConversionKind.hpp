@@ -0,0 +1,60 @@
+/*
+ * ConversionKind.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef CONVERSIONKIND_HPP_
+#define CONVERSIONKIND_HPP_
+
+#include <string>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include <matlabCppInterface/internal/MxStructConversion.hpp>
+#include <matlabCppInterface/internal/MxSparseConversion.hpp>
+#include <matlabCppInterface/internal/MxComplexConversion.hpp>
+#include <matlabCppInterface/internal/MxStringConversion.hpp>
+#include <matlabCppInterface/internal/MxSlicesConversion.hpp>
+
+namespace matlab {
+
+// how a type is converted, selects the convertFrom and convertTo overloads of the wrappers
+struct DenseConversion {};
+struct StructConversion {};
+struct SparseConversion {};
+struct ComplexConversion {};
+struct StringConversion {};
+struct SlicesConversion {};
+
+template <typename ContentType>
+struct ConversionKind
+{
+	typedef typename std::conditional<IsReflectedStruct<ContentType>::value, StructConversion,
+			typename std::conditional<IsSparseMatrix<ContentType>::value, SparseConversion,
+			typename std::conditional<IsComplexScalar<ContentType>::value || HasComplexScalar<ContentType>::value, ComplexConversion,
+			typename std::conditional<std::is_same<ContentType, std::string>::value, StringConversion,
+			typename std::conditional<IsMatrixSlices<ContentType>::value, SlicesConversion,
+			DenseConversion>::type>::type>::type>::type>::type type;
+};
+
+// types the built-in MAT-file writer stores by serializing their converted mxArray, it streams all others itself
+template <typename ContentType>
+struct IsWrittenAsMxArray : std::integral_constant<bool, std::is_same<typename ConversionKind<ContentType>::type, StructConversion>::value
+		|| std::is_same<typename ConversionKind<ContentType>::type, SparseConversion>::value
+		|| std::is_same<typename ConversionKind<ContentType>::type, ComplexConversion>::value> {};
+
+// the same for std::vectors of a type, vectors of strings are cell arrays
+template <typename ContentType>
+struct IsVectorWrittenAsMxArray : std::integral_constant<bool, IsWrittenAsMxArray<ContentType>::value
+		|| std::is_same<typename ConversionKind<ContentType>::type, StringConversion>::value> {};
+
+// dense Eigen matrices, arrays and expressions, the engine converts large ones straight into a shared memory file
+template <typename ContentType>
+struct IsDenseEigen : std::integral_constant<bool, std::is_same<typename ConversionKind<ContentType>::type, DenseConversion>::value
+		&& std::is_base_of<Eigen::EigenBase<ContentType>, ContentType>::value> {};
+
+} // namespace matlab
+
+#endif /* CONVERSIONKIND_HPP_ */
@@ -0,0 +1,148 @@
+/*
+ * MatSliceReader.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATSLICEREADER_HPP_
+#define MATSLICEREADER_HPP_
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <matlabCppInterface/internal/MatV5Directory.hpp>
+
+namespace matlab {
+
+///
+/// A range of rows or columns, ALL selects all of them
+///
+struct IndexRange
+{
+	enum { ALL = -1 };
+
+	IndexRange(size_t first = 0, size_t size = size_t(ALL)) : first(first), size(size) {}
+
+	static IndexRange all() { return IndexRange(); }
+
+	/// resolves ALL against the number of rows or columns, false if the range does not fit
+	bool resolve(size_t n)
+	{
+		if (size == size_t(ALL)) { size = (first <= n) ? n - first : 0; }
+		return first <= n && size <= n - first;
+	}
+
+	size_t first;
+	size_t size;
+};
+
+///
+/// @class MatSliceReader
+/// @brief reads a block of rows and columns of a numeric variable without reading the rest.
+///
+/// Variables are treated as rows x (numel/rows) matrices. Uncompressed Level 5 variables are
+/// read column by column with seeks, compressed ones are inflated as a stream that stops after
+/// the last column of the block. v7.3 files are read with an HDF5 hyperslab, if the library
+/// was built with HDF5. Memory scales with the block, not with the variable.
+///
+class MatSliceReader
+{
+public:
+	///
+	/// @param destination rows.size x cols.size, column-major
+	///
+	template <typename Scalar>
+	static bool readV5(const std::string& filename, const MatV5Directory::Entry& entry,
+			const IndexRange& rows, const IndexRange& cols, Scalar* destination);
+
+	template <typename Scalar>
+	static bool readHdf5(const std::string& filename, const std::string& name,
+			const IndexRange& rows, const IndexRange& cols, Scalar* destination);
+
+	/// true if the library was built with HDF5
+	static bool supportsHdf5();
+
+private:
+	// receives the raw data of the rows of one column of the block
+	typedef std::function<void(size_t column, const char* data)> ColumnSink;
+
+	static bool readV5Columns(const std::string& filename, const MatV5Directory::Entry& entry,
+			const IndexRange& rows, const IndexRange& cols, const ColumnSink& sink);
+
+	static bool readUncompressedColumns(FILE* file, const MatV5Directory::Entry& entry, size_t elementSize,
+			const IndexRange& rows, const IndexRange& cols, const ColumnSink& sink);
+
+	static bool inflateColumns(FILE* file, const MatV5Directory::Entry& entry, size_t elementSize,
+			const IndexRange& rows, const IndexRange& cols, const ColumnSink& sink);
+
+	// the block in its stored type, converted to matv5::DATA_TYPE
+	static bool readHdf5Block(const std::string& filename, const std::string& name,
+			const IndexRange& rows, const IndexRange& cols, uint32_t& dataType, std::vector<char>& block);
+
+	static size_t elementSize(uint32_t dataType);
+
+	template <typename Scalar>
+	static bool convert(uint32_t dataType, const char* source, size_t n, Scalar* destination);
+
+	template <typename Source, typename Scalar>
+	static void convert(const char* source, size_t n, Scalar* destination);
+};
+
+
+template <typename Scalar>
+bool MatSliceReader::readV5(const std::string& filename, const MatV5Directory::Entry& entry,
+		const IndexRange& rows, const IndexRange& cols, Scalar* destination)
+{
+	bool success = true;
+	return readV5Columns(filename, entry, rows, cols, [&](size_t column, const char* data)
+	{
+		success = convert(entry.dataType, data, rows.size, destination + column*rows.size) && success;
+	}) && success;
+}
+
+template <typename Scalar>
+bool MatSliceReader::readHdf5(const std::string& filename, const std::string& name,
+		const IndexRange& rows, const IndexRange& cols, Scalar* destination)
+{
+	uint32_t dataType;
+	std::vector<char> block;
+	return readHdf5Block(filename, name, rows, cols, dataType, block)
+			&& convert(dataType, block.data(), rows.size*cols.size, destination);
+}
+
+template <typename Scalar>
+bool MatSliceReader::convert(uint32_t dataType, const char* source, size_t n, Scalar* destination)
+{
+	switch (dataType)
+	{
+		case matv5::miDOUBLE: { convert<double>(source, n, destination); break; }
+		case matv5::miSINGLE: { convert<float>(source, n, destination); break; }
+		case matv5::miINT8: { convert<int8_t>(source, n, destination); break; }
+		case matv5::miUINT8: { convert<uint8_t>(source, n, destination); break; }
+		case matv5::miINT16: { convert<int16_t>(source, n, destination); break; }
+		case matv5::miUINT16: { convert<uint16_t>(source, n, destination); break; }
+		case matv5::miINT32: { convert<int32_t>(source, n, destination); break; }
+		case matv5::miUINT32: { convert<uint32_t>(source, n, destination); break; }
+		case matv5::miINT64: { convert<int64_t>(source, n, destination); break; }
+		case matv5::miUINT64: { convert<uint64_t>(source, n, destination); break; }
+		default: return false;
+	}
+	return true;
+}
+
+template <typename Source, typename Scalar>
+void MatSliceReader::convert(const char* source, size_t n, Scalar* destination)
+{
+	// the buffers come from std::vector<char>, they are aligned for any scalar
+	const Source* typedSource = reinterpret_cast<const Source*>(source);
+	for (size_t i=0; i<n; i++)
+	{
+		destination[i] = static_cast<Scalar>(typedSource[i]);
+	}
+}
+
+} // namespace matlab
+
+#endif /* MATSLICEREADER_HPP_ */
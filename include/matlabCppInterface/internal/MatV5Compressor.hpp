@@ -0,0 +1,125 @@
+/*
+ * MatV5Compressor.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5COMPRESSOR_HPP_
+#define MATV5COMPRESSOR_HPP_
+
+#include <stdint.h>
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <matlabCppInterface/internal/WorkerThread.hpp>
+
+namespace matlab {
+
+///
+/// @class MatV5Compressor
+/// @brief deflates the elements of variables into miCOMPRESSED elements on several threads.
+///
+/// The bytes of an element are collected in chunks, each chunk is deflated on its own by a
+/// pool of worker threads, the results are written in order. The chunks are joined into one
+/// zlib stream like pigz does: every chunk but the last ends with a sync flush, the checksum
+/// is combined from the checksums of the chunks. Chunks of one large variable and the chunks
+/// of consecutive small variables are compressed in parallel, memory is bounded by the number
+/// of chunks in flight. The length of an element is patched into its tag when it is complete.
+///
+class MatV5Compressor
+{
+public:
+	MatV5Compressor();
+
+	// writes all pending chunks
+	~MatV5Compressor();
+
+	// 0 disables compression, 1 (fastest) to 9 (smallest)
+	void setLevel(int level) { _level = level; }
+	int level() const { return _level; }
+
+	// applies from the next element on, at least one
+	void setThreads(size_t threads);
+	size_t threads() const { return _threads; }
+
+	///
+	/// Starts a compressed element in file, the following bytes are staged until end()
+	///
+	void begin(FILE* file);
+
+	bool isStaging() const { return _staging; }
+
+	bool stage(const void* data, size_t nBytes);
+
+	///
+	/// Finishes the element, it may still be written later, false if writing failed so far
+	///
+	bool end();
+
+	///
+	/// Writes all pending chunks, false if anything failed
+	///
+	bool flush();
+
+	// compressed bytes written to files
+	uint64_t bytesWritten() const { return _bytesWritten; }
+
+private:
+	// uncompressed bytes per chunk
+	enum { CHUNK_SIZE = 1 << 20 };
+
+	struct Chunk
+	{
+		Chunk() : adler(1), inputBytes(0), succeeded(false) {}
+
+		std::vector<char> data;
+		unsigned long adler; // of the uncompressed bytes
+		uint64_t inputBytes;
+		bool succeeded;
+	};
+
+	struct Pending
+	{
+		std::future<Chunk> chunk;
+		bool first; // of an element
+		bool last;
+	};
+
+	static Chunk deflateChunk(const std::vector<char>& input, int level, bool last);
+
+	void submit(bool last);
+
+	// writes the oldest pending chunk
+	void writePending();
+
+	bool write(const void* data, size_t nBytes);
+
+	MatV5Compressor(const MatV5Compressor&);
+	MatV5Compressor& operator=(const MatV5Compressor&);
+
+	int _level;
+	size_t _threads;
+	std::vector<std::unique_ptr<WorkerThread> > _workers;
+	size_t _nextWorker;
+
+	FILE* _file;
+	bool _staging;
+	bool _firstChunk;
+	std::shared_ptr<std::vector<char> > _staged;
+	std::deque<Pending> _pending;
+
+	// the element that is being written
+	int64_t _elementOffset;
+	uint64_t _elementBytes;
+	unsigned long _elementAdler;
+
+	uint64_t _bytesWritten;
+	bool _failed;
+};
+
+} // namespace matlab
+
+#endif /* MATV5COMPRESSOR_HPP_ */
@@ -0,0 +1,100 @@
+/*
+ * MatV5Directory.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5DIRECTORY_HPP_
+#define MATV5DIRECTORY_HPP_
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+
+namespace matlab {
+
+///
+/// @class MatV5Directory
+/// @brief index of the variables in a MAT-file, built in one pass over the variable headers.
+///
+/// Only the headers are read, the data of uncompressed variables is skipped with a seek
+/// and compressed variables are only inflated as far as their header. Files that are not
+/// Level 5 files in native byte order (e.g. v7.3 files) have to be indexed otherwise,
+/// entries can be added and removed as the file changes.
+///
+class MatV5Directory
+{
+public:
+	struct Entry
+	{
+		Entry() : arrayClass(0), flags(0), offset(0), bytes(0), compressed(false), dataType(0), dataOffset(0), dataBytes(0) {}
+
+		std::string name;
+		uint8_t arrayClass; // matv5::ARRAY_CLASS
+		uint8_t flags; // matv5::ARRAY_FLAGS
+		std::vector<size_t> dims;
+		uint64_t offset; // of the data element in the file, 0 if unknown
+		uint64_t bytes; // of the data element in the file including its tag, compressed if compressed, 0 if unknown
+		bool compressed;
+		uint32_t dataType; // storage type of the real part of numeric and char arrays, 0 if unknown
+		uint64_t dataOffset; // of the real part from the start of the (inflated) miMATRIX element
+		uint64_t dataBytes; // of the real part
+
+		size_t numberOfElements() const;
+		bool isNumeric() const { return arrayClass >= matv5::mxDOUBLE && arrayClass <= matv5::mxUINT64; }
+		bool isGlobal() const { return (flags & matv5::FLAG_GLOBAL) != 0; }
+		bool isComplex() const { return (flags & matv5::FLAG_COMPLEX) != 0; }
+		bool isLogical() const { return (flags & matv5::FLAG_LOGICAL) != 0; }
+	};
+
+	///
+	/// Replaces the index with the variables of a file, false if it is not a Level 5 file
+	/// in native byte order or could not be read
+	///
+	bool build(const std::string& filename);
+
+	void clear();
+
+	const std::vector<Entry>& entries() const { return _entries; }
+
+	const Entry* find(const std::string& name) const;
+
+	/// Adds an entry, replaces the entry of the same name
+	void insert(const Entry& entry);
+
+	bool erase(const std::string& name);
+
+	///
+	/// Forgets where the variables are, e.g. after libmat rewrote the file to delete or replace one
+	///
+	void invalidateOffsets();
+
+	///
+	/// Reads the header of the variable whose element starts at offset, false if there is none
+	///
+	static bool readEntry(FILE* file, uint64_t offset, Entry& entry);
+
+private:
+	// bytes of a variable that are read or inflated to parse its header
+	enum { HEADER_BYTES = 1024 };
+
+	// parses array flags, dimensions, name and the location of the real part of a miMATRIX element without its tag
+	static bool parseHeader(const char* data, uint64_t nBytes, Entry& entry);
+
+	// inflates the beginning of a miMATRIX element from a miCOMPRESSED element
+	static bool inflateHeader(FILE* file, uint64_t nBytes, std::vector<char>& header);
+
+	// reads the element at offset, entry.bytes is 0 at the end of the file, false if a variable cannot be parsed
+	static bool readElement(FILE* file, uint64_t offset, Entry& entry, bool& isVariable);
+
+	std::vector<Entry> _entries;
+	std::map<std::string, size_t> _index;
+};
+
+} // namespace matlab
+
+#endif /* MATV5DIRECTORY_HPP_ */
@@ -0,0 +1,255 @@
+/*
+ * MatV5Reader.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5READER_HPP_
+#define MATV5READER_HPP_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+
+namespace matlab {
+
+///
+/// @class MatV5Reader
+/// @brief memory maps an uncompressed Level 5 MAT-file and reads variables without libmat.
+///
+/// The variable headers are indexed once when the file is opened. Double matrices
+/// can then be accessed as Eigen::Map views straight into the mapping, all other
+/// supported types are copied (and converted) directly out of the mapping.
+/// Compressed variables are skipped, they cannot be mapped (see hasCompressedVariables).
+///
+class MatV5Reader
+{
+public:
+	struct Variable
+	{
+		std::string name;
+		uint8_t arrayClass;
+		uint8_t flags;
+		std::vector<size_t> dims;
+		uint32_t dataType; // storage type of the real part
+		const char* data; // real part inside the mapping, the elements of a cell array
+		uint64_t dataBytes;
+
+		size_t numberOfElements() const;
+		bool isGlobal() const { return (flags & matv5::FLAG_GLOBAL) != 0; }
+		bool isComplex() const { return (flags & matv5::FLAG_COMPLEX) != 0; }
+		bool isNumeric() const { return arrayClass >= matv5::mxDOUBLE && arrayClass <= matv5::mxUINT64; }
+	};
+
+	MatV5Reader();
+
+	~MatV5Reader();
+
+	bool open(const std::string& filename);
+
+	bool isOpen() const { return _mapping != NULL; }
+
+	bool close();
+
+	const std::vector<Variable>& variables() const { return _variables; }
+
+	const Variable* find(const std::string& name) const;
+
+	// true if the file has compressed variables, they are not indexed and have to be read otherwise
+	bool hasCompressedVariables() const { return _hasCompressedVariables; }
+
+	// view on a real double variable, N-dimensional arrays are mapped as rows x (numel/rows)
+	bool map(const std::string& name, Eigen::Map<const Eigen::MatrixXd>& view) const;
+
+	template <typename Derived>
+	bool read(const std::string& name, Eigen::PlainObjectBase<Derived>& value) const;
+
+	template <typename Scalar>
+	typename std::enable_if<std::is_arithmetic<Scalar>::value, bool>::type
+	read(const std::string& name, Scalar& value) const;
+
+	bool read(const std::string& name, bool& value) const;
+
+	bool read(const std::string& name, std::string& value) const;
+
+	// any real numeric variable with its dimensions, N-D arrays in one copy
+	template <typename Scalar>
+	bool read(const std::string& name, MatrixSlices<Scalar>& value) const;
+
+	// rows of a char matrix without trailing blanks or a cell array of char arrays
+	bool read(const std::string& name, std::vector<std::string>& value) const;
+
+	template <typename ValueType, typename AllocatorType>
+	bool read(const std::string& name, std::vector<ValueType, AllocatorType>& value) const;
+
+private:
+	bool index();
+
+	// parses flags, dimensions, name and data of a miMATRIX element, its subelements are in [offset, end)
+	bool parseArray(uint64_t offset, uint64_t end, Variable& variable) const;
+
+	// decodes n characters that are stride apart, starting at character "first", into value
+	bool readChars(const Variable& variable, size_t first, size_t n, size_t stride, std::string& value) const;
+
+	// reads a data element tag, supports the small data element format
+	bool readTag(uint64_t offset, uint64_t end, uint32_t& dataType, uint64_t& nBytes, uint64_t& dataOffset, uint64_t& nextOffset) const;
+
+	static size_t elementSize(uint32_t dataType);
+
+	// converts n elements of the real part starting at element "first" into the destination
+	template <typename Scalar>
+	bool copyData(const Variable& variable, size_t first, size_t n, Scalar* destination) const;
+
+	template <typename Source, typename Scalar>
+	static void convert(const char* source, size_t n, Scalar* destination);
+
+	template <typename ValueType, typename AllocatorType>
+	bool readVector(const Variable& variable, std::vector<ValueType, AllocatorType>& value, std::true_type isArithmetic) const;
+	template <typename ValueType, typename AllocatorType>
+	bool readVector(const Variable& variable, std::vector<ValueType, AllocatorType>& value, std::false_type isArithmetic) const;
+
+	MatV5Reader(const MatV5Reader&);
+	MatV5Reader& operator=(const MatV5Reader&);
+
+	const char* _mapping;
+	size_t _mappingSize;
+	std::vector<Variable> _variables;
+	std::map<std::string, size_t> _variableIndex;
+	bool _hasCompressedVariables;
+};
+
+
+template <typename Derived>
+bool MatV5Reader::read(const std::string& name, Eigen::PlainObjectBase<Derived>& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable || !variable->isNumeric() || variable->isComplex() || variable->dims.size() != 2) { return false; }
+
+	Eigen::Index rows = variable->dims[0];
+	Eigen::Index cols = variable->dims[1];
+
+	if (Derived::IsVectorAtCompileTime)
+	{
+		// like MxArrayWrapper, vectors are accepted in both orientations
+		if (rows != 1 && cols != 1) { return false; }
+		Eigen::Index size = rows*cols;
+		rows = (Derived::RowsAtCompileTime == 1) ? 1 : size;
+		cols = (Derived::ColsAtCompileTime == 1) ? 1 : size;
+	}
+
+	if (Derived::RowsAtCompileTime != Eigen::Dynamic && Derived::RowsAtCompileTime != rows) { return false; }
+	if (Derived::ColsAtCompileTime != Eigen::Dynamic && Derived::ColsAtCompileTime != cols) { return false; }
+	value.resize(rows, cols);
+
+	if (Derived::IsRowMajor && rows > 1 && cols > 1)
+	{
+		// on the stack for fixed sizes
+		Eigen::Matrix<typename Derived::Scalar, Derived::RowsAtCompileTime, 1, Eigen::ColMajor, Derived::MaxRowsAtCompileTime, 1> column(rows);
+		for (Eigen::Index col=0; col<cols; col++)
+		{
+			if (!copyData(*variable, col*rows, rows, column.data())) { return false; }
+			value.col(col) = column;
+		}
+		return true;
+	}
+	return copyData(*variable, 0, value.size(), value.data());
+}
+
+template <typename Scalar>
+typename std::enable_if<std::is_arithmetic<Scalar>::value, bool>::type
+MatV5Reader::read(const std::string& name, Scalar& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable || !variable->isNumeric() || variable->numberOfElements() != 1) { return false; }
+
+	return copyData(*variable, 0, 1, &value);
+}
+
+template <typename Scalar>
+bool MatV5Reader::read(const std::string& name, MatrixSlices<Scalar>& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable || !variable->isNumeric() || variable->isComplex() || variable->dims.size() < 2) { return false; }
+
+	value.resize(variable->dims);
+	return copyData(*variable, 0, value.size(), value.data());
+}
+
+template <typename ValueType, typename AllocatorType>
+bool MatV5Reader::read(const std::string& name, std::vector<ValueType, AllocatorType>& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable || !variable->isNumeric() || variable->isComplex()) { return false; }
+
+	return readVector(*variable, value, typename std::is_arithmetic<ValueType>::type());
+}
+
+template <typename ValueType, typename AllocatorType>
+bool MatV5Reader::readVector(const Variable& variable, std::vector<ValueType, AllocatorType>& value, std::true_type isArithmetic) const
+{
+	value.resize(variable.numberOfElements());
+	return copyData(variable, 0, value.size(), value.data());
+}
+
+template <typename ValueType, typename AllocatorType>
+bool MatV5Reader::readVector(const Variable& variable, std::vector<ValueType, AllocatorType>& value, std::false_type isArithmetic) const
+{
+	// matrices are stacked along the third dimension, see MxArrayNDimWrapper
+	if (variable.dims.size() != 3) { return false; }
+
+	const Eigen::Index rows = variable.dims[0];
+	const Eigen::Index cols = variable.dims[1];
+	if (ValueType::RowsAtCompileTime != Eigen::Dynamic && ValueType::RowsAtCompileTime != rows) { return false; }
+	if (ValueType::ColsAtCompileTime != Eigen::Dynamic && ValueType::ColsAtCompileTime != cols) { return false; }
+
+	value.resize(variable.dims[2]);
+	for (size_t i=0; i<value.size(); i++)
+	{
+		value[i].resize(rows, cols);
+		if (!copyData(variable, i*rows*cols, rows*cols, value[i].data())) { return false; }
+	}
+	return true;
+}
+
+template <typename Scalar>
+bool MatV5Reader::copyData(const Variable& variable, size_t first, size_t n, Scalar* destination) const
+{
+	if ((first + n)*elementSize(variable.dataType) > variable.dataBytes) { return false; }
+
+	switch (variable.dataType)
+	{
+		case matv5::miDOUBLE: { convert<double>(variable.data + first*sizeof(double), n, destination); break; }
+		case matv5::miSINGLE: { convert<float>(variable.data + first*sizeof(float), n, destination); break; }
+		case matv5::miINT8: { convert<int8_t>(variable.data + first*sizeof(int8_t), n, destination); break; }
+		case matv5::miUINT8: { convert<uint8_t>(variable.data + first*sizeof(uint8_t), n, destination); break; }
+		case matv5::miINT16: { convert<int16_t>(variable.data + first*sizeof(int16_t), n, destination); break; }
+		case matv5::miUINT16: { convert<uint16_t>(variable.data + first*sizeof(uint16_t), n, destination); break; }
+		case matv5::miINT32: { convert<int32_t>(variable.data + first*sizeof(int32_t), n, destination); break; }
+		case matv5::miUINT32: { convert<uint32_t>(variable.data + first*sizeof(uint32_t), n, destination); break; }
+		case matv5::miINT64: { convert<int64_t>(variable.data + first*sizeof(int64_t), n, destination); break; }
+		case matv5::miUINT64: { convert<uint64_t>(variable.data + first*sizeof(uint64_t), n, destination); break; }
+		default: return false;
+	}
+	return true;
+}
+
+template <typename Source, typename Scalar>
+void MatV5Reader::convert(const char* source, size_t n, Scalar* destination)
+{
+	// data elements are 64 bit aligned inside the mapping
+	const Source* typedSource = reinterpret_cast<const Source*>(source);
+	for (size_t i=0; i<n; i++)
+	{
+		destination[i] = static_cast<Scalar>(typedSource[i]);
+	}
+}
+
+} // namespace matlab
+
+#endif /* MATV5READER_HPP_ */
@@ -0,0 +1,544 @@
+/*
+ * MatV5Writer.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5WRITER_HPP_
+#define MATV5WRITER_HPP_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include <matlabCppInterface/MatrixSlices.hpp>
+#include <matlabCppInterface/internal/helpers.hpp>
+#include <matlabCppInterface/internal/MatV5Compressor.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+// Constants of the Level 5 MAT-file format, see "MAT-File Format" (The MathWorks)
+namespace matv5 {
+
+enum DATA_TYPE {
+	miINT8 = 1,
+	miUINT8 = 2,
+	miINT16 = 3,
+	miUINT16 = 4,
+	miINT32 = 5,
+	miUINT32 = 6,
+	miSINGLE = 7,
+	miDOUBLE = 9,
+	miINT64 = 12,
+	miUINT64 = 13,
+	miMATRIX = 14,
+	miCOMPRESSED = 15,
+	miUTF8 = 16
+};
+
+enum ARRAY_CLASS {
+	mxCELL = 1,
+	mxSTRUCT = 2,
+	mxOBJECT = 3,
+	mxCHAR = 4,
+	mxSPARSE = 5,
+	mxDOUBLE = 6,
+	mxSINGLE = 7,
+	mxINT8 = 8,
+	mxUINT8 = 9,
+	mxINT16 = 10,
+	mxUINT16 = 11,
+	mxINT32 = 12,
+	mxUINT32 = 13,
+	mxINT64 = 14,
+	mxUINT64 = 15
+};
+
+enum ARRAY_FLAGS {
+	FLAG_LOGICAL = 0x02,
+	FLAG_GLOBAL = 0x04,
+	FLAG_COMPLEX = 0x08
+};
+
+const size_t HEADER_SIZE = 128;
+const size_t TAG_SIZE = 8;
+
+// data elements are padded to 64 bit boundaries
+inline uint64_t padded(uint64_t nBytes) { return (nBytes + 7) & ~uint64_t(7); }
+
+// array class, storage type and flags a C++ type is written with
+template <typename Scalar> struct Traits;
+
+template <> struct Traits<double> { enum { arrayClass = mxDOUBLE, dataType = miDOUBLE, flags = 0 }; };
+template <> struct Traits<float> { enum { arrayClass = mxSINGLE, dataType = miSINGLE, flags = 0 }; };
+template <> struct Traits<int8_t> { enum { arrayClass = mxINT8, dataType = miINT8, flags = 0 }; };
+template <> struct Traits<uint8_t> { enum { arrayClass = mxUINT8, dataType = miUINT8, flags = 0 }; };
+template <> struct Traits<int16_t> { enum { arrayClass = mxINT16, dataType = miINT16, flags = 0 }; };
+template <> struct Traits<uint16_t> { enum { arrayClass = mxUINT16, dataType = miUINT16, flags = 0 }; };
+template <> struct Traits<int32_t> { enum { arrayClass = mxINT32, dataType = miINT32, flags = 0 }; };
+template <> struct Traits<uint32_t> { enum { arrayClass = mxUINT32, dataType = miUINT32, flags = 0 }; };
+template <> struct Traits<int64_t> { enum { arrayClass = mxINT64, dataType = miINT64, flags = 0 }; };
+template <> struct Traits<uint64_t> { enum { arrayClass = mxUINT64, dataType = miUINT64, flags = 0 }; };
+template <> struct Traits<bool> { enum { arrayClass = mxUINT8, dataType = miUINT8, flags = FLAG_LOGICAL }; };
+
+} // namespace matv5
+
+///
+/// @class MatV5Writer
+/// @brief streams variables into a Level 5 MAT-file without going through libmat.
+///
+/// Data is written straight from the caller's buffers (or converted in small
+/// chunks if the scalar type does not match), no intermediate mxArray is created.
+/// Numeric data is stored as double unless STORE_NATIVE is selected, in which case
+/// each type keeps its matching class (float as single, int as int32, ...).
+/// With a compression level each variable is deflated into a miCOMPRESSED element
+/// on a pool of threads (see MatV5Compressor), the file can be read by Matlab as usual.
+/// Every name can only be written once, writes and appends to a name that is already
+/// in the file return false.
+///
+class MatV5Writer
+{
+public:
+	MatV5Writer();
+
+	~MatV5Writer();
+
+	bool open(const std::string& filename);
+
+	bool isOpen() const { return _file != NULL; }
+
+	bool close();
+
+	// applies to all following writes and newly appended variables
+	void setNumericStorage(NUMERIC_STORAGE numericStorage) { _numericStorage = numericStorage; }
+
+	// 0 writes uncompressed variables, 1 (fastest) to 9 (smallest) compresses them, applies to the following writes
+	void setCompressionLevel(int level) { _compressor.setLevel(level); }
+	int getCompressionLevel() const { return _compressor.level(); }
+
+	// threads that compress variables in parallel, defaults to the number of cores
+	void setCompressionThreads(size_t threads) { _compressor.setThreads(threads); }
+
+	// bytes written to files since construction, including appended variables and the elements they moved
+	uint64_t bytesWritten() const { return _bytesWritten + _compressor.bytesWritten(); }
+
+	template <typename Derived>
+	bool write(const std::string& name, const Eigen::DenseBase<Derived>& value, bool globalVariable = false);
+
+	template <typename Scalar>
+	typename std::enable_if<std::is_arithmetic<Scalar>::value, bool>::type
+	write(const std::string& name, const Scalar& value, bool globalVariable = false);
+
+	bool write(const std::string& name, const bool& value, bool globalVariable = false);
+
+	bool write(const std::string& name, const std::string& value, bool globalVariable = false);
+
+	template <typename ValueType, typename AllocatorType>
+	bool write(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable = false);
+
+	// keeps the dimensions of the slices, the buffer is written as it is
+	template <typename Scalar>
+	bool write(const std::string& name, const MatrixSlices<Scalar>& value, bool globalVariable = false);
+
+	///
+	/// Writes a converted array, e.g. a reflected struct. Numeric (also complex), logical, char,
+	/// struct, cell and real double sparse arrays are supported, false for other classes.
+	///
+	bool write(const std::string& name, const mxArray* value, bool globalVariable = false);
+
+	///
+	/// Appends a slice to a variable along a new last dimension. The first call defines
+	/// the slice size: scalars grow a 1xN row, vectors (row or column) of n elements an
+	/// nxN matrix and matrices an rows x cols x N array.
+	///
+	/// Each appended variable is an uncompressed element in the file that grows in place.
+	/// The slices are collected in a small buffer per variable and written into the element
+	/// when it is full, then the sizes in the element header are patched. A file that is not
+	/// closed still holds all variables up to their last write. If the element of a variable
+	/// is followed by other elements, they are moved to the end of the file to reserve room
+	/// for at least as many slices again. The unused rest of a reservation stays inside the
+	/// element, readers go from one element to the next by their sizes.
+	///
+	template <typename Derived>
+	bool append(const std::string& name, const Eigen::DenseBase<Derived>& value);
+
+	template <typename Scalar>
+	typename std::enable_if<std::is_arithmetic<Scalar>::value, bool>::type
+	append(const std::string& name, const Scalar& value);
+
+	template <typename Scalar, typename AllocatorType>
+	bool append(const std::string& name, const std::vector<Scalar, AllocatorType>& value);
+
+private:
+	struct AppendedVariable
+	{
+		AppendedVariable() :
+			offset(0), headerBytes(0), capacity(0), arrayClass(0), dataType(0), flags(0),
+			elementSize(0), sliceSize(0), nSlices(0), nWritten(0)
+		{}
+
+		uint64_t offset; // of the element in the file
+		uint64_t headerBytes; // from the element tag up to the data
+		uint64_t capacity; // bytes of the element reserved for the data
+		uint8_t arrayClass;
+		uint32_t dataType;
+		uint8_t flags;
+		size_t elementSize;
+		std::vector<uint32_t> sliceDims;
+		uint64_t sliceSize;
+		uint64_t nSlices; // appended so far
+		uint64_t nWritten; // in the file, the others are buffered
+		std::vector<char> buffer;
+	};
+
+	enum {
+		// number of elements that are converted at once if the data is not double
+		CONVERSION_CHUNK_SIZE = 1024,
+		// bytes an appended variable collects before they are written into the file
+		APPEND_BUFFER_SIZE = 1 << 16,
+		// bytes that are moved at once when the elements behind an appended variable make room
+		MOVE_CHUNK_SIZE = 1 << 20
+	};
+
+	bool writeHeader();
+
+	// returns the variable the slice is appended to, NULL if the slice (or its type) does not fit
+	template <typename Target>
+	AppendedVariable* beginAppend(const std::string& name, uint32_t rows, uint32_t cols);
+	AppendedVariable* beginAppend(const std::string& name, uint32_t rows, uint32_t cols,
+			uint8_t arrayClass, uint32_t dataType, uint8_t flags, size_t elementSize);
+
+	template <typename Target, typename Derived>
+	bool appendDense(const std::string& name, const Eigen::DenseBase<Derived>& value);
+	template <typename Target, typename Scalar>
+	bool appendScalars(const std::string& name, const Scalar* data, size_t n);
+
+	// writes the buffered slices of a full buffer into the element of the variable
+	bool endAppend(const std::string& name, AppendedVariable& variable);
+
+	// writes the buffered slices into the element, grows it if needed and patches its header
+	bool writeAppended(const std::string& name, AppendedVariable& variable);
+
+	// element tag, flags, dimensions, name and data tag with the current sizes
+	bool writeAppendedHeader(const std::string& name, const AppendedVariable& variable);
+
+	// reserves room for at least dataBytes in the element by moving the elements behind it
+	bool growAppended(AppendedVariable& variable, uint64_t dataBytes);
+
+	// bytes of the element at offset including its tag, 0 if it cannot be read
+	uint64_t elementBytes(uint64_t offset);
+
+	// copies the bytes in [begin, end) to destination, which lies behind end
+	bool moveBytes(uint64_t begin, uint64_t end, uint64_t destination);
+
+	// writes the array tag, flags, dimensions, name and the tag of the real part
+	bool beginArray(const std::string& name, uint8_t arrayClass, uint8_t flags,
+			const std::vector<uint32_t>& dims, uint32_t dataType, uint64_t dataBytes);
+
+	template <typename Target>
+	bool beginArray(const std::string& name, bool globalVariable, const std::vector<uint32_t>& dims, uint64_t dataBytes);
+
+	// writes padding after the real part, ends the compressed element
+	bool endArray(uint64_t dataBytes);
+
+	// ends the compressed element of a failed write, so the following variables are not staged into it, returns false
+	bool abortArray();
+
+	// false if the name was already written
+	bool addName(const std::string& name) { return _names.insert(name).second; }
+
+	// bytes of the miMATRIX element of an array after its tag, 0 if the array cannot be written
+	static uint64_t arrayBytes(const mxArray* array, size_t nameLength);
+
+	// writes the miMATRIX element of an array, fields and cells recursively with empty names
+	bool writeArray(const std::string& name, const mxArray* array, uint8_t flags);
+
+	// writes the real or imaginary parts of a complex array, without tag and padding
+	bool writeComplexPart(const mxArray* array, bool imaginary);
+
+	template <typename Target, typename Derived>
+	bool writeDense(const std::string& name, const Eigen::DenseBase<Derived>& value, bool globalVariable);
+	template <typename Target, typename Scalar>
+	bool writeScalars(const std::string& name, const Scalar* data, const std::vector<uint32_t>& dims, bool globalVariable);
+	template <typename Target, typename ValueType, typename AllocatorType>
+	bool writeSlices(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable);
+
+	bool writeTag(uint32_t dataType, uint32_t nBytes);
+	bool writeBytes(const void* data, size_t nBytes);
+	bool writeBytes(FILE* file, const void* data, size_t nBytes);
+	// collects the bytes of appended slices
+	bool writeBytes(std::vector<char>* buffer, const void* data, size_t nBytes);
+	bool writePadding(uint64_t nBytes);
+
+	// streams a sequence of scalars converted to the target type into the file or a buffer
+	template <typename Target, typename Output, typename Scalar>
+	bool writeAs(Output output, const Scalar* data, size_t n);
+	template <typename Target, typename Output, typename Scalar>
+	bool writeAs(Output output, const Scalar* data, size_t n, std::true_type sameType);
+	template <typename Target, typename Output, typename Scalar>
+	bool writeAs(Output output, const Scalar* data, size_t n, std::false_type sameType);
+
+	// streams an Eigen object in column major order converted to the target type
+	template <typename Target, typename Output, typename Derived>
+	bool writeColumnMajor(Output output, const Eigen::DenseBase<Derived>& value);
+	template <typename Target, typename Output, typename Derived>
+	bool writeColumnMajor(Output output, const Eigen::DenseBase<Derived>& value, std::true_type directAccess);
+	template <typename Target, typename Output, typename Derived>
+	bool writeColumnMajor(Output output, const Eigen::DenseBase<Derived>& value, std::false_type directAccess);
+
+	template <typename ValueType, typename AllocatorType>
+	bool writeVector(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable, std::true_type isArithmetic);
+	template <typename ValueType, typename AllocatorType>
+	bool writeVector(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable, std::false_type isArithmetic);
+
+	MatV5Writer(const MatV5Writer&);
+	MatV5Writer& operator=(const MatV5Writer&);
+
+	FILE* _file;
+	std::vector<char> _fileBuffer;
+	std::map<std::string, AppendedVariable> _appended;
+	std::set<std::string> _names;
+	NUMERIC_STORAGE _numericStorage;
+	MatV5Compressor _compressor;
+	uint64_t _bytesWritten;
+};
+
+
+template <typename Derived>
+bool MatV5Writer::write(const std::string& name, const Eigen::DenseBase<Derived>& value, bool globalVariable)
+{
+	if (_numericStorage == STORE_NATIVE) { return writeDense<typename Derived::Scalar>(name, value, globalVariable); }
+	return writeDense<double>(name, value, globalVariable);
+}
+
+template <typename Scalar>
+typename std::enable_if<std::is_arithmetic<Scalar>::value, bool>::type
+MatV5Writer::write(const std::string& name, const Scalar& value, bool globalVariable)
+{
+	std::vector<uint32_t> dims(2, 1);
+
+	if (_numericStorage == STORE_NATIVE) { return writeScalars<Scalar>(name, &value, dims, globalVariable); }
+	return writeScalars<double>(name, &value, dims, globalVariable);
+}
+
+template <typename ValueType, typename AllocatorType>
+bool MatV5Writer::write(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable)
+{
+	return writeVector(name, value, globalVariable, typename std::is_arithmetic<ValueType>::type());
+}
+
+template <typename Scalar>
+bool MatV5Writer::write(const std::string& name, const MatrixSlices<Scalar>& value, bool globalVariable)
+{
+	std::vector<uint32_t> dims(value.dims().begin(), value.dims().end());
+	if (_numericStorage == STORE_NATIVE) { return writeScalars<Scalar>(name, value.data(), dims, globalVariable); }
+	return writeScalars<double>(name, value.data(), dims, globalVariable);
+}
+
+template <typename ValueType, typename AllocatorType>
+bool MatV5Writer::writeVector(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable, std::true_type isArithmetic)
+{
+	// same layout as MxArrayNDimWrapper, i.e. a row vector
+	std::vector<uint32_t> dims(2);
+	dims[0] = 1;
+	dims[1] = static_cast<uint32_t>(value.size());
+
+	if (_numericStorage == STORE_NATIVE) { return writeScalars<ValueType>(name, value.data(), dims, globalVariable); }
+	return writeScalars<double>(name, value.data(), dims, globalVariable);
+}
+
+template <typename ValueType, typename AllocatorType>
+bool MatV5Writer::writeVector(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable, std::false_type isArithmetic)
+{
+	if (_numericStorage == STORE_NATIVE) { return writeSlices<typename ValueType::Scalar>(name, value, globalVariable); }
+	return writeSlices<double>(name, value, globalVariable);
+}
+
+template <typename Target, typename Derived>
+bool MatV5Writer::writeDense(const std::string& name, const Eigen::DenseBase<Derived>& value, bool globalVariable)
+{
+	std::vector<uint32_t> dims(2);
+	dims[0] = static_cast<uint32_t>(value.rows());
+	dims[1] = static_cast<uint32_t>(value.cols());
+
+	uint64_t dataBytes = value.size()*sizeof(Target);
+	if (!beginArray<Target>(name, globalVariable, dims, dataBytes)) { return false; }
+	if (!writeColumnMajor<Target>(_file, value)) { return abortArray(); }
+	return endArray(dataBytes);
+}
+
+template <typename Target, typename Scalar>
+bool MatV5Writer::writeScalars(const std::string& name, const Scalar* data, const std::vector<uint32_t>& dims, bool globalVariable)
+{
+	uint64_t n = 1;
+	for (size_t i=0; i<dims.size(); i++) { n *= dims[i]; }
+	uint64_t dataBytes = n*sizeof(Target);
+	if (!beginArray<Target>(name, globalVariable, dims, dataBytes)) { return false; }
+	if (!writeAs<Target>(_file, data, n)) { return abortArray(); }
+	return endArray(dataBytes);
+}
+
+template <typename Target, typename ValueType, typename AllocatorType>
+bool MatV5Writer::writeSlices(const std::string& name, const std::vector<ValueType, AllocatorType>& value, bool globalVariable)
+{
+	// same layout as MxArrayNDimWrapper, i.e. matrices are stacked along the third dimension
+	if (value.size() == 0) { return false; }
+
+	std::vector<uint32_t> dims(3);
+	dims[0] = static_cast<uint32_t>(value[0].rows());
+	dims[1] = static_cast<uint32_t>(value[0].cols());
+	dims[2] = static_cast<uint32_t>(value.size());
+
+	for (size_t i=0; i<value.size(); i++)
+	{
+		if (value[i].rows() != value[0].rows() || value[i].cols() != value[0].cols()) { return false; }
+	}
+
+	uint64_t dataBytes = uint64_t(dims[0])*dims[1]*dims[2]*sizeof(Target);
+	if (!beginArray<Target>(name, globalVariable, dims, dataBytes)) { return false; }
+	for (size_t i=0; i<value.size(); i++)
+	{
+		if (!writeColumnMajor<Target>(_file, value[i])) { return abortArray(); }
+	}
+	return endArray(dataBytes);
+}
+
+template <typename Target>
+bool MatV5Writer::beginArray(const std::string& name, bool globalVariable, const std::vector<uint32_t>& dims, uint64_t dataBytes)
+{
+	typedef matv5::Traits<Target> Traits;
+	uint8_t flags = Traits::flags | (globalVariable ? matv5::FLAG_GLOBAL : 0);
+	return beginArray(name, Traits::arrayClass, flags, dims, Traits::dataType, dataBytes);
+}
+
+template <typename Derived>
+bool MatV5Writer::append(const std::string& name, const Eigen::DenseBase<Derived>& value)
+{
+	if (_numericStorage == STORE_NATIVE) { return appendDense<typename Derived::Scalar>(name, value); }
+	return appendDense<double>(name, value);
+}
+
+template <typename Scalar>
+typename std::enable_if<std::is_arithmetic<Scalar>::value, bool>::type
+MatV5Writer::append(const std::string& name, const Scalar& value)
+{
+	if (_numericStorage == STORE_NATIVE) { return appendScalars<Scalar>(name, &value, 1); }
+	return appendScalars<double>(name, &value, 1);
+}
+
+template <typename Scalar, typename AllocatorType>
+bool MatV5Writer::append(const std::string& name, const std::vector<Scalar, AllocatorType>& value)
+{
+	if (_numericStorage == STORE_NATIVE) { return appendScalars<Scalar>(name, value.data(), value.size()); }
+	return appendScalars<double>(name, value.data(), value.size());
+}
+
+template <typename Target, typename Derived>
+bool MatV5Writer::appendDense(const std::string& name, const Eigen::DenseBase<Derived>& value)
+{
+	// vectors are always stored as columns
+	bool isVector = (value.rows() == 1 || value.cols() == 1);
+	uint32_t rows = static_cast<uint32_t>(isVector ? value.size() : value.rows());
+	uint32_t cols = static_cast<uint32_t>(isVector ? 1 : value.cols());
+
+	AppendedVariable* variable = beginAppend<Target>(name, rows, cols);
+	return variable && writeColumnMajor<Target>(&variable->buffer, value) && endAppend(name, *variable);
+}
+
+template <typename Target, typename Scalar>
+bool MatV5Writer::appendScalars(const std::string& name, const Scalar* data, size_t n)
+{
+	AppendedVariable* variable = beginAppend<Target>(name, static_cast<uint32_t>(n), 1);
+	return variable && writeAs<Target>(&variable->buffer, data, n) && endAppend(name, *variable);
+}
+
+template <typename Target>
+MatV5Writer::AppendedVariable* MatV5Writer::beginAppend(const std::string& name, uint32_t rows, uint32_t cols)
+{
+	typedef matv5::Traits<Target> Traits;
+	return beginAppend(name, rows, cols, Traits::arrayClass, Traits::dataType, Traits::flags, sizeof(Target));
+}
+
+template <typename Target, typename Output, typename Scalar>
+bool MatV5Writer::writeAs(Output output, const Scalar* data, size_t n)
+{
+	return writeAs<Target>(output, data, n, typename std::is_same<Target, Scalar>::type());
+}
+
+template <typename Target, typename Output, typename Scalar>
+bool MatV5Writer::writeAs(Output output, const Scalar* data, size_t n, std::true_type sameType)
+{
+	return writeBytes(output, data, n*sizeof(Target));
+}
+
+template <typename Target, typename Output, typename Scalar>
+bool MatV5Writer::writeAs(Output output, const Scalar* data, size_t n, std::false_type sameType)
+{
+	Target buffer[CONVERSION_CHUNK_SIZE];
+	for (size_t i=0; i<n; i+=CONVERSION_CHUNK_SIZE)
+	{
+		size_t chunk = std::min<size_t>(CONVERSION_CHUNK_SIZE, n-i);
+		for (size_t j=0; j<chunk; j++)
+		{
+			buffer[j] = static_cast<Target>(data[i+j]);
+		}
+		if (!writeBytes(output, buffer, chunk*sizeof(Target))) { return false; }
+	}
+	return true;
+}
+
+template <typename Target, typename Output, typename Derived>
+bool MatV5Writer::writeColumnMajor(Output output, const Eigen::DenseBase<Derived>& value)
+{
+	typedef std::integral_constant<bool, (Derived::Flags & Eigen::DirectAccessBit) != 0> DirectAccess;
+	return writeColumnMajor<Target>(output, value, DirectAccess());
+}
+
+template <typename Target, typename Output, typename Derived>
+bool MatV5Writer::writeColumnMajor(Output output, const Eigen::DenseBase<Derived>& value, std::true_type directAccess)
+{
+	// contiguous column major storage can be streamed (and converted) in one go
+	bool isColumnMajor = !(Derived::Flags & Eigen::RowMajorBit);
+	if (isColumnMajor && value.innerStride() == 1 && (value.outerStride() == value.rows() || value.cols() == 1))
+	{
+		return writeAs<Target>(output, value.derived().data(), value.size());
+	}
+	return writeColumnMajor<Target>(output, value, std::false_type());
+}
+
+template <typename Target, typename Output, typename Derived>
+bool MatV5Writer::writeColumnMajor(Output output, const Eigen::DenseBase<Derived>& value, std::false_type directAccess)
+{
+	// evaluates expressions (e.g. products) once, cheap expressions are only referenced
+	typename Eigen::internal::nested_eval<Derived, 1>::type evaluated(value.derived());
+
+	Target buffer[CONVERSION_CHUNK_SIZE];
+	size_t n = 0;
+	for (Eigen::Index col=0; col<evaluated.cols(); col++)
+	{
+		for (Eigen::Index row=0; row<evaluated.rows(); row++)
+		{
+			buffer[n++] = static_cast<Target>(evaluated.coeff(row, col));
+			if (n == CONVERSION_CHUNK_SIZE)
+			{
+				if (!writeBytes(output, buffer, n*sizeof(Target))) { return false; }
+				n = 0;
+			}
+		}
+	}
+	return writeBytes(output, buffer, n*sizeof(Target));
+}
+
+} // namespace matlab
+
+#endif /* MATV5WRITER_HPP_ */
@@ -10,6 +10,12 @@
 
 #include <Eigen/Core>
 #include <vector>
+#include <stdexcept>
+
+#include <matlabCppInterface/MxArrayPool.hpp>
+#include <matlabCppInterface/internal/helpers.hpp>
+#include <matlabCppInterface/internal/MxClassTraits.hpp>
+#include <matlabCppInterface/internal/ConversionKind.hpp>
 
 #include "matrix.h"
 
@@ -20,15 +26,45 @@ class MxArrayNDimWrapper
 {
 public:
 	MxArrayNDimWrapper() :
-		_mxArray(NULL)
+		_mxArray(NULL),
+		_numericStorage(STORE_AS_DOUBLE),
+		_pool(NULL)
 	{}
 
-	MxArrayNDimWrapper(const std::vector<ContentType, AllocatorType>& value) :
-		_mxArray(NULL)
+	// dense arrays are drawn from and returned to the pool if there is one
+	MxArrayNDimWrapper(const std::vector<ContentType, AllocatorType>& value, NUMERIC_STORAGE numericStorage = STORE_AS_DOUBLE, MxArrayPool* pool = NULL) :
+		_mxArray(NULL),
+		_numericStorage(numericStorage),
+		_pool(pool)
 	{
 		set(value);
 	}
 
+	// move only, the wrapper owns the mxArray
+	MxArrayNDimWrapper(MxArrayNDimWrapper&& other) :
+		_mxArray(other._mxArray),
+		_numericStorage(other._numericStorage),
+		_pool(other._pool)
+	{
+		other._mxArray = NULL;
+	}
+
+	MxArrayNDimWrapper& operator=(MxArrayNDimWrapper&& other)
+	{
+		if (this != &other)
+		{
+			erase();
+			_mxArray = other._mxArray;
+			_numericStorage = other._numericStorage;
+			_pool = other._pool;
+			other._mxArray = NULL;
+		}
+		return *this;
+	}
+
+	MxArrayNDimWrapper(const MxArrayNDimWrapper&) = delete;
+	MxArrayNDimWrapper& operator=(const MxArrayNDimWrapper&) = delete;
+
 	~MxArrayNDimWrapper()
 	{
 		erase();
@@ -36,11 +72,8 @@ public:
 
 	void erase()
 	{
-		if (_mxArray != NULL)
-		{
-			mxDestroyArray(_mxArray);
-			_mxArray = NULL;
-		}
+		destroyArray(_pool, _mxArray);
+		_mxArray = NULL;
 	}
 
 
@@ -51,27 +84,123 @@ public:
 	}
 
 
-	void get(std::vector<ContentType, AllocatorType>& value)
+	// false if a dense array does not fit the slices, the other conversions throw
+	bool get(std::vector<ContentType, AllocatorType>& value)
 	{
 		assert(_mxArray != NULL);
-		convertTo(value);
+		return convertTo(value);
 	}
 
 	mxArray* &mxArrayPtr() { return _mxArray; }
 
+	// hands the mxArray over to the caller, the wrapper does not destroy it anymore
+	mxArray* release()
+	{
+		mxArray* array = _mxArray;
+		_mxArray = NULL;
+		return array;
+	}
+
 
 private:
 	void convertFrom(const std::vector<ContentType, AllocatorType>& content);
+	void convertFrom(const std::vector<ContentType, AllocatorType>& content, StructConversion kind);
+	void convertFrom(const std::vector<ContentType, AllocatorType>& content, DenseConversion kind);
+	void convertFrom(const std::vector<ContentType, AllocatorType>& content, ComplexConversion kind);
+	void convertFrom(const std::vector<ContentType, AllocatorType>& content, StringConversion kind);
 
-	void convertTo(std::vector<ContentType, AllocatorType>& content);
+	bool convertTo(std::vector<ContentType, AllocatorType>& content);
+	bool convertTo(std::vector<ContentType, AllocatorType>& content, StructConversion kind);
+	bool convertTo(std::vector<ContentType, AllocatorType>& content, DenseConversion kind);
+	bool convertTo(std::vector<ContentType, AllocatorType>& content, ComplexConversion kind);
+	bool convertTo(std::vector<ContentType, AllocatorType>& content, StringConversion kind);
 
 	mxArray* _mxArray;
 
+	// class numeric data is stored in on put
+	NUMERIC_STORAGE _numericStorage;
 
+	// recycles the arrays of repeated puts, not owned
+	MxArrayPool* _pool;
 };
 
+// number of matrix elements a thread should at least convert
+const size_t MIN_ELEMENTS_PER_THREAD = 1 << 18;
+
+// casts each slice straight into the mxArray data, fixed size slices keep their compile time size
+template <typename Target, class ContentType, class AllocatorType>
+void castSlicesInto(Target* data, const std::vector<ContentType, AllocatorType>& content)
+{
+	typedef Eigen::Matrix<Target, ContentType::RowsAtCompileTime, ContentType::ColsAtCompileTime> Slice;
+	const Eigen::Index rows = content[0].rows();
+	const Eigen::Index cols = content[0].cols();
+	const size_t sliceSize = rows*cols;
+
+	helpers::parallelFor(content.size(), MIN_ELEMENTS_PER_THREAD / std::max<size_t>(sliceSize, 1), [&](size_t begin, size_t end)
+	{
+		for (size_t i=begin; i<end; i++)
+		{
+			Eigen::Map<Slice>(&data[i*sliceSize], rows, cols) = content[i].template cast<Target>();
+		}
+	});
+}
+
+// casts the slices of a 3-D array of any numeric class into the vector, see visitNumericData
+template <class ContentType, class AllocatorType>
+struct SliceCaster
+{
+	SliceCaster(std::vector<ContentType, AllocatorType>& content, Eigen::Index rows, Eigen::Index cols) :
+		content(content), rows(rows), cols(cols)
+	{}
+
+	template <typename Source>
+	void operator()(const Source* data)
+	{
+		typedef Eigen::Matrix<Source, ContentType::RowsAtCompileTime, ContentType::ColsAtCompileTime> Slice;
+		const size_t sliceSize = rows*cols;
+
+		helpers::parallelFor(content.size(), MIN_ELEMENTS_PER_THREAD / std::max<size_t>(sliceSize, 1), [&](size_t begin, size_t end)
+		{
+			for (size_t i=begin; i<end; i++)
+			{
+				content[i] = Eigen::Map<const Slice>(&data[i*sliceSize], rows, cols).template cast<typename ContentType::Scalar>();
+			}
+		});
+	}
+
+	std::vector<ContentType, AllocatorType>& content;
+	Eigen::Index rows;
+	Eigen::Index cols;
+};
+
+// vectors of reflected structs are struct arrays (see StructTraits), vectors of complex scalars or matrices complex arrays,
+// vectors of strings cell arrays
 template <class ContentType, class AllocatorType>
 void MxArrayNDimWrapper<ContentType, AllocatorType>::convertFrom(const std::vector<ContentType, AllocatorType>& content)
+{
+	convertFrom(content, typename ConversionKind<ContentType>::type());
+}
+
+template <class ContentType, class AllocatorType>
+void MxArrayNDimWrapper<ContentType, AllocatorType>::convertFrom(const std::vector<ContentType, AllocatorType>& content, ComplexConversion kind)
+{
+	_mxArray = convertFromComplexVector(content, _numericStorage, _pool);
+}
+
+template <class ContentType, class AllocatorType>
+void MxArrayNDimWrapper<ContentType, AllocatorType>::convertFrom(const std::vector<ContentType, AllocatorType>& content, StringConversion kind)
+{
+	_mxArray = convertFromStrings(content);
+}
+
+template <class ContentType, class AllocatorType>
+void MxArrayNDimWrapper<ContentType, AllocatorType>::convertFrom(const std::vector<ContentType, AllocatorType>& content, StructConversion kind)
+{
+	_mxArray = convertFromStructs(content.data(), content.size(), _numericStorage);
+}
+
+template <class ContentType, class AllocatorType>
+void MxArrayNDimWrapper<ContentType, AllocatorType>::convertFrom(const std::vector<ContentType, AllocatorType>& content, DenseConversion kind)
 {
 	if (content.size() == 0)
 	{
@@ -84,64 +213,115 @@ void MxArrayNDimWrapper<ContentType, AllocatorType>::convertFrom(const std::vect
 	dims[0] = content[0].rows();
 	dims[1] = content[0].cols();
 
-	_mxArray = mxCreateNumericArray(nDims, dims, mxDOUBLE_CLASS, mxREAL);
-
 	for (size_t i=0; i<content.size(); i++)
 	{
-		if (content[i].rows() != dims[0] || content[i].cols() != dims[1])
+		if (static_cast<size_t>(content[i].rows()) != dims[0] || static_cast<size_t>(content[i].cols()) != dims[1])
 		{
 			throw "Not all matrices in vector are of equal size.";
 		}
+	}
 
-		Eigen::MatrixXd matrix = content[i].template cast<double>();
+	// every element is overwritten below
+	typedef typename ContentType::Scalar Scalar;
+	_mxArray = createUninitArray(_pool, nDims, dims, storageClass<Scalar>(_numericStorage), mxREAL);
 
-		double* mxArrayData = mxGetPr(_mxArray);
-		memcpy(&mxArrayData[i*matrix.size()], matrix.data(), matrix.size()*sizeof(double));
+	if (_numericStorage == STORE_NATIVE)
+	{
+		castSlicesInto(static_cast<Scalar*>(mxGetData(_mxArray)), content);
+	} else
+	{
+		castSlicesInto(mxGetPr(_mxArray), content);
 	}
 }
 
 template <class ContentType, class AllocatorType>
-void MxArrayNDimWrapper<ContentType, AllocatorType>::convertTo(std::vector<ContentType, AllocatorType>& content)
+bool MxArrayNDimWrapper<ContentType, AllocatorType>::convertTo(std::vector<ContentType, AllocatorType>& content)
 {
-	const size_t nDims = 3;
+	return convertTo(content, typename ConversionKind<ContentType>::type());
+}
 
-	assert(mxIsNumeric(_mxArray) && "Variable is not numeric");
-	assert(!mxIsEmpty(_mxArray) && "Variable is empty!");
-	assert(mxGetNumberOfDimensions(_mxArray) == nDims && "Variable is not 3-dimensional");
-	assert(sizeof(double) == mxGetElementSize(_mxArray) && "Currently only matlab double arrays are supported");
+template <class ContentType, class AllocatorType>
+bool MxArrayNDimWrapper<ContentType, AllocatorType>::convertTo(std::vector<ContentType, AllocatorType>& content, ComplexConversion kind)
+{
+	convertToComplexVector(_mxArray, content);
+	return true;
+}
 
-	const size_t* dims = mxGetDimensions(_mxArray);
+template <class ContentType, class AllocatorType>
+bool MxArrayNDimWrapper<ContentType, AllocatorType>::convertTo(std::vector<ContentType, AllocatorType>& content, StringConversion kind)
+{
+	convertToStrings(_mxArray, content);
+	return true;
+}
 
-	content.resize(dims[2]);
-	Eigen::MatrixXd matrix(dims[0], dims[1]);
+template <class ContentType, class AllocatorType>
+bool MxArrayNDimWrapper<ContentType, AllocatorType>::convertTo(std::vector<ContentType, AllocatorType>& content, StructConversion kind)
+{
+	convertToStructs(_mxArray, content);
+	return true;
+}
 
-	for (size_t i=0; i<content.size(); i++)
+template <class ContentType, class AllocatorType>
+bool MxArrayNDimWrapper<ContentType, AllocatorType>::convertTo(std::vector<ContentType, AllocatorType>& content, DenseConversion kind)
+{
+	// checked in release builds as well, the variables come from files and other processes
+	if (!mxIsNumeric(_mxArray) || mxIsEmpty(_mxArray)) { return false; }
+
+	// Matlab drops the trailing singleton dimension of a single slice
+	const size_t nDims = mxGetNumberOfDimensions(_mxArray);
+	if (nDims != 3 && nDims != 2) { return false; }
+
+	const size_t* dims = mxGetDimensions(_mxArray);
+	const size_t nSlices = (nDims == 3) ? dims[2] : 1;
+
+	if ((ContentType::RowsAtCompileTime != Eigen::Dynamic && ContentType::RowsAtCompileTime != static_cast<Eigen::Index>(dims[0])) ||
+		(ContentType::ColsAtCompileTime != Eigen::Dynamic && ContentType::ColsAtCompileTime != static_cast<Eigen::Index>(dims[1])))
 	{
-		double* mxArrayData = mxGetPr(_mxArray);
-		memcpy(matrix.data(), &mxArrayData[i*matrix.size()], matrix.size()*sizeof(double));
-		content[i] = matrix.cast<typename ContentType::Scalar>();
+		return false;
 	}
+
+	content.resize(nSlices);
+
+	// reads singles, integers, ... without going through double
+	SliceCaster<ContentType, AllocatorType> caster(content, dims[0], dims[1]);
+	visitNumericData(_mxArray, caster);
+	return true;
 }
 
-// helper to cast any scalar vector to a double vector
-template <typename ScalarType>
-std::vector<double> castToDoubleVector(const std::vector<ScalarType>& vector)
+// helper for all scalar types, stores the vector as row vector
+template <typename Scalar>
+void convertFromScalarVector(const std::vector<Scalar, std::allocator<Scalar> >& content, NUMERIC_STORAGE numericStorage, mxArray* &mxArray, MxArrayPool* pool)
 {
-	return std::vector<double>(vector.begin(), vector.end());
+	if (content.size() == 0)
+	{
+		throw "Vector is empty.";
+	}
+
+	size_t dims[2] = { 1, content.size() };
+	mxArray = createUninitArray(pool, 2, dims, storageClass<Scalar>(numericStorage), mxREAL);
+
+	if (numericStorage == STORE_NATIVE)
+	{
+		memcpy(mxGetData(mxArray), content.data(), content.size()*sizeof(Scalar));
+	} else
+	{
+		std::copy(content.begin(), content.end(), mxGetPr(mxArray));
+	}
 }
 
-// helper to cast any scalar vector from a double vector
-template <typename ScalarType>
-std::vector<ScalarType> castFromDoubleVector(const std::vector<double>& doubleVector)
+// helper for all scalar types, reads any numeric class without going through double
+template <typename Scalar>
+void convertToScalarVector(std::vector<Scalar, std::allocator<Scalar> >& content, const mxArray* mxArray)
 {
-	return std::vector<ScalarType>(doubleVector.begin(), doubleVector.end());
-}
+	const size_t nDims = 2;
 
-// helper for doubles, will be used by all scalar types
-void convertToDoubleVector(std::vector<double, std::allocator<double> >& content, mxArray* &mxArray);
+	if(!mxIsNumeric(mxArray)) throw std::runtime_error("Variable is not numeric");
+	if(mxIsEmpty(mxArray)) throw std::runtime_error("Variable is empty!");
+	if(mxGetNumberOfDimensions(mxArray) != nDims) throw std::runtime_error("Variable is not 2-dimensional");
 
-// helper for doubles, will be used by all scalar types
-void convertFromDoubleVector(const std::vector<double, std::allocator<double> >& content, mxArray* &mxArray);
+	content.resize(mxGetNumberOfElements(mxArray));
+	copyFromMxArray(mxArray, 0, content.size(), content.data());
+}
 
 // explicit template deduction
 template<> void MxArrayNDimWrapper<double, std::allocator<double> >::convertFrom(const std::vector<double, std::allocator<double> >& content);
@@ -149,10 +329,10 @@ template<> void MxArrayNDimWrapper<float, std::allocator<float> >::convertFrom(c
 template<> void MxArrayNDimWrapper<int, std::allocator<int> >::convertFrom(const std::vector<int, std::allocator<int> >& content);
 template<> void MxArrayNDimWrapper<size_t, std::allocator<size_t> >::convertFrom(const std::vector<size_t, std::allocator<size_t> >& content);
 
-template<> void MxArrayNDimWrapper<double, std::allocator<double> >::convertTo(std::vector<double, std::allocator<double> >& content);
-template<> void MxArrayNDimWrapper<float, std::allocator<float> >::convertTo(std::vector<float, std::allocator<float> >& content);
-template<> void MxArrayNDimWrapper<int, std::allocator<int> >::convertTo(std::vector<int, std::allocator<int> >& content);
-template<> void MxArrayNDimWrapper<size_t, std::allocator<size_t> >::convertTo(std::vector<size_t, std::allocator<size_t> >& content);
+template<> bool MxArrayNDimWrapper<double, std::allocator<double> >::convertTo(std::vector<double, std::allocator<double> >& content);
+template<> bool MxArrayNDimWrapper<float, std::allocator<float> >::convertTo(std::vector<float, std::allocator<float> >& content);
+template<> bool MxArrayNDimWrapper<int, std::allocator<int> >::convertTo(std::vector<int, std::allocator<int> >& content);
+template<> bool MxArrayNDimWrapper<size_t, std::allocator<size_t> >::convertTo(std::vector<size_t, std::allocator<size_t> >& content);
 
 
 } // matlab
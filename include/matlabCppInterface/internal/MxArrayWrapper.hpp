@@ -13,6 +13,10 @@
 #include <Eigen/Core>
 #include <vector>
 
+#include <matlabCppInterface/MxArrayPool.hpp>
+#include <matlabCppInterface/internal/MxClassTraits.hpp>
+#include <matlabCppInterface/internal/ConversionKind.hpp>
+
 // Matlab's mxArray stuff
 #include "matrix.h"
 
@@ -23,15 +27,45 @@ class MxArrayWrapper
 {
 public:
 	MxArrayWrapper() :
-		_mxArray(NULL)
+		_mxArray(NULL),
+		_numericStorage(STORE_AS_DOUBLE),
+		_pool(NULL)
 	{}
 
-	MxArrayWrapper(const ContentType& value) :
-		_mxArray(NULL)
+	// dense arrays are drawn from and returned to the pool if there is one
+	MxArrayWrapper(const ContentType& value, NUMERIC_STORAGE numericStorage = STORE_AS_DOUBLE, MxArrayPool* pool = NULL) :
+		_mxArray(NULL),
+		_numericStorage(numericStorage),
+		_pool(pool)
 	{
 		set(value);
 	}
 
+	// move only, the wrapper owns the mxArray
+	MxArrayWrapper(MxArrayWrapper&& other) :
+		_mxArray(other._mxArray),
+		_numericStorage(other._numericStorage),
+		_pool(other._pool)
+	{
+		other._mxArray = NULL;
+	}
+
+	MxArrayWrapper& operator=(MxArrayWrapper&& other)
+	{
+		if (this != &other)
+		{
+			erase();
+			_mxArray = other._mxArray;
+			_numericStorage = other._numericStorage;
+			_pool = other._pool;
+			other._mxArray = NULL;
+		}
+		return *this;
+	}
+
+	MxArrayWrapper(const MxArrayWrapper&) = delete;
+	MxArrayWrapper& operator=(const MxArrayWrapper&) = delete;
+
 	~MxArrayWrapper()
 	{
 		erase();
@@ -39,11 +73,8 @@ public:
 
 	void erase()
 	{
-		if (_mxArray != NULL)
-		{
-			mxDestroyArray(_mxArray);
-			_mxArray = NULL;
-		}
+		destroyArray(_pool, _mxArray);
+		_mxArray = NULL;
 	}
 
 	void set(const ContentType& value)
@@ -61,32 +92,122 @@ public:
 
 	mxArray* &mxArrayPtr() { return _mxArray; }
 
+	// hands the mxArray over to the caller, the wrapper does not destroy it anymore
+	mxArray* release()
+	{
+		mxArray* array = _mxArray;
+		_mxArray = NULL;
+		return array;
+	}
+
 
 private:
 	void convertFrom(const ContentType& content);
+	void convertFrom(const ContentType& content, DenseConversion kind);
+	void convertFrom(const ContentType& content, StructConversion kind);
+	void convertFrom(const ContentType& content, SparseConversion kind);
+	void convertFrom(const ContentType& content, ComplexConversion kind);
+	void convertFrom(const ContentType& content, SlicesConversion kind);
 
 	void convertTo(ContentType& content);
+	void convertTo(ContentType& content, DenseConversion kind);
+	void convertTo(ContentType& content, StructConversion kind);
+	void convertTo(ContentType& content, SparseConversion kind);
+	void convertTo(ContentType& content, ComplexConversion kind);
+	void convertTo(ContentType& content, SlicesConversion kind);
 
 	mxArray* _mxArray;
 
+	// class numeric data is stored in on put
+	NUMERIC_STORAGE _numericStorage;
 
+	// recycles the arrays of repeated puts, not owned
+	MxArrayPool* _pool;
 };
 
-	// by default we assume an eigen matrix unless specified below
+	// evaluates any dense Eigen expression (blocks, Maps, Refs, row major, products, ...)
+	// in one pass into a column major buffer, without temporaries
+	template <typename Scalar, typename Derived>
+	void evaluateInto(Scalar* data, const Eigen::MatrixBase<Derived>& content)
+	{
+		typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+		Eigen::Map<Matrix>(data, content.rows(), content.cols()).noalias() = content.template cast<Scalar>();
+	}
+
+	template <typename Scalar, typename Derived>
+	void evaluateInto(Scalar* data, const Eigen::ArrayBase<Derived>& content)
+	{
+		typedef Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic> Array;
+		Eigen::Map<Array>(data, content.rows(), content.cols()) = content.template cast<Scalar>();
+	}
+
+	// by default we assume an eigen matrix or expression unless specified below, reflected (see StructTraits), sparse, complex or MatrixSlices
 	template <typename ContentType>
 	void MxArrayWrapper<ContentType>::convertFrom(const ContentType& content)
 	{
-		_mxArray = mxCreateDoubleMatrix(content.rows(), content.cols(), mxREAL);
+		convertFrom(content, typename ConversionKind<ContentType>::type());
+	}
 
-		static_assert(std::is_same<typename ContentType::Scalar, double>::value, "YOU ARE TRYING TO PUT A TYPE THAT IS NOT SUPPORTED BY THE INTERFACE. MAYBE YOU ARE TRYING TO PUT AN EIGEN MATRIX/VECTOR WITH A SCALAR TYPE THAT IS NOT DOUBLE.");
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertFrom(const ContentType& content, StructConversion kind)
+	{
+		_mxArray = convertFromStructs(&content, 1, _numericStorage);
+	}
+
+	// Matlab sparse matrices are always double
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertFrom(const ContentType& content, SparseConversion kind)
+	{
+		_mxArray = convertFromSparse(content);
+	}
+
+	// complex matrices, expressions and scalars are stored as double or, natively, as single complex arrays
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertFrom(const ContentType& content, ComplexConversion kind)
+	{
+		_mxArray = convertFromComplex(content, _numericStorage, _pool);
+	}
+
+	// 3-D and N-D blocks keep their dimensions
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertFrom(const ContentType& content, SlicesConversion kind)
+	{
+		_mxArray = convertFromSlices(content, _numericStorage, _pool);
+	}
+
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertFrom(const ContentType& content, DenseConversion kind)
+	{
+		typedef typename ContentType::Scalar Scalar;
+		static_assert(std::is_arithmetic<Scalar>::value, "YOU ARE TRYING TO PUT A TYPE THAT IS NOT SUPPORTED BY THE INTERFACE. MAYBE YOU ARE TRYING TO PUT AN EIGEN MATRIX/VECTOR WITH A SCALAR TYPE THAT IS NOT ARITHMETIC.");
 
-	    // get pointer to _mxArray and copy over data
-		double* _mxArrayData = mxGetPr(_mxArray);
-		memcpy(_mxArrayData, content.data(), content.size()*sizeof(double));
+		// no need to zero the buffer, it is completely overwritten
+		size_t dims[2] = { static_cast<size_t>(content.rows()), static_cast<size_t>(content.cols()) };
+		_mxArray = createUninitArray(_pool, 2, dims, storageClass<Scalar>(_numericStorage), mxREAL);
+
+		if (_numericStorage == STORE_NATIVE)
+		{
+			evaluateInto(static_cast<Scalar*>(mxGetData(_mxArray)), content);
+		} else
+		{
+			evaluateInto(mxGetPr(_mxArray), content);
+		}
 	}
 
 
-	void convertFromScalar(const double& value, mxArray* &mxArray);
+	// General template for scalars
+	template <typename Scalar>
+	void convertFromScalar(const Scalar& value, NUMERIC_STORAGE numericStorage, mxArray* &mxArray)
+	{
+		if (numericStorage == STORE_NATIVE)
+		{
+			mxArray = mxCreateUninitNumericMatrix(1, 1, MxClassTraits<Scalar>::classId, mxREAL);
+			*static_cast<Scalar*>(mxGetData(mxArray)) = value;
+		} else
+		{
+			mxArray = mxCreateDoubleScalar(static_cast<double>(value));
+		}
+	}
 
 	template<> void MxArrayWrapper<double>::convertFrom(const double& content);
 	template<> void MxArrayWrapper<float>::convertFrom(const float& content);
@@ -98,20 +219,121 @@ private:
 	template<> void MxArrayWrapper<std::string>::convertFrom(const std::string& content);
 
 
-	// General template to catch non-supported types
-	class FalseType {};
 	template <typename ContentType>
 	void MxArrayWrapper<ContentType>::convertTo(ContentType& content)
 	{
-		static_assert(std::is_same<ContentType, FalseType>::value, "YOU ARE TRYING TO GET A TYPE THAT IS NOT SUPPORTED BY THE INTERFACE. MAYBE YOU ARE TRYING TO GET AN EIGEN MATRIX/VECTOR WITH FIXED SIZE OR WITH A SCALAR TYPE THAT IS NOT DOUBLE.");
+		convertTo(content, typename ConversionKind<ContentType>::type());
+	}
+
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertTo(ContentType& content, StructConversion kind)
+	{
+		convertToStruct(_mxArray, content);
 	}
 
-	// General template specialization for Eigen
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertTo(ContentType& content, SparseConversion kind)
+	{
+		convertToSparse(_mxArray, content);
+	}
+
+	// real arrays are read with zero imaginary parts
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertTo(ContentType& content, ComplexConversion kind)
+	{
+		convertToComplex(_mxArray, content);
+	}
+
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertTo(ContentType& content, SlicesConversion kind)
+	{
+		convertToSlices(_mxArray, content);
+	}
+
+	// copies the elements one by one into any storage order, see visitNumericData
+	template <typename Derived>
+	struct ElementCopy
+	{
+		explicit ElementCopy(Eigen::PlainObjectBase<Derived>& content) : content(content) {}
+
+		template <typename Source>
+		void operator()(const Source* data)
+		{
+			for (Eigen::Index col=0; col<content.cols(); col++)
+			{
+				for (Eigen::Index row=0; row<content.rows(); row++)
+				{
+					content(row, col) = static_cast<typename Derived::Scalar>(data[row + col*content.rows()]);
+				}
+			}
+		}
+
+		Eigen::PlainObjectBase<Derived>& content;
+	};
+
+	// any dense matrix or array, the dimensions are checked against fixed sizes, which are filled in place without allocating
+	template <typename Derived>
+	void convertToDense(const mxArray* array, Eigen::PlainObjectBase<Derived>& content)
+	{
+		if(!mxIsNumeric(array) && !mxIsLogical(array)) throw std::runtime_error("Variable is not numeric");
+		if(mxIsSparse(array)) throw std::runtime_error("Variable is sparse");
+		if(mxIsEmpty(array)) throw std::runtime_error("Variable is empty!");
+		if(mxGetNumberOfDimensions(array) != 2) throw std::runtime_error("Variable is not 2-dimensional");
+
+		Eigen::Index rows = mxGetM(array);
+		Eigen::Index cols = mxGetN(array);
+		if (Derived::IsVectorAtCompileTime)
+		{
+			// vectors are accepted in both orientations
+			if (rows != 1 && cols != 1) throw std::runtime_error("Variable is not a vector!");
+			const Eigen::Index n = rows*cols;
+			rows = (Derived::RowsAtCompileTime == 1) ? 1 : n;
+			cols = (Derived::RowsAtCompileTime == 1) ? n : 1;
+		}
+		if ((Derived::RowsAtCompileTime != Eigen::Dynamic && Derived::RowsAtCompileTime != rows) ||
+			(Derived::ColsAtCompileTime != Eigen::Dynamic && Derived::ColsAtCompileTime != cols))
+		{
+			throw std::runtime_error("Dimensions of the variable do not match the fixed size type");
+		}
+
+		// a no-op for fixed sizes
+		content.resize(rows, cols);
+
+		if (Derived::IsRowMajor && rows > 1 && cols > 1)
+		{
+			ElementCopy<Derived> copy(content);
+			visitNumericData(array, copy);
+			return;
+		}
+		// converts if the variable is not stored as the scalar type
+		copyFromMxArray(array, 0, content.size(), content.data());
+	}
+
+	template <typename ContentType>
+	void MxArrayWrapper<ContentType>::convertTo(ContentType& content, DenseConversion kind)
+	{
+		static_assert(std::is_base_of<Eigen::PlainObjectBase<ContentType>, ContentType>::value, "YOU ARE TRYING TO GET A TYPE THAT IS NOT SUPPORTED BY THE INTERFACE. MAYBE YOU ARE TRYING TO GET AN EIGEN EXPRESSION OR MAP INSTEAD OF A MATRIX/VECTOR.");
+		convertToDense(_mxArray, content);
+	}
+
+	// specialization for the most common Eigen types, all other matrices and arrays use convertToDense
 	template<> void MxArrayWrapper<Eigen::MatrixXd>::convertTo(Eigen::MatrixXd& content);
 	template<> void MxArrayWrapper<Eigen::VectorXd>::convertTo(Eigen::VectorXd& content);
 
-	// General template for scalars
-	double convertToScalar(const mxArray* mxArray);
+	// General template for scalars, reads any numeric class without going through double
+	template <typename Scalar>
+	Scalar convertToScalar(const mxArray* mxArray)
+	{
+		// Check type
+		if(!mxIsNumeric(mxArray)) throw std::runtime_error("Variable is not numeric (normally scalars are stored as doubles in Matlab)");
+		if(mxIsEmpty(mxArray)) throw std::runtime_error("Variable is empty!");
+		if(mxGetNumberOfElements(mxArray) != 1) throw std::runtime_error("Variable is not a scalar (has more than 1 element)");
+
+		// read data
+		Scalar value;
+		copyFromMxArray(mxArray, 0, 1, &value);
+		return value;
+	}
 
 	// explicit template deduction
 	template<> void MxArrayWrapper<double>::convertTo(double& content);
@@ -0,0 +1,111 @@
+/*
+ * MxClassTraits.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXCLASSTRAITS_HPP_
+#define MXCLASSTRAITS_HPP_
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <matlabCppInterface/internal/helpers.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+// maps a C++ arithmetic type to its Matlab class
+template <typename Scalar> struct MxClassTraits;
+
+template <> struct MxClassTraits<double> { static const mxClassID classId = mxDOUBLE_CLASS; };
+template <> struct MxClassTraits<float> { static const mxClassID classId = mxSINGLE_CLASS; };
+template <> struct MxClassTraits<int8_t> { static const mxClassID classId = mxINT8_CLASS; };
+template <> struct MxClassTraits<uint8_t> { static const mxClassID classId = mxUINT8_CLASS; };
+template <> struct MxClassTraits<int16_t> { static const mxClassID classId = mxINT16_CLASS; };
+template <> struct MxClassTraits<uint16_t> { static const mxClassID classId = mxUINT16_CLASS; };
+template <> struct MxClassTraits<int32_t> { static const mxClassID classId = mxINT32_CLASS; };
+template <> struct MxClassTraits<uint32_t> { static const mxClassID classId = mxUINT32_CLASS; };
+template <> struct MxClassTraits<int64_t> { static const mxClassID classId = mxINT64_CLASS; };
+template <> struct MxClassTraits<uint64_t> { static const mxClassID classId = mxUINT64_CLASS; };
+template <> struct MxClassTraits<bool> { static const mxClassID classId = mxLOGICAL_CLASS; };
+
+// the class a type is stored in for the given storage mode
+template <typename Scalar>
+mxClassID storageClass(NUMERIC_STORAGE storage)
+{
+	return storage == STORE_NATIVE ? MxClassTraits<Scalar>::classId : mxDOUBLE_CLASS;
+}
+
+// Calls function(const T* data) with the real data of a numeric (or logical) array,
+// T being the C++ type that matches the class of the array.
+template <typename Function>
+void visitNumericData(const mxArray* array, Function& function)
+{
+	const void* data = mxGetData(array);
+	switch (mxGetClassID(array))
+	{
+		case mxDOUBLE_CLASS: { function(static_cast<const double*>(data)); break; }
+		case mxSINGLE_CLASS: { function(static_cast<const float*>(data)); break; }
+		case mxINT8_CLASS: { function(static_cast<const int8_t*>(data)); break; }
+		case mxUINT8_CLASS: { function(static_cast<const uint8_t*>(data)); break; }
+		case mxINT16_CLASS: { function(static_cast<const int16_t*>(data)); break; }
+		case mxUINT16_CLASS: { function(static_cast<const uint16_t*>(data)); break; }
+		case mxINT32_CLASS: { function(static_cast<const int32_t*>(data)); break; }
+		case mxUINT32_CLASS: { function(static_cast<const uint32_t*>(data)); break; }
+		case mxINT64_CLASS: { function(static_cast<const int64_t*>(data)); break; }
+		case mxUINT64_CLASS: { function(static_cast<const uint64_t*>(data)); break; }
+		case mxLOGICAL_CLASS: { function(static_cast<const mxLogical*>(data)); break; }
+		default: throw std::runtime_error("Variable is not numeric");
+	}
+}
+
+// copies n elements starting at element offset, converting from whatever class the array has
+template <typename Destination>
+struct ConvertingCopy
+{
+	ConvertingCopy(size_t offset, size_t n, Destination* destination) :
+		offset(offset), n(n), destination(destination)
+	{}
+
+	template <typename Source>
+	void operator()(const Source* source)
+	{
+		copy(source + offset, typename std::is_same<Source, Destination>::type());
+	}
+
+	template <typename Source>
+	void copy(const Source* source, std::false_type sameType)
+	{
+		for (size_t i=0; i<n; i++)
+		{
+			destination[i] = static_cast<Destination>(source[i]);
+		}
+	}
+
+	void copy(const Destination* source, std::true_type sameType)
+	{
+		memcpy(destination, source, n*sizeof(Destination));
+	}
+
+	size_t offset;
+	size_t n;
+	Destination* destination;
+};
+
+template <typename Destination>
+void copyFromMxArray(const mxArray* array, size_t offset, size_t n, Destination* destination)
+{
+	// sparse arrays only store the non-zeros, get them as Eigen::SparseMatrix
+	if (mxIsSparse(array)) throw std::runtime_error("Variable is sparse");
+	if (offset + n > mxGetNumberOfElements(array)) throw std::runtime_error("Variable has less elements than requested");
+	ConvertingCopy<Destination> copy(offset, n, destination);
+	visitNumericData(array, copy);
+}
+
+} // namespace matlab
+
+#endif /* MXCLASSTRAITS_HPP_ */
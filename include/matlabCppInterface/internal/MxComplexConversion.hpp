@@ -0,0 +1,348 @@
+/*
+ * MxComplexConversion.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXCOMPLEXCONVERSION_HPP_
+#define MXCOMPLEXCONVERSION_HPP_
+
+#include <complex>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <matlabCppInterface/MxArrayPool.hpp>
+#include <matlabCppInterface/internal/MxClassTraits.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+template <typename Type>
+struct IsComplexScalar : std::false_type {};
+
+template <typename Real>
+struct IsComplexScalar<std::complex<Real> > : std::true_type {};
+
+// Eigen matrices, arrays and expressions of complex scalars
+template <typename Type, typename Enable = void>
+struct HasComplexScalar : std::false_type {};
+
+template <typename Type>
+struct HasComplexScalar<Type, typename std::enable_if<IsComplexScalar<typename Type::Scalar>::value>::type> : std::true_type {};
+
+///
+/// The real and imaginary parts of a complex array, element i is at real[i*stride] and imag[i*stride].
+/// With the interleaved complex API (R2018a and later) the parts alternate like in std::complex,
+/// otherwise they are stored in two separate blocks.
+///
+template <typename Real>
+struct ComplexParts
+{
+#if MX_HAS_INTERLEAVED_COMPLEX
+	explicit ComplexParts(mxArray* array) :
+		real(static_cast<Real*>(mxGetData(array))), imag(real + 1), stride(2)
+	{}
+#else
+	explicit ComplexParts(mxArray* array) :
+		real(static_cast<Real*>(mxGetData(array))), imag(static_cast<Real*>(mxGetImagData(array))), stride(1)
+	{}
+#endif
+
+	// evaluates the expression once into the elements starting at offset, in column major order
+	template <typename Derived>
+	void store(size_t offset, const Eigen::DenseBase<Derived>& content)
+	{
+#if MX_HAS_INTERLEAVED_COMPLEX
+		// std::complex has the layout of the interleaved parts
+		typedef Eigen::Matrix<std::complex<Real>, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+		Eigen::Map<Matrix>(reinterpret_cast<std::complex<Real>*>(real) + offset, content.rows(), content.cols()).noalias() =
+				content.derived().matrix().template cast<std::complex<Real> >();
+#else
+		const typename Derived::PlainObject& values = content.eval();
+		size_t k = offset;
+		for (Eigen::Index col=0; col<values.cols(); col++)
+		{
+			for (Eigen::Index row=0; row<values.rows(); row++, k++)
+			{
+				real[k] = static_cast<Real>(values(row, col).real());
+				imag[k] = static_cast<Real>(values(row, col).imag());
+			}
+		}
+#endif
+	}
+
+	template <typename Source>
+	void store(size_t offset, const std::complex<Source>* values, size_t n)
+	{
+		store(offset, values, n, typename std::is_same<Source, Real>::type());
+	}
+
+	// interleaved parts of the same type are copied as they are
+	void store(size_t offset, const std::complex<Real>* values, size_t n, std::true_type sameType)
+	{
+		if (stride != 2)
+		{
+			store(offset, values, n, std::false_type());
+			return;
+		}
+		memcpy(real + 2*offset, static_cast<const void*>(values), n*sizeof(std::complex<Real>));
+	}
+
+	template <typename Source>
+	void store(size_t offset, const std::complex<Source>* values, size_t n, std::false_type sameType)
+	{
+		for (size_t i=0; i<n; i++)
+		{
+			real[(offset + i)*stride] = static_cast<Real>(values[i].real());
+			imag[(offset + i)*stride] = static_cast<Real>(values[i].imag());
+		}
+	}
+
+	Real* real;
+	Real* imag;
+	size_t stride;
+};
+
+// copies complex elements from any numeric class, see visitNumericData. Real arrays have no imaginary parts.
+template <typename Real>
+struct ComplexConvertingCopy
+{
+	ComplexConvertingCopy(const mxArray* array, size_t offset, size_t n, std::complex<Real>* destination) :
+		array(array), offset(offset), n(n), destination(destination)
+	{}
+
+	template <typename Source>
+	void operator()(const Source* real)
+	{
+#if MX_HAS_INTERLEAVED_COMPLEX
+		const Source* imag = mxIsComplex(array) ? real + 1 : NULL;
+		const size_t stride = mxIsComplex(array) ? 2 : 1;
+#else
+		const Source* imag = static_cast<const Source*>(mxGetImagData(array));
+		const size_t stride = 1;
+#endif
+		copy(real, imag, stride, typename std::is_same<Source, Real>::type());
+	}
+
+	// interleaved parts of the same type are copied as they are
+	void copy(const Real* real, const Real* imag, size_t stride, std::true_type sameType)
+	{
+		if (stride != 2)
+		{
+			copy(real, imag, stride, std::false_type());
+			return;
+		}
+		memcpy(static_cast<void*>(destination), real + 2*offset, n*sizeof(std::complex<Real>));
+	}
+
+	template <typename Source>
+	void copy(const Source* real, const Source* imag, size_t stride, std::false_type sameType)
+	{
+		for (size_t i=0; i<n; i++)
+		{
+			size_t k = (offset + i)*stride;
+			destination[i] = std::complex<Real>(static_cast<Real>(real[k]), imag ? static_cast<Real>(imag[k]) : Real(0));
+		}
+	}
+
+	const mxArray* array;
+	size_t offset;
+	size_t n;
+	std::complex<Real>* destination;
+};
+
+template <typename Real>
+void copyComplexFromMxArray(const mxArray* array, size_t offset, size_t n, std::complex<Real>* destination)
+{
+	if (mxIsSparse(array)) throw std::runtime_error("Variable is sparse");
+	if (offset + n > mxGetNumberOfElements(array)) throw std::runtime_error("Variable has less elements than requested");
+	ComplexConvertingCopy<Real> copy(array, offset, n, destination);
+	visitNumericData(array, copy);
+}
+
+// creates a complex array in the class the parts are stored in and fills it with store(parts)
+template <typename Real, typename Store>
+mxArray* createComplexArray(size_t nDims, const size_t* dims, NUMERIC_STORAGE numericStorage, MxArrayPool* pool, Store store)
+{
+	// every element is overwritten by store
+	mxArray* array = createUninitArray(pool, nDims, dims, storageClass<Real>(numericStorage), mxCOMPLEX);
+	if (numericStorage == STORE_NATIVE)
+	{
+		ComplexParts<Real> parts(array);
+		store(parts);
+	} else
+	{
+		ComplexParts<double> parts(array);
+		store(parts);
+	}
+	return array;
+}
+
+// stores a complex matrix or expression, one element pass per part layout
+template <typename Derived>
+struct ComplexMatrixStore
+{
+	explicit ComplexMatrixStore(const Eigen::DenseBase<Derived>& content) : content(content) {}
+
+	template <typename Parts>
+	void operator()(Parts& parts) const { parts.store(0, content); }
+
+	const Eigen::DenseBase<Derived>& content;
+};
+
+template <typename Derived>
+mxArray* convertFromComplex(const Eigen::DenseBase<Derived>& content, NUMERIC_STORAGE numericStorage, MxArrayPool* pool)
+{
+	typedef typename Derived::Scalar::value_type Real;
+	size_t dims[2] = { static_cast<size_t>(content.rows()), static_cast<size_t>(content.cols()) };
+	return createComplexArray<Real>(2, dims, numericStorage, pool, ComplexMatrixStore<Derived>(content));
+}
+
+// complex scalars are 1x1 arrays
+template <typename Real>
+mxArray* convertFromComplex(const std::complex<Real>& content, NUMERIC_STORAGE numericStorage, MxArrayPool* pool)
+{
+	return convertFromComplex(Eigen::Matrix<std::complex<Real>, 1, 1>::Constant(content), numericStorage, pool);
+}
+
+// fills a sized matrix from the elements starting at offset, row major matrices are filled through a copy
+template <typename Derived>
+void loadComplex(const mxArray* array, size_t offset, Eigen::PlainObjectBase<Derived>& content)
+{
+	typedef typename Derived::Scalar Scalar;
+	if (Derived::IsRowMajor && !Derived::IsVectorAtCompileTime)
+	{
+		Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> columns(content.rows(), content.cols());
+		copyComplexFromMxArray(array, offset, columns.size(), columns.data());
+		content = columns;
+		return;
+	}
+	copyComplexFromMxArray(array, offset, content.size(), content.data());
+}
+
+template <typename Derived>
+void convertToComplex(const mxArray* array, Eigen::PlainObjectBase<Derived>& content)
+{
+	if (!mxIsNumeric(array)) throw std::runtime_error("Variable is not numeric");
+	if (mxGetNumberOfDimensions(array) != 2) throw std::runtime_error("Variable is not 2-dimensional");
+
+	Eigen::Index rows = mxGetM(array);
+	Eigen::Index cols = mxGetN(array);
+	if (Derived::IsVectorAtCompileTime)
+	{
+		if (rows != 1 && cols != 1) throw std::runtime_error("Variable is not a vector!");
+		const Eigen::Index n = rows*cols;
+		rows = (Derived::RowsAtCompileTime == 1) ? 1 : n;
+		cols = (Derived::RowsAtCompileTime == 1) ? n : 1;
+	}
+	if ((Derived::RowsAtCompileTime != Eigen::Dynamic && Derived::RowsAtCompileTime != rows) ||
+		(Derived::ColsAtCompileTime != Eigen::Dynamic && Derived::ColsAtCompileTime != cols))
+	{
+		throw std::runtime_error("Dimensions of the variable do not match the fixed size type");
+	}
+
+	content.resize(rows, cols);
+	loadComplex(array, 0, content);
+}
+
+template <typename Real>
+void convertToComplex(const mxArray* array, std::complex<Real>& content)
+{
+	if (!mxIsNumeric(array)) throw std::runtime_error("Variable is not numeric");
+	if (mxGetNumberOfElements(array) != 1) throw std::runtime_error("Variable is not a scalar (has more than 1 element)");
+	copyComplexFromMxArray(array, 0, 1, &content);
+}
+
+// std::vectors of complex scalars are stored as complex row vectors
+template <typename Real, typename AllocatorType>
+struct ComplexScalarsStore
+{
+	explicit ComplexScalarsStore(const std::vector<std::complex<Real>, AllocatorType>& content) : content(content) {}
+
+	template <typename Parts>
+	void operator()(Parts& parts) const { parts.store(0, content.data(), content.size()); }
+
+	const std::vector<std::complex<Real>, AllocatorType>& content;
+};
+
+// std::vectors of complex matrices are stored as 3-D arrays, one slice per matrix
+template <typename ContentType, typename AllocatorType>
+struct ComplexSlicesStore
+{
+	explicit ComplexSlicesStore(const std::vector<ContentType, AllocatorType>& content) : content(content) {}
+
+	template <typename Parts>
+	void operator()(Parts& parts) const
+	{
+		for (size_t i=0; i<content.size(); i++) { parts.store(i*content[0].size(), content[i]); }
+	}
+
+	const std::vector<ContentType, AllocatorType>& content;
+};
+
+template <typename Real, typename AllocatorType>
+mxArray* convertFromComplexVector(const std::vector<std::complex<Real>, AllocatorType>& content, NUMERIC_STORAGE numericStorage, MxArrayPool* pool)
+{
+	size_t dims[2] = { 1, content.size() };
+	return createComplexArray<Real>(2, dims, numericStorage, pool, ComplexScalarsStore<Real, AllocatorType>(content));
+}
+
+template <typename ContentType, typename AllocatorType>
+mxArray* convertFromComplexVector(const std::vector<ContentType, AllocatorType>& content, NUMERIC_STORAGE numericStorage, MxArrayPool* pool)
+{
+	typedef typename ContentType::Scalar::value_type Real;
+	if (content.size() == 0) throw std::runtime_error("Vector is empty.");
+
+	size_t dims[3] = { static_cast<size_t>(content[0].rows()), static_cast<size_t>(content[0].cols()), content.size() };
+	for (size_t i=0; i<content.size(); i++)
+	{
+		if (static_cast<size_t>(content[i].rows()) != dims[0] || static_cast<size_t>(content[i].cols()) != dims[1])
+		{
+			throw std::runtime_error("Not all matrices in vector are of equal size.");
+		}
+	}
+	return createComplexArray<Real>(3, dims, numericStorage, pool, ComplexSlicesStore<ContentType, AllocatorType>(content));
+}
+
+template <typename Real, typename AllocatorType>
+void convertToComplexVector(const mxArray* array, std::vector<std::complex<Real>, AllocatorType>& content)
+{
+	if (!mxIsNumeric(array)) throw std::runtime_error("Variable is not numeric");
+	content.resize(mxGetNumberOfElements(array));
+	copyComplexFromMxArray(array, 0, content.size(), content.data());
+}
+
+template <typename ContentType, typename AllocatorType>
+void convertToComplexVector(const mxArray* array, std::vector<ContentType, AllocatorType>& content)
+{
+	if (!mxIsNumeric(array)) throw std::runtime_error("Variable is not numeric");
+
+	// Matlab drops the trailing singleton dimension of a single slice
+	const size_t nDims = mxGetNumberOfDimensions(array);
+	if (nDims != 2 && nDims != 3) throw std::runtime_error("Variable is not 3-dimensional");
+
+	const size_t* dims = mxGetDimensions(array);
+	const Eigen::Index rows = dims[0];
+	const Eigen::Index cols = dims[1];
+	if ((ContentType::RowsAtCompileTime != Eigen::Dynamic && ContentType::RowsAtCompileTime != rows) ||
+		(ContentType::ColsAtCompileTime != Eigen::Dynamic && ContentType::ColsAtCompileTime != cols))
+	{
+		throw std::runtime_error("Dimensions of the slices do not match the fixed size type");
+	}
+
+	content.resize((nDims == 3) ? dims[2] : 1);
+	for (size_t i=0; i<content.size(); i++)
+	{
+		content[i].resize(rows, cols);
+		loadComplex(array, i*rows*cols, content[i]);
+	}
+}
+
+} // namespace matlab
+
+#endif /* MXCOMPLEXCONVERSION_HPP_ */
@@ -0,0 +1,68 @@
+/*
+ * MxSlicesConversion.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXSLICESCONVERSION_HPP_
+#define MXSLICESCONVERSION_HPP_
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <matlabCppInterface/MatrixSlices.hpp>
+#include <matlabCppInterface/MxArrayPool.hpp>
+#include <matlabCppInterface/internal/MxClassTraits.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+template <typename Type>
+struct IsMatrixSlices : std::false_type {};
+
+template <typename Scalar>
+struct IsMatrixSlices<MatrixSlices<Scalar> > : std::true_type {};
+
+///
+/// An array of the dimensions of the slices, the buffer is copied in one pass
+///
+template <typename Scalar>
+mxArray* convertFromSlices(const MatrixSlices<Scalar>& content, NUMERIC_STORAGE numericStorage, MxArrayPool* pool)
+{
+	// every element is overwritten below
+	mxClassID classId = storageClass<Scalar>(numericStorage);
+	mxArray* array = createUninitArray(pool, content.dims().size(), content.dims().data(), classId, mxREAL);
+	if (content.size() == 0) { return array; }
+
+	if (classId == MxClassTraits<Scalar>::classId)
+	{
+		memcpy(mxGetData(array), content.data(), content.size()*sizeof(Scalar));
+	} else
+	{
+		typedef Eigen::Array<Scalar, Eigen::Dynamic, 1> Elements;
+		Eigen::Map<Eigen::ArrayXd>(mxGetPr(array), content.size()) = Eigen::Map<const Elements>(content.data(), content.size()).template cast<double>();
+	}
+	return array;
+}
+
+///
+/// Takes the dimensions of any dense real numeric or logical array, converting its class if needed
+///
+template <typename Scalar>
+void convertToSlices(const mxArray* array, MatrixSlices<Scalar>& content)
+{
+	if (!mxIsNumeric(array) && !mxIsLogical(array)) throw std::runtime_error("Variable is not numeric");
+	if (mxIsComplex(array)) throw std::runtime_error("Variable is complex");
+
+	const mwSize* dims = mxGetDimensions(array);
+	content.resize(std::vector<size_t>(dims, dims + mxGetNumberOfDimensions(array)));
+
+	// a single memcpy if the classes match
+	copyFromMxArray(array, 0, content.size(), content.data());
+}
+
+} // namespace matlab
+
+#endif /* MXSLICESCONVERSION_HPP_ */
@@ -0,0 +1,120 @@
+/*
+ * MxSparseConversion.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXSPARSECONVERSION_HPP_
+#define MXSPARSECONVERSION_HPP_
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+#include "matrix.h"
+
+namespace matlab {
+
+template <typename Type>
+struct IsSparseMatrix : std::false_type {};
+
+template <typename Scalar, int Options, typename StorageIndex>
+struct IsSparseMatrix<Eigen::SparseMatrix<Scalar, Options, StorageIndex> > : std::true_type {};
+
+// Matlab stores the compressed columns with mwIndex, which has the size of its signed counterpart
+typedef Eigen::Map<const Eigen::SparseMatrix<double, Eigen::ColMajor, mwSignedIndex> > MxSparseMap;
+
+///
+/// View on the column pointers, row indices and values of a real double sparse array,
+/// valid as long as the array is
+///
+inline MxSparseMap mapSparse(const mxArray* array)
+{
+	if (!mxIsSparse(array) || !mxIsDouble(array) || mxIsComplex(array)) throw std::runtime_error("Variable is not a real double sparse matrix");
+
+	const mwSignedIndex* columns = reinterpret_cast<const mwSignedIndex*>(mxGetJc(array));
+	const mwSignedIndex* rows = reinterpret_cast<const mwSignedIndex*>(mxGetIr(array));
+	size_t nCols = mxGetN(array);
+	return MxSparseMap(mxGetM(array), nCols, columns[nCols], columns, rows, mxGetPr(array));
+}
+
+///
+/// Copies the compressed columns into a double sparse array. Only the stored non-zeros are copied.
+///
+template <typename Scalar, typename StorageIndex>
+mxArray* convertFromSparse(const Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>& columns)
+{
+	mxArray* array = mxCreateSparse(columns.rows(), columns.cols(), std::max<size_t>(columns.nonZeros(), 1), mxREAL);
+	mwIndex* jc = mxGetJc(array);
+	mwIndex* ir = mxGetIr(array);
+	double* pr = mxGetPr(array);
+
+	if (columns.isCompressed())
+	{
+		std::copy(columns.outerIndexPtr(), columns.outerIndexPtr() + columns.cols() + 1, jc);
+		std::copy(columns.innerIndexPtr(), columns.innerIndexPtr() + columns.nonZeros(), ir);
+		std::copy(columns.valuePtr(), columns.valuePtr() + columns.nonZeros(), pr);
+		return array;
+	}
+
+	// uncompressed matrices have free space after each column
+	jc[0] = 0;
+	for (Eigen::Index col=0; col<columns.cols(); col++)
+	{
+		StorageIndex begin = columns.outerIndexPtr()[col];
+		StorageIndex n = columns.innerNonZeroPtr()[col];
+		std::copy(columns.innerIndexPtr() + begin, columns.innerIndexPtr() + begin + n, ir + jc[col]);
+		std::copy(columns.valuePtr() + begin, columns.valuePtr() + begin + n, pr + jc[col]);
+		jc[col+1] = jc[col] + n;
+	}
+	return array;
+}
+
+///
+/// Row major matrices are transposed into column major order first, only then copied
+///
+template <typename Scalar, typename StorageIndex>
+mxArray* convertFromSparse(const Eigen::SparseMatrix<Scalar, Eigen::RowMajor, StorageIndex>& rows)
+{
+	return convertFromSparse(Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>(rows));
+}
+
+///
+/// Fills the matrix from a double or logical sparse array, straight from its compressed columns
+///
+template <typename Scalar, int Options, typename StorageIndex>
+void convertToSparse(const mxArray* array, Eigen::SparseMatrix<Scalar, Options, StorageIndex>& content)
+{
+	if (!mxIsSparse(array)) throw std::runtime_error("Variable is not sparse");
+	if (mxIsComplex(array)) throw std::runtime_error("Variable is complex");
+
+	if (mxIsDouble(array))
+	{
+		// column by column in one pass over the non-zeros, row major matrices are transposed by Eigen
+		content = mapSparse(array).template cast<Scalar>();
+		return;
+	}
+	if (!mxIsLogical(array)) throw std::runtime_error("Variable is neither a double nor a logical sparse matrix");
+
+	const mwIndex* jc = mxGetJc(array);
+	const mwIndex* ir = mxGetIr(array);
+	const mxLogical* values = mxGetLogicals(array);
+	size_t nCols = mxGetN(array);
+
+	Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex> columns(mxGetM(array), nCols);
+	columns.reserve(jc[nCols]);
+	for (size_t col=0; col<nCols; col++)
+	{
+		columns.startVec(col);
+		for (mwIndex k=jc[col]; k<jc[col+1]; k++) { columns.insertBack(ir[k], col) = static_cast<Scalar>(values[k]); }
+	}
+	columns.finalize();
+	content = columns;
+}
+
+} // namespace matlab
+
+#endif /* MXSPARSECONVERSION_HPP_ */
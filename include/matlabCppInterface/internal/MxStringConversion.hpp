@@ -0,0 +1,141 @@
+/*
+ * MxStringConversion.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXSTRINGCONVERSION_HPP_
+#define MXSTRINGCONVERSION_HPP_
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "matrix.h"
+
+namespace matlab {
+
+// 7-bit ASCII maps one to one onto mxChar, in any locale
+inline bool isAscii(const std::string& content)
+{
+	for (size_t i=0; i<content.size(); i++)
+	{
+		if (static_cast<unsigned char>(content[i]) >= 0x80) { return false; }
+	}
+	return true;
+}
+
+// ASCII is stored character by character, other text is converted from the locale's
+// multibyte encoding by mxCreateString
+inline mxArray* createCharRow(const std::string& content)
+{
+	if (!isAscii(content)) { return mxCreateString(content.c_str()); }
+
+	// Matlab creates empty strings as 0x0 char arrays
+	mwSize dims[2] = { static_cast<mwSize>(content.empty() ? 0 : 1), content.size() };
+	mxArray* array = mxCreateCharArray(2, dims);
+	mxChar* chars = mxGetChars(array);
+	for (size_t i=0; i<content.size(); i++) { chars[i] = static_cast<mxChar>(content[i]); }
+	return array;
+}
+
+// converts n characters that are stride apart to the locale's multibyte encoding through mxArrayToString
+inline void decodeMultibyteChars(const mxChar* chars, size_t n, size_t stride, std::string& content)
+{
+	mwSize dims[2] = { 1, n };
+	mxArray* row = mxCreateCharArray(2, dims);
+	mxChar* rowChars = mxGetChars(row);
+	for (size_t i=0; i<n; i++) { rowChars[i] = chars[i*stride]; }
+
+	char* text = mxArrayToString(row);
+	mxDestroyArray(row);
+	if (text == NULL) throw std::runtime_error("Characters cannot be converted to the multibyte encoding of the locale");
+	content = text;
+	mxFree(text);
+}
+
+// decodes n characters that are stride apart straight into the storage of the string,
+// as long as they are ASCII
+inline void decodeChars(const mxChar* chars, size_t n, size_t stride, std::string& content)
+{
+	content.resize(n);
+	for (size_t i=0; i<n; i++)
+	{
+		mxChar c = chars[i*stride];
+		if (c >= 0x80)
+		{
+			decodeMultibyteChars(chars, n, stride, content);
+			return;
+		}
+		content[i] = static_cast<char>(c);
+	}
+}
+
+///
+/// All characters of a char array in column major order, empty arrays are empty strings
+///
+inline void convertToString(const mxArray* array, std::string& content)
+{
+	if (!mxIsChar(array)) throw std::runtime_error("Variable is not a character/string");
+
+	decodeChars(mxGetChars(array), mxGetNumberOfElements(array), 1, content);
+}
+
+///
+/// A 1xn cell array of char rows (a cellstr), the whole list is transferred as one array
+///
+template <typename AllocatorType>
+mxArray* convertFromStrings(const std::vector<std::string, AllocatorType>& content)
+{
+	mxArray* array = mxCreateCellMatrix(1, content.size());
+	for (size_t i=0; i<content.size(); i++)
+	{
+		mxSetCell(array, i, createCharRow(content[i]));
+	}
+	return array;
+}
+
+///
+/// Reads a cell array of char arrays or the rows of a char matrix. Like cellstr, the rows
+/// of a char matrix lose their trailing blanks. The strings of content are reused, so
+/// repeated gets of similar lists do not allocate.
+///
+template <typename AllocatorType>
+void convertToStrings(const mxArray* array, std::vector<std::string, AllocatorType>& content)
+{
+	if (mxIsChar(array))
+	{
+		if (mxGetNumberOfDimensions(array) != 2) throw std::runtime_error("Variable is not a 2-dimensional char matrix");
+
+		// one string per row, the characters of a row are one column apart
+		size_t rows = mxGetM(array);
+		size_t cols = mxGetN(array);
+		const mxChar* chars = mxGetChars(array);
+		content.resize(rows);
+		for (size_t i=0; i<rows; i++)
+		{
+			size_t length = cols;
+			while (length > 0 && chars[i + (length-1)*rows] == ' ') { length--; }
+			decodeChars(chars + i, length, rows, content[i]);
+		}
+		return;
+	}
+	if (!mxIsCell(array)) throw std::runtime_error("Variable is neither a cell array nor a char matrix");
+
+	content.resize(mxGetNumberOfElements(array));
+	for (size_t i=0; i<content.size(); i++)
+	{
+		const mxArray* cell = mxGetCell(array, i);
+		if (cell == NULL)
+		{
+			content[i].clear();
+			continue;
+		}
+		if (!mxIsChar(cell)) throw std::runtime_error("Cell is not a character/string");
+		decodeChars(mxGetChars(cell), mxGetNumberOfElements(cell), 1, content[i]);
+	}
+}
+
+} // namespace matlab
+
+#endif /* MXSTRINGCONVERSION_HPP_ */
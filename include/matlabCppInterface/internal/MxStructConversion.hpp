@@ -0,0 +1,200 @@
+/*
+ * MxStructConversion.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MXSTRUCTCONVERSION_HPP_
+#define MXSTRUCTCONVERSION_HPP_
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <matlabCppInterface/StructTraits.hpp>
+#include <matlabCppInterface/internal/helpers.hpp>
+
+#include "matrix.h"
+
+namespace matlab {
+
+template <class ContentType> class MxArrayWrapper;
+template <class ContentType, class AllocatorType> class MxArrayNDimWrapper;
+
+// the wrapper that converts a type, std::vectors are stored as N-dimensional arrays
+template <typename ValueType>
+struct MxArrayWrapperFor { typedef MxArrayWrapper<ValueType> type; };
+
+template <typename ValueType, typename AllocatorType>
+struct MxArrayWrapperFor<std::vector<ValueType, AllocatorType> > { typedef MxArrayNDimWrapper<ValueType, AllocatorType> type; };
+
+// converts the array of a wrapper into value, false if a dense array does not fit the slices of a vector,
+// the other conversion errors are thrown
+template <typename ValueType>
+bool getWrapped(MxArrayWrapper<ValueType>& wrapped, ValueType& value)
+{
+	wrapped.get(value);
+	return true;
+}
+
+template <typename ValueType, typename AllocatorType>
+bool getWrapped(MxArrayNDimWrapper<ValueType, AllocatorType>& wrapped, std::vector<ValueType, AllocatorType>& value)
+{
+	return wrapped.get(value);
+}
+
+// the field names of a reflected struct, collected once per type
+template <typename Type>
+class StructLayout
+{
+public:
+	static const StructLayout& get()
+	{
+		static const StructLayout layout;
+		return layout;
+	}
+
+	const std::vector<const char*>& names() const { return _names; }
+
+	// the field numbers of the names in an array, the array may have more fields
+	std::vector<int> fieldNumbers(const mxArray* array) const
+	{
+		std::vector<int> numbers(_names.size());
+		for (size_t i=0; i<_names.size(); i++)
+		{
+			numbers[i] = mxGetFieldNumber(array, _names[i]);
+			if (numbers[i] < 0) throw std::runtime_error(std::string("Struct has no field ") + _names[i]);
+		}
+		return numbers;
+	}
+
+	template <typename Member>
+	void operator()(const char* name, Member member) { _names.push_back(name); }
+
+private:
+	StructLayout() { StructTraits<Type>::visitFields(*this); }
+
+	std::vector<const char*> _names;
+};
+
+// converts the fields of one element into the fields of a struct array
+template <typename Type>
+struct StructFieldWriter
+{
+	StructFieldWriter(const Type& content, mxArray* array, size_t index, NUMERIC_STORAGE numericStorage) :
+		content(content), array(array), index(index), numericStorage(numericStorage), field(0)
+	{}
+
+	template <typename FieldType>
+	void operator()(const char* name, FieldType Type::* member)
+	{
+		typename MxArrayWrapperFor<FieldType>::type wrapped(content.*member, numericStorage);
+		mxSetFieldByNumber(array, index, field++, wrapped.release());
+	}
+
+	const Type& content;
+	mxArray* array;
+	size_t index;
+	NUMERIC_STORAGE numericStorage;
+	int field;
+};
+
+// converts the fields of one element of a struct array, the fields stay owned by the array
+template <typename Type>
+struct StructFieldReader
+{
+	StructFieldReader(const mxArray* array, size_t index, const std::vector<int>& fieldNumbers, Type& content) :
+		array(array), index(index), fieldNumbers(fieldNumbers), content(content), field(0)
+	{}
+
+	template <typename FieldType>
+	void operator()(const char* name, FieldType Type::* member)
+	{
+		mxArray* value = mxGetFieldByNumber(array, index, fieldNumbers[field++]);
+		if (value == NULL) throw std::runtime_error(std::string("Field ") + name + " is empty");
+
+		typename MxArrayWrapperFor<FieldType>::type wrapped;
+		wrapped.mxArrayPtr() = value;
+		bool success = false;
+		try
+		{
+			success = getWrapped(wrapped, content.*member);
+		} catch (...)
+		{
+			wrapped.mxArrayPtr() = NULL;
+			throw;
+		}
+		wrapped.mxArrayPtr() = NULL;
+		if (!success) throw std::runtime_error(std::string("Field ") + name + " does not fit the slices of the vector");
+	}
+
+	const mxArray* array;
+	size_t index;
+	const std::vector<int>& fieldNumbers;
+	Type& content;
+	int field;
+};
+
+// creates a 1xn struct array, all elements share the field layout of the type
+template <typename Type>
+mxArray* convertFromStructs(const Type* content, size_t n, NUMERIC_STORAGE numericStorage)
+{
+	const std::vector<const char*>& names = StructLayout<Type>::get().names();
+	mxArray* array = mxCreateStructMatrix(1, n, names.size(), const_cast<const char**>(names.data()));
+
+	try
+	{
+		for (size_t i=0; i<n; i++)
+		{
+			StructFieldWriter<Type> writer(content[i], array, i, numericStorage);
+			StructTraits<Type>::visitFields(writer);
+		}
+	} catch (...)
+	{
+		mxDestroyArray(array);
+		throw;
+	}
+	return array;
+}
+
+template <typename Type>
+void convertToStruct(const mxArray* array, Type& content)
+{
+	if (!mxIsStruct(array)) throw std::runtime_error("Variable is not a struct");
+	if (mxGetNumberOfElements(array) != 1) throw std::runtime_error("Variable is not a scalar struct (has more than 1 element)");
+
+	std::vector<int> fieldNumbers = StructLayout<Type>::get().fieldNumbers(array);
+	StructFieldReader<Type> reader(array, 0, fieldNumbers, content);
+	StructTraits<Type>::visitFields(reader);
+}
+
+// reads a struct array or a cell array of scalar structs
+template <typename Type, typename AllocatorType>
+void convertToStructs(const mxArray* array, std::vector<Type, AllocatorType>& content)
+{
+	if (!mxIsStruct(array) && !mxIsCell(array)) throw std::runtime_error("Variable is neither a struct nor a cell array");
+
+	content.resize(mxGetNumberOfElements(array));
+	if (mxIsCell(array))
+	{
+		for (size_t i=0; i<content.size(); i++)
+		{
+			const mxArray* cell = mxGetCell(array, i);
+			if (cell == NULL) throw std::runtime_error("Cell is empty");
+			convertToStruct(cell, content[i]);
+		}
+		return;
+	}
+
+	// the field numbers are the same for all elements
+	std::vector<int> fieldNumbers = StructLayout<Type>::get().fieldNumbers(array);
+	for (size_t i=0; i<content.size(); i++)
+	{
+		StructFieldReader<Type> reader(array, i, fieldNumbers, content[i]);
+		StructTraits<Type>::visitFields(reader);
+	}
+}
+
+} // namespace matlab
+
+#endif /* MXSTRUCTCONVERSION_HPP_ */
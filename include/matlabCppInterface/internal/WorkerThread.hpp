@@ -0,0 +1,83 @@
+/*
+ * WorkerThread.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef WORKERTHREAD_HPP_
+#define WORKERTHREAD_HPP_
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <type_traits>
+
+namespace matlab {
+
+///
+/// @class WorkerThread
+/// @brief executes submitted tasks one after another, in submission order, on a single thread.
+///
+/// The thread is started with the first task. Results and exceptions of a task are
+/// handed back through the returned future.
+///
+class WorkerThread
+{
+public:
+	WorkerThread();
+
+	// finishes all queued tasks before the thread is joined
+	~WorkerThread();
+
+	template <typename Function>
+	std::future<typename std::result_of<Function()>::type> submit(Function function);
+
+	// blocks until all queued tasks have been executed
+	void waitUntilIdle();
+
+	bool isIdle();
+
+private:
+	void start();
+
+	void run();
+
+	WorkerThread(const WorkerThread&);
+	WorkerThread& operator=(const WorkerThread&);
+
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _taskAvailable;
+	std::condition_variable _idle;
+	std::deque<std::function<void()> > _tasks;
+	bool _busy;
+	bool _stopping;
+};
+
+
+template <typename Function>
+std::future<typename std::result_of<Function()>::type> WorkerThread::submit(Function function)
+{
+	typedef typename std::result_of<Function()>::type Result;
+
+	// std::function needs a copyable target, packaged tasks are move only
+	std::shared_ptr<std::packaged_task<Result()> > task = std::make_shared<std::packaged_task<Result()> >(function);
+	std::future<Result> result = task->get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_thread.joinable()) { start(); }
+		_tasks.push_back([task]() { (*task)(); });
+	}
+	_taskAvailable.notify_one();
+
+	return result;
+}
+
+} // namespace matlab
+
+#endif /* WORKERTHREAD_HPP_ */
@@ -10,8 +10,20 @@
 
 #include <string>
 #include <cassert>
+#include <cctype>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
 
 namespace matlab {
+
+// How numeric data is stored on put
+enum NUMERIC_STORAGE {
+	STORE_AS_DOUBLE = 0, // all numeric types are widened to double (Matlab default)
+	STORE_NATIVE // each type is stored in its matching Matlab class, e.g. float as single
+};
+
 namespace helpers {
 
 inline void assertValidVariableName(const std::string& name)
@@ -22,8 +34,70 @@ inline void assertValidVariableName(const std::string& name)
 	assert(name != "i" && name!="j" && name!="mode" && name!="char" && name!="size" && name!="path" && "Illegal name, would overlay Matlab built-in function/type name");
 }
 
-} // namespace matlab
+// upper bound of the threads of parallelFor, more rarely pay off for memory bound conversions
+const size_t MAX_PARALLEL_THREADS = 8;
+
+// joins the threads of parallelFor on every way out of it
+class ThreadJoiner
+{
+public:
+	explicit ThreadJoiner(std::vector<std::thread>& threads) : _threads(threads) {}
+
+	~ThreadJoiner()
+	{
+		for (size_t i=0; i<_threads.size(); i++)
+		{
+			if (_threads[i].joinable()) { _threads[i].join(); }
+		}
+	}
+
+private:
+	std::vector<std::thread>& _threads;
+};
+
+// Calls function(begin, end) on contiguous sub ranges of [0, n). The ranges are processed
+// by several threads if there is enough work, i.e. at least minWorkPerThread items each.
+// The first exception thrown by any range is rethrown after all threads have finished.
+template <typename Function>
+void parallelFor(size_t n, size_t minWorkPerThread, Function function)
+{
+	// hardware_concurrency may be 0 if it is unknown
+	size_t nThreads = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), MAX_PARALLEL_THREADS);
+	nThreads = std::min<size_t>(nThreads, n / std::max<size_t>(minWorkPerThread, 1));
+	if (nThreads <= 1)
+	{
+		function(0, n);
+		return;
+	}
+
+	std::vector<std::exception_ptr> errors(nThreads);
+	std::vector<std::thread> threads;
+	threads.reserve(nThreads-1);
+	size_t chunk = (n + nThreads - 1) / nThreads;
+	{
+		ThreadJoiner joiner(threads);
+		size_t index = 1;
+		for (size_t begin=chunk; begin<n; begin+=chunk, index++)
+		{
+			size_t end = std::min(begin+chunk, n);
+			std::exception_ptr& error = errors[index];
+			threads.push_back(std::thread([&function, &error, begin, end]()
+			{
+				try { function(begin, end); } catch (...) { error = std::current_exception(); }
+			}));
+		}
+
+		try { function(0, std::min(chunk, n)); } catch (...) { errors[0] = std::current_exception(); }
+	}
+
+	for (size_t i=0; i<errors.size(); i++)
+	{
+		if (errors[i]) { std::rethrow_exception(errors[i]); }
+	}
+}
+
 } // namespace helpers
+} // namespace matlab
 
 
 #endif /* HELPERS_HPP_ */
@@ -1,29 +1,42 @@
 #include <matlabCppInterface/Engine.hpp>
+#include <matlabCppInterface/LibEngBackend.hpp>
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <stdio.h>
 
 namespace matlab {
 
-
-Engine::Engine()
+Engine::Engine() :
+	_backend(new LibEngBackend())
 {
-	_engine = NULL;
-	// make sure the output buffer is NULL terminated
-	_outputBuffer[OUTPUT_BUFFER_SIZE] = '\0';
+	_numericStorage = STORE_AS_DOUBLE;
+	_outputCapture = CAPTURE_BUFFERED;
+	_sharedMemoryThreshold = 0;
+	_sharedMemoryDirectory = SharedMemorySegment::DEFAULT_DIRECTORY;
 }
 
-Engine::Engine(bool startMatlabAtInitialization)
+Engine::Engine(bool startMatlabAtInitialization) :
+	_backend(new LibEngBackend())
 {
-	// make sure the output buffer is NULL terminated
-	_outputBuffer[OUTPUT_BUFFER_SIZE] = '\0';
+	_numericStorage = STORE_AS_DOUBLE;
+	_outputCapture = CAPTURE_BUFFERED;
+	_sharedMemoryThreshold = 0;
+	_sharedMemoryDirectory = SharedMemorySegment::DEFAULT_DIRECTORY;
 
 	if (startMatlabAtInitialization)
-	{
-		_engine = engOpen(NULL);
+		_backend->open();
+}
 
-		// tell Matlab where to store the output
-		engOutputBuffer(_engine, _outputBuffer, OUTPUT_BUFFER_SIZE);
-	}
+Engine::Engine(std::unique_ptr<EngineBackend> backend) :
+	_backend(std::move(backend))
+{
+	if (!_backend) throw std::runtime_error("The engine needs a backend");
+
+	_numericStorage = STORE_AS_DOUBLE;
+	_outputCapture = CAPTURE_BUFFERED;
+	_sharedMemoryThreshold = 0;
+	_sharedMemoryDirectory = SharedMemorySegment::DEFAULT_DIRECTORY;
 }
 
 #ifdef UNIX
@@ -37,40 +50,60 @@ Engine::Engine(std::string hostename)
 
 Engine::~Engine()
 {
-	if (_engine!=NULL)
+	waitForAsync();
+
+	// destructors must not throw, a session that cannot be closed is only reported
+	if (_backend->isOpen() && !_backend->close())
 	{
-		int success = engClose(_engine);
-		if(success != 0) throw(std::runtime_error("Closing Matlab was not possible. Maybe already closed."));
+		std::cout<<"Warning, closing Matlab was not possible. Maybe already closed."<<std::endl;
 	}
 }
 
+#ifdef WIN32
+bool Engine::setVisibility(bool visible)
+{
+	LibEngBackend* backend = dynamic_cast<LibEngBackend*>(_backend.get());
+	return backend != NULL && engSetVisible(backend->handle(), static_cast<int>(visible)) == 0;
+}
+
+bool Engine::isVisible()
+{
+	LibEngBackend* backend = dynamic_cast<LibEngBackend*>(_backend.get());
+	if (backend == NULL) return false;
+
+	bool visible;
+	int success = engGetVisible(backend->handle(), &visible);
+	assert(success == 0 && "Determining the visibility was not possible. Matlab error");
+	return visible;
+}
+#endif
+
 bool Engine::initialize()
 {
 	if (isInitialized())
 		return true;
 
-	_engine = engOpen(NULL);
-
-	// tell Matlab where to store the output
-	engOutputBuffer(_engine, _outputBuffer, OUTPUT_BUFFER_SIZE);
-
-	return (_engine!=NULL);
+	Statistics::Call call(_statistics, Statistics::OPEN);
+	call.transport();
+	bool success = _backend->open();
+	call.setSucceeded(success);
+	return success;
 }
 
 bool Engine::stop()
 {
-	bool success = true;
-	if (_engine != NULL)
-	{
-		success = (engClose(_engine) == 0);
-		_engine = NULL;
-	}
+	waitForAsync();
+
+	Statistics::Call call(_statistics, Statistics::CLOSE);
+	call.transport();
+	bool success = _backend->close();
+	call.setSucceeded(success);
 	return success;
 }
 
 bool Engine::isInitialized()
 {
-	return (_engine != NULL);
+	return _backend->isOpen();
 }
 
 bool Engine::good()
@@ -80,7 +113,7 @@ bool Engine::good()
 
 	bool success = false;
 	try {
-		success = executeCommand("disp('sm::Matlab Engine-Test')") == ">> sm::Matlab Engine-Test";
+		success = executeCommand("disp('sm::Matlab Engine-Test')") == "sm::Matlab Engine-Test";
 	}
 	catch (...)
 	{
@@ -90,20 +123,70 @@ bool Engine::good()
 }
 
 std::string Engine::executeCommand(const std::string& command)
+{
+	std::string output;
+	executeCommand(command, output);
+	return output;
+}
+
+void Engine::executeCommand(const std::string& command, std::string& output)
+{
+	assertIsInitialized();
+	waitForAsync();
+
+	Statistics::Call call(_statistics, Statistics::EXECUTE_COMMAND);
+	evaluate(command, output, call);
+}
+
+std::future<std::string> Engine::executeCommandAsync(const std::string& command)
 {
 	assertIsInitialized();
 
-	// execute the command
-	int success = engEvalString(_engine, command.c_str());
+	std::shared_ptr<Statistics::Call> call = std::make_shared<Statistics::Call>(_statistics, Statistics::EXECUTE_COMMAND);
+	return _worker.submit([this, command, call]()
+	{
+		std::string output;
+		evaluate(command, output, *call);
+		call->finish();
+		return output;
+	});
+}
+
+void Engine::setOutputCapture(OUTPUT_CAPTURE outputCapture)
+{
+	// queued commands finish with the capture they were queued with
+	waitForAsync();
+	_outputCapture = outputCapture;
+	_backend->setUnboundedOutput(outputCapture == CAPTURE_ALL);
+}
+
+void Engine::waitForAsync()
+{
+	_worker.waitUntilIdle();
+}
+
+void Engine::evaluate(const std::string& command, std::string& output, Statistics::Call& call)
+{
+	output.clear();
+
+	call.transport();
+	bool success;
+	if (_outputCapture == CAPTURE_NONE)
+	{
+		success = _backend->evaluate(command, NULL, EngineBackend::OutputCallback());
+	} else
+	{
+		success = _backend->evaluate(command, &output, _outputCallback);
+	}
+	call.addBytes(command.size() + output.size());
+	call.setSucceeded(success);
+
 	// check for failures
-	assert(success == 0 && "Failed to execute command. Maybe Matlab is already closed. Note: This assert is NOT thrown due to invalid Matlab syntax");
-	// return the result
-	std::string output(_outputBuffer);
+	assert(success && "Failed to execute command. Maybe Matlab is already closed. Note: This assert is NOT thrown due to invalid Matlab syntax");
+
 	// remove line break
-	if(output.size()>0)
+	if(output.size()>0 && output[output.size()-1] == '\n')
 		output.resize(output.size() - 1);
-
-	return output;
 }
 
 std::string Engine::showWorkspace()
@@ -148,74 +231,221 @@ void Engine::openCommandLine()
 	}
 }
 
+std::vector<bool> Engine::putMany(VariableBatch& batch)
+{
+	assertIsInitialized();
+	waitForAsync();
+
+	Statistics::Call call(_statistics, Statistics::PUT);
+
+	std::vector<bool> status(batch._puts.size(), false);
+
+	// a later put of the same name wins
+	std::vector<std::string> names;
+	std::vector<mxArray*> values;
+	for (size_t i=0; i<batch._puts.size(); i++)
+	{
+		VariableBatch::Put& put = batch._puts[i];
+		if (put.value == NULL) { continue; }
+
+		std::vector<std::string>::iterator name = std::find(names.begin(), names.end(), put.name);
+		if (name == names.end())
+		{
+			names.push_back(put.name);
+			values.push_back(put.value);
+		} else
+		{
+			mxDestroyArray(values[name - names.begin()]);
+			values[name - names.begin()] = put.value;
+		}
+		put.value = NULL;
+		status[i] = true;
+	}
+	batch._puts.clear();
+
+	// the values were converted by VariableBatch::put already
+	for (size_t i=0; i<values.size(); i++) { call.addArray(values[i]); }
+
+	// the backend takes over the arrays
+	call.transport();
+	bool success = _backend->putVariables(names, values);
+	call.setSucceeded(success);
+	if (!success) { status.assign(status.size(), false); }
+	return status;
+}
+
+std::vector<bool> Engine::getMany(VariableBatch& batch)
+{
+	assertIsInitialized();
+	waitForAsync();
+
+	std::vector<bool> status(batch._gets.size(), false);
+	if (batch._gets.empty()) { return status; }
+
+	Statistics::Call call(_statistics, Statistics::GET);
+
+	std::vector<std::string> names(batch._gets.size());
+	for (size_t i=0; i<batch._gets.size(); i++)
+	{
+		names[i] = batch._gets[i].name;
+	}
+
+	call.transport();
+	std::vector<mxArray*> values = _backend->getVariables(names);
+
+	call.conversion();
+	for (size_t i=0; i<batch._gets.size(); i++)
+	{
+		call.addArray(values[i]);
+		status[i] = (values[i] != NULL) && batch._gets[i].receive(values[i]);
+		if (values[i] != NULL) { mxDestroyArray(values[i]); }
+	}
+	call.setSucceeded(std::find(status.begin(), status.end(), false) == status.end());
+
+	return status;
+}
+
 // TESTERS
 // *******
 
   bool Engine::exists(const std::string& name)
   {
-	assertIsInitialized();
-	helpers::assertValidVariableName(name);
-	// Get variable from matlab
-	mxArray* mxArray = engGetVariable(_engine, name.c_str());
-	// Check if variable exists
-	return (mxArray!=NULL);
+	return describe(name).exists;
   }
 
   bool Engine::isScalar(const std::string& name)
   {
-	assertIsInitialized();
-	helpers::assertValidVariableName(name);
-	// Get variable from matlab
-	mxArray* mxArray = engGetVariable(_engine, name.c_str());
-	// Check if variable exists
-	if (mxArray==NULL) { std::cout<<"Variable "+name+" does not exist."<<std::endl; throw; }
-
-	return mxGetNumberOfElements(mxArray) == 1;
+	return describeExisting(name).isScalar();
   }
 
   bool Engine::isEmpty(const std::string& name)
   {
-	assertIsInitialized();
-	helpers::assertValidVariableName(name);
-	// Get variable from matlab
-	mxArray* mxArray = engGetVariable(_engine, name.c_str());
-	// Check if variable exists
-	if (mxArray==NULL) { std::cout<<"Variable "+name+" does not exist."<<std::endl; throw; }
-
-	return mxIsEmpty(mxArray) == 1;
+	return describeExisting(name).isEmpty();
   }
 
   bool Engine::isCharOrString(const std::string& name)
   {
-	assertIsInitialized();
-	helpers::assertValidVariableName(name);
-	// Get variable from matlab
-	mxArray* mxArray = engGetVariable(_engine, name.c_str());
-	// Check if variable exists
-	if (mxArray==NULL) { std::cout<<"Variable "+name+" does not exist."<<std::endl; throw; }
-
-	return mxIsChar(mxArray) == 1;
+	return describeExisting(name).isCharOrString();
   }
 
   bool Engine::getDimensions(const std::string& name, size_t& rows, size_t& cols)
   {
-	assertIsInitialized();
-	helpers::assertValidVariableName(name);
-	// Get variable from matlab
-	mxArray* mxArray = engGetVariable(_engine, name.c_str());
-	// Check if variable exists
-	if(!mxArray)
+	VariableInfo info = describe(name);
+	if (!info.exists)
 		return false;
 
-	rows = mxGetM(mxArray);
-	cols = mxGetN(mxArray);
+	rows = info.rows();
+	cols = info.cols();
 
 	return true;
   }
 
+std::vector<VariableInfo> Engine::describe(const std::vector<std::string>& names)
+{
+	assertIsInitialized();
+	for (size_t i=0; i<names.size(); i++)
+	{
+		helpers::assertValidVariableName(names[i]);
+	}
+	waitForAsync();
+
+	Statistics::Call call(_statistics, Statistics::DESCRIBE);
+	call.transport();
+	std::vector<VariableInfo> infos = _backend->describeVariables(names);
+	call.setSucceeded(true);
+	return infos;
+}
+
+VariableInfo Engine::describe(const std::string& name)
+{
+	return describe(std::vector<std::string>(1, name))[0];
+}
+
+VariableInfo Engine::describeExisting(const std::string& name)
+{
+	VariableInfo info = describe(name);
+	if (!info.exists) throw std::runtime_error("Variable " + name + " does not exist.");
+	return info;
+}
+
+// only dense real numeric arrays can be mapped with memmapfile
+static bool isSharedTransferable(const std::string& className, bool isComplex, bool isSparse)
+{
+	return !isComplex && !isSparse && SharedMemorySegment::numericClass(className) != mxUNKNOWN_CLASS;
+}
+
+bool Engine::transferPut(const std::string& name, const mxArray* value)
+{
+	size_t bytes = mxGetNumberOfElements(value) * mxGetElementSize(value);
+	if (_sharedMemoryThreshold == 0 || bytes < _sharedMemoryThreshold
+			|| !isSharedTransferable(mxGetClassName(value), mxIsComplex(value), mxIsSparse(value)))
+	{
+		return _backend->putVariable(name, value);
+	}
+
+	// falls back to the engine if the file cannot be created or mapped
+	SharedMemorySegment segment;
+	if (segment.create(_sharedMemoryDirectory, bytes))
+	{
+		memcpy(segment.data(), mxGetData(value), bytes);
+
+		SharedArrayDescriptor array;
+		array.file = segment.file();
+		array.className = mxGetClassName(value);
+		const mwSize* dims = mxGetDimensions(value);
+		array.dims.assign(dims, dims + mxGetNumberOfDimensions(value));
+		if (_backend->putVariableShared(name, array)) { return true; }
+	}
+	return _backend->putVariable(name, value);
+}
+
+bool Engine::transferPut(const std::string& name, const SharedMemorySegment& segment, const SharedArrayDescriptor& array)
+{
+	if (_backend->putVariableShared(name, array)) { return true; }
+
+	// the engine only gets a copy if the file could not be mapped on the other side
+	mxArray* value = mxCreateUninitNumericArray(array.dims.size(), array.dims.data(), SharedMemorySegment::numericClass(array.className), mxREAL);
+	memcpy(mxGetData(value), segment.data(), segment.size());
+	bool success = _backend->putVariable(name, value);
+	mxDestroyArray(value);
+	return success;
+}
+
+mxArray* Engine::transferGet(const std::string& name)
+{
+	if (_sharedMemoryThreshold == 0) { return _backend->getVariable(name); }
+
+	// the size decides, it is only known after asking the backend
+	VariableInfo info = _backend->describeVariables(std::vector<std::string>(1, name))[0];
+	if (!info.exists) { return NULL; }
+	if (info.bytes < _sharedMemoryThreshold || !isSharedTransferable(info.className, info.isComplex, info.isSparse))
+	{
+		return _backend->getVariable(name);
+	}
+
+	mxArray* value = mxCreateUninitNumericArray(info.dims.size(), info.dims.data(), SharedMemorySegment::numericClass(info.className), mxREAL);
+	size_t bytes = mxGetNumberOfElements(value) * mxGetElementSize(value);
+
+	SharedMemorySegment segment;
+	if (segment.create(_sharedMemoryDirectory, bytes))
+	{
+		SharedArrayDescriptor array;
+		array.file = segment.file();
+		array.className = info.className;
+		array.dims = info.dims;
+		if (_backend->getVariableShared(name, array))
+		{
+			memcpy(mxGetData(value), segment.data(), bytes);
+			return value;
+		}
+	}
+	mxDestroyArray(value);
+	return _backend->getVariable(name);
+}
+
 void Engine::assertIsInitialized() const
 {
-	if(_engine == NULL) throw std::runtime_error("Matlab Engine is not initialized");
+	if(!_backend->isOpen()) throw std::runtime_error("Matlab Engine is not initialized");
 }
 
 
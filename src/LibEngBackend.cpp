@@ -0,0 +1,371 @@
+/*
+ * LibEngBackend.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <matlabCppInterface/LibEngBackend.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <stdio.h>
+#include <thread>
+#include <unistd.h>
+
+namespace matlab {
+
+// workspace variable batches travel in
+static const std::string BATCH_VARIABLE = "matlabCppInterfaceBatch";
+
+// the result of whos for describeVariables
+static const std::string INFO_VARIABLE = "matlabCppInterfaceInfo";
+
+// the memmapfile of a shared memory transfer and whether it succeeded
+static const std::string MAP_VARIABLE = "matlabCppInterfaceMap";
+static const std::string TRANSFERRED_VARIABLE = "matlabCppInterfaceTransferred";
+
+// how often the diary is checked for new output while a command runs with an output callback
+static const std::chrono::milliseconds OUTPUT_POLL_INTERVAL(50);
+
+// the output buffer starts with this size and doubles whenever an output filled it
+static const size_t INITIAL_OUTPUT_BUFFER_SIZE = 1 << 16;
+
+
+LibEngBackend::LibEngBackend() :
+	_engine(NULL),
+	_unboundedOutput(false)
+{}
+
+LibEngBackend::~LibEngBackend()
+{
+	close();
+}
+
+bool LibEngBackend::open()
+{
+	if (_engine != NULL)
+		return true;
+
+	_engine = engOpen(NULL);
+
+	if (_engine != NULL)
+		setUpOutput();
+
+	return (_engine != NULL);
+}
+
+bool LibEngBackend::close()
+{
+	tearDownOutput();
+
+	bool success = true;
+	if (_engine != NULL)
+	{
+		success = (engClose(_engine) == 0);
+		_engine = NULL;
+	}
+	return success;
+}
+
+bool LibEngBackend::evaluate(const std::string& command, std::string* output, const OutputCallback& callback)
+{
+	if (output == NULL && !callback)
+	{
+		return engEvalString(_engine, command.c_str()) == 0;
+	}
+
+	std::string discarded;
+	std::string& captured = (output != NULL) ? *output : discarded;
+	if (_unboundedOutput || callback)
+	{
+		return evaluateLogged(command, captured, callback);
+	}
+	return evaluateBuffered(command, captured);
+}
+
+bool LibEngBackend::evaluateBuffered(const std::string& command, std::string& output)
+{
+	// the buffer is only registered while the command runs, so other evaluations are not slowed down by it
+	_outputBuffer[0] = '\0';
+	engOutputBuffer(_engine, &_outputBuffer[0], static_cast<int>(_outputBuffer.size() - 1));
+	int success = engEvalString(_engine, command.c_str());
+	engOutputBuffer(_engine, NULL, 0);
+
+	// the prompt is dropped, the output is the same as the one of the diary
+	const char* text = &_outputBuffer[0];
+	size_t length = strlen(text);
+	bool full = (length >= _outputBuffer.size() - 1);
+	if (strncmp(text, ">> ", 3) == 0)
+	{
+		text += 3;
+		length -= 3;
+	}
+	output.append(text, length);
+
+	// this output was cut, the next commands get a larger buffer
+	if (full) { _outputBuffer.resize(2*_outputBuffer.size(), '\0'); }
+
+	return success == 0;
+}
+
+bool LibEngBackend::evaluateLogged(const std::string& command, std::string& output, const OutputCallback& callback)
+{
+	if (_diaryFile.empty())
+	{
+		char name[] = "/tmp/matlabCppInterfaceOutputXXXXXX";
+		int fd = mkstemp(name);
+		if (fd < 0) throw std::runtime_error("Could not create a file for the Matlab output");
+		::close(fd);
+		_diaryFile = name;
+	}
+
+	// Matlab appends to the diary, start from an empty file
+	FILE* diary = fopen(_diaryFile.c_str(), "w+");
+	if (diary == NULL) throw std::runtime_error("Could not open the output file " + _diaryFile);
+
+	// errors are reported in the output like on the command line, the diary has to be switched off in any case
+	std::string logged = "diary('" + _diaryFile + "');\n"
+			"try\n" + command + "\n"
+			"catch matlabCppInterfaceError\n"
+			"disp(getReport(matlabCppInterfaceError)); clear matlabCppInterfaceError;\n"
+			"end\n"
+			"diary off;";
+
+	int success;
+	size_t offset = 0;
+	if (callback)
+	{
+		// stream the output while the command runs
+		std::atomic<bool> done(false);
+		std::thread poller([&]()
+		{
+			std::string piece;
+			while (!done)
+			{
+				std::this_thread::sleep_for(OUTPUT_POLL_INTERVAL);
+				piece.clear();
+				offset = readDiary(diary, offset, piece);
+				if (!piece.empty()) { output += piece; callback(piece); }
+			}
+		});
+		success = engEvalString(_engine, logged.c_str());
+		done = true;
+		poller.join();
+
+		std::string piece;
+		offset = readDiary(diary, offset, piece);
+		if (!piece.empty()) { output += piece; callback(piece); }
+	} else
+	{
+		success = engEvalString(_engine, logged.c_str());
+		offset = readDiary(diary, offset, output);
+	}
+	fclose(diary);
+
+	return success == 0;
+}
+
+bool LibEngBackend::putVariable(const std::string& name, const mxArray* value)
+{
+	return engPutVariable(_engine, name.c_str(), value) == 0;
+}
+
+mxArray* LibEngBackend::getVariable(const std::string& name)
+{
+	return engGetVariable(_engine, name.c_str());
+}
+
+// maps the file as a single record of the array, its data is MAP_VARIABLE.Data.x
+static std::string mapCommand(const SharedArrayDescriptor& array, bool writable)
+{
+	std::string dims;
+	for (size_t i=0; i<array.dims.size(); i++)
+	{
+		dims += (i > 0 ? " " : "") + std::to_string(array.dims[i]);
+	}
+	return MAP_VARIABLE + " = memmapfile('" + array.file + "', 'Format', {'" + array.className + "', [" + dims + "], 'x'}, "
+			"'Repeat', 1, 'Writable', " + (writable ? "true" : "false") + ");\n";
+}
+
+bool LibEngBackend::putVariableShared(const std::string& name, const SharedArrayDescriptor& array)
+{
+	// reading Data copies the array out of the file
+	return evaluateTransfer(mapCommand(array, false) + name + " = " + MAP_VARIABLE + ".Data.x;");
+}
+
+bool LibEngBackend::getVariableShared(const std::string& name, const SharedArrayDescriptor& array)
+{
+	// fails if the variable does not have the class and size of the file
+	return evaluateTransfer(mapCommand(array, true) + MAP_VARIABLE + ".Data.x = " + name + ";");
+}
+
+bool LibEngBackend::evaluateTransfer(const std::string& command)
+{
+	// engEvalString only fails if the session does, errors of the command are caught in Matlab
+	std::string checked = "try\n" + command + "\n"
+			+ TRANSFERRED_VARIABLE + " = true;\n"
+			"catch\n"
+			+ TRANSFERRED_VARIABLE + " = false;\n"
+			"end\n"
+			"clear " + MAP_VARIABLE + ";";
+	if (engEvalString(_engine, checked.c_str()) != 0) { return false; }
+
+	mxArray* transferred = engGetVariable(_engine, TRANSFERRED_VARIABLE.c_str());
+	engEvalString(_engine, ("clear " + TRANSFERRED_VARIABLE + ";").c_str());
+	if (transferred == NULL) { return false; }
+
+	bool success = mxIsLogicalScalarTrue(transferred);
+	mxDestroyArray(transferred);
+	return success;
+}
+
+bool LibEngBackend::putVariables(const std::vector<std::string>& names, const std::vector<mxArray*>& values)
+{
+	if (names.empty()) { return true; }
+
+	// the values become fields of one struct
+	mxArray* transfer = mxCreateStructMatrix(1, 1, 0, NULL);
+	std::string unpack;
+	for (size_t i=0; i<names.size(); i++)
+	{
+		int field = mxAddField(transfer, names[i].c_str());
+		mxSetFieldByNumber(transfer, 0, field, values[i]);
+		unpack += names[i] + " = " + BATCH_VARIABLE + "." + names[i] + "; ";
+	}
+	unpack += "clear " + BATCH_VARIABLE + ";";
+
+	bool success = (engPutVariable(_engine, BATCH_VARIABLE.c_str(), transfer) == 0)
+			&& (engEvalString(_engine, unpack.c_str()) == 0);
+	mxDestroyArray(transfer);
+
+	return success;
+}
+
+std::vector<mxArray*> LibEngBackend::getVariables(const std::vector<std::string>& names)
+{
+	std::vector<mxArray*> values(names.size(), NULL);
+	if (names.empty()) { return values; }
+
+	// collect all existing variables into one struct
+	std::string pack = BATCH_VARIABLE + " = struct(); ";
+	for (size_t i=0; i<names.size(); i++)
+	{
+		pack += "if exist('" + names[i] + "', 'var'), " + BATCH_VARIABLE + "." + names[i] + " = " + names[i] + "; end; ";
+	}
+	if (engEvalString(_engine, pack.c_str()) != 0) { return values; }
+
+	mxArray* transfer = engGetVariable(_engine, BATCH_VARIABLE.c_str());
+	engEvalString(_engine, ("clear " + BATCH_VARIABLE + ";").c_str());
+	if (transfer == NULL) { return values; }
+
+	// the fields are handed out, only the struct itself is destroyed
+	for (size_t i=0; i<names.size(); i++)
+	{
+		int field = mxGetFieldNumber(transfer, names[i].c_str());
+		if (field < 0) { continue; }
+
+		values[i] = mxGetFieldByNumber(transfer, 0, field);
+		mxSetFieldByNumber(transfer, 0, field, NULL);
+	}
+	mxDestroyArray(transfer);
+
+	return values;
+}
+
+static std::string stringField(const mxArray* structArray, size_t i, const char* field)
+{
+	const mxArray* value = mxGetField(structArray, i, field);
+	if (value == NULL || !mxIsChar(value)) { return ""; }
+
+	char* chars = mxArrayToString(value);
+	std::string text(chars != NULL ? chars : "");
+	mxFree(chars);
+	return text;
+}
+
+static double scalarField(const mxArray* structArray, size_t i, const char* field)
+{
+	const mxArray* value = mxGetField(structArray, i, field);
+	return (value != NULL && !mxIsEmpty(value)) ? mxGetScalar(value) : 0.0;
+}
+
+std::vector<VariableInfo> LibEngBackend::describeVariables(const std::vector<std::string>& names)
+{
+	std::vector<VariableInfo> infos(names.size());
+	for (size_t i=0; i<names.size(); i++) { infos[i].name = names[i]; }
+	if (names.empty()) { return infos; }
+
+	// whos lists only the variables that exist, a few hundred bytes per variable
+	std::string query = INFO_VARIABLE + " = whos(";
+	for (size_t i=0; i<names.size(); i++)
+	{
+		query += (i > 0 ? ", '" : "'") + names[i] + "'";
+	}
+	query += ");";
+	if (engEvalString(_engine, query.c_str()) != 0) { return infos; }
+
+	mxArray* whos = engGetVariable(_engine, INFO_VARIABLE.c_str());
+	engEvalString(_engine, ("clear " + INFO_VARIABLE + ";").c_str());
+	if (whos == NULL) { return infos; }
+
+	for (size_t k=0; k<mxGetNumberOfElements(whos); k++)
+	{
+		std::string name = stringField(whos, k, "name");
+		for (size_t i=0; i<names.size(); i++)
+		{
+			if (names[i] != name) { continue; }
+
+			VariableInfo& info = infos[i];
+			info.exists = true;
+			info.className = stringField(whos, k, "class");
+			const mxArray* size = mxGetField(whos, k, "size");
+			if (size != NULL && mxIsDouble(size))
+			{
+				const double* dims = mxGetPr(size);
+				for (size_t d=0; d<mxGetNumberOfElements(size); d++) { info.dims.push_back(static_cast<size_t>(dims[d])); }
+			}
+			info.bytes = static_cast<uint64_t>(scalarField(whos, k, "bytes"));
+			info.isComplex = scalarField(whos, k, "complex") != 0.0;
+			info.isSparse = scalarField(whos, k, "sparse") != 0.0;
+			info.isGlobal = scalarField(whos, k, "global") != 0.0;
+		}
+	}
+	mxDestroyArray(whos);
+
+	return infos;
+}
+
+size_t LibEngBackend::readDiary(FILE* diary, size_t offset, std::string& output)
+{
+	if (fseek(diary, 0, SEEK_END) != 0) { return offset; }
+	long size = ftell(diary);
+	if (size <= static_cast<long>(offset)) { return offset; }
+
+	// read into the existing storage of output
+	size_t previousSize = output.size();
+	output.resize(previousSize + (size - offset));
+	fseek(diary, offset, SEEK_SET);
+	size_t read = fread(&output[previousSize], 1, size - offset, diary);
+	output.resize(previousSize + read);
+
+	return offset + read;
+}
+
+void LibEngBackend::setUpOutput()
+{
+	// Matlab only writes output while a buffer is registered
+	engOutputBuffer(_engine, NULL, 0);
+	_outputBuffer.assign(INITIAL_OUTPUT_BUFFER_SIZE, '\0');
+}
+
+void LibEngBackend::tearDownOutput()
+{
+	if (!_diaryFile.empty())
+	{
+		unlink(_diaryFile.c_str());
+		_diaryFile.clear();
+	}
+}
+
+} // namespace matlab
@@ -0,0 +1,744 @@
+/*
+ * LoopbackBackend.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <matlabCppInterface/LoopbackBackend.hpp>
+#include <matlabCppInterface/internal/MxClassTraits.hpp>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <Eigen/Core>
+
+namespace matlab {
+
+namespace {
+
+typedef std::shared_ptr<mxArray> Value;
+
+Value makeValue(mxArray* array)
+{
+	return Value(array, mxDestroyArray);
+}
+
+Eigen::MatrixXd toMatrix(const Value& value)
+{
+	if (!value) throw std::runtime_error("The expression does not return a value.");
+	if (!mxIsNumeric(value.get()) && !mxIsLogical(value.get())) throw std::runtime_error("Only numeric values are supported in expressions.");
+	if (mxIsComplex(value.get())) throw std::runtime_error("Complex values are not supported in expressions.");
+	if (mxGetNumberOfDimensions(value.get()) > 2) throw std::runtime_error("Only matrices are supported in expressions.");
+
+	Eigen::MatrixXd matrix(mxGetM(value.get()), mxGetN(value.get()));
+	copyFromMxArray(value.get(), 0, matrix.size(), matrix.data());
+	return matrix;
+}
+
+Value fromMatrix(const Eigen::MatrixXd& matrix)
+{
+	mxArray* array = mxCreateDoubleMatrix(matrix.rows(), matrix.cols(), mxREAL);
+	if (matrix.size() > 0) { memcpy(mxGetPr(array), matrix.data(), matrix.size()*sizeof(double)); }
+	return makeValue(array);
+}
+
+Value fromScalar(double value)
+{
+	return makeValue(mxCreateDoubleScalar(value));
+}
+
+double toScalar(const Value& value, const std::string& what)
+{
+	Eigen::MatrixXd matrix = toMatrix(value);
+	if (matrix.size() != 1) throw std::runtime_error(what + " must be a scalar.");
+	return matrix(0);
+}
+
+size_t toSize(const Value& value, const std::string& what)
+{
+	double size = toScalar(value, what);
+	if (size < 0.0 || size != std::floor(size)) throw std::runtime_error(what + " must be a non-negative integer.");
+	return static_cast<size_t>(size);
+}
+
+// applies operation element by element, a scalar operand is expanded to the size of the other one
+template <typename Operation>
+Value elementwise(const Value& left, const Value& right, Operation operation)
+{
+	Eigen::MatrixXd a = toMatrix(left);
+	Eigen::MatrixXd b = toMatrix(right);
+
+	bool expandA = (a.size() == 1 && b.size() != 1);
+	bool expandB = (b.size() == 1 && a.size() != 1);
+	if (!expandA && !expandB && (a.rows() != b.rows() || a.cols() != b.cols())) throw std::runtime_error("Matrix dimensions must agree.");
+
+	// the result is written straight into the new array
+	Eigen::Index rows = expandA ? b.rows() : a.rows();
+	Eigen::Index cols = expandA ? b.cols() : a.cols();
+	Value result = makeValue(mxCreateDoubleMatrix(rows, cols, mxREAL));
+	double* data = mxGetPr(result.get());
+	for (Eigen::Index i=0; i<rows*cols; i++)
+	{
+		data[i] = operation(expandA ? a(0) : a(i), expandB ? b(0) : b(i));
+	}
+	return result;
+}
+
+double add(double a, double b) { return a + b; }
+double subtract(double a, double b) { return a - b; }
+double multiply(double a, double b) { return a * b; }
+double divide(double a, double b) { return a / b; }
+double power(double a, double b) { return std::pow(a, b); }
+
+enum TokenType { NUMBER, NAME, STRING, OPERATOR, SEPARATOR, END };
+
+struct Token
+{
+	Token() : type(END), number(0.0), spaceBefore(false) {}
+
+	TokenType type;
+	std::string text;
+	double number;
+	bool spaceBefore; // matters in matrix literals, [1 -2] has two elements
+};
+
+std::vector<Token> tokenize(const std::string& command)
+{
+	std::vector<Token> tokens;
+	bool space = false;
+	size_t i = 0;
+	while (i < command.size())
+	{
+		char c = command[i];
+		if (c == ' ' || c == '\t' || c == '\r') { space = true; i++; continue; }
+		if (c == '%') { while (i < command.size() && command[i] != '\n') { i++; } continue; }
+
+		Token token;
+		token.spaceBefore = space;
+		space = false;
+
+		// a quote right after a value is a transpose, otherwise it starts a string
+		bool afterValue = !tokens.empty() && !token.spaceBefore
+				&& (tokens.back().type == NUMBER || tokens.back().type == NAME || tokens.back().type == STRING
+						|| tokens.back().text == ")" || tokens.back().text == "]" || tokens.back().text == "'" || tokens.back().text == ".'");
+
+		if (isdigit(c) || (c == '.' && i+1 < command.size() && isdigit(command[i+1])))
+		{
+			const char* begin = command.c_str() + i;
+			char* end;
+			token.number = strtod(begin, &end);
+			// 2.*x is 2 .* x
+			if (end[-1] == '.' && (end[0] == '*' || end[0] == '/' || end[0] == '^' || end[0] == '\'')) { end--; }
+			token.type = NUMBER;
+			token.text.assign(begin, static_cast<const char*>(end));
+			i += end - begin;
+		} else if (isalpha(c))
+		{
+			size_t begin = i;
+			while (i < command.size() && (isalnum(command[i]) || command[i] == '_')) { i++; }
+			token.type = NAME;
+			token.text = command.substr(begin, i - begin);
+		} else if (c == '\'' && !afterValue)
+		{
+			token.type = STRING;
+			i++;
+			while (true)
+			{
+				if (i >= command.size() || command[i] == '\n') throw std::runtime_error("A string is not terminated.");
+				if (command[i] == '\'')
+				{
+					// '' is a quote inside the string
+					if (i+1 < command.size() && command[i+1] == '\'') { token.text += '\''; i += 2; continue; }
+					i++;
+					break;
+				}
+				token.text += command[i++];
+			}
+		} else if (c == ',' || c == ';' || c == '\n')
+		{
+			token.type = SEPARATOR;
+			token.text = c;
+			i++;
+		} else
+		{
+			token.type = OPERATOR;
+			if (c == '.' && i+1 < command.size() && (command[i+1] == '*' || command[i+1] == '/' || command[i+1] == '^' || command[i+1] == '\''))
+			{
+				token.text = command.substr(i, 2);
+				i += 2;
+			} else if (std::string("+-*/^'()[]=").find(c) != std::string::npos)
+			{
+				if (c == '=' && i+1 < command.size() && command[i+1] == '=') throw std::runtime_error("Comparisons are not supported.");
+				token.text = c;
+				i++;
+			} else
+			{
+				throw std::runtime_error(std::string("Unsupported character '") + c + "'.");
+			}
+		}
+		tokens.push_back(token);
+	}
+
+	Token end;
+	end.spaceBefore = space;
+	tokens.push_back(end);
+	return tokens;
+}
+
+// evaluates the statements of one command against the workspace
+class Evaluator
+{
+public:
+	Evaluator(LoopbackBackend::Workspace& workspace, std::string& output) :
+		_workspace(workspace), _output(output), _position(0), _inMatrix(false)
+	{}
+
+	void run(const std::string& command)
+	{
+		_tokens = tokenize(command);
+		_position = 0;
+		while (peek().type != END)
+		{
+			statement();
+		}
+	}
+
+private:
+	const Token& peek(size_t ahead = 0) const
+	{
+		return _tokens[std::min(_position + ahead, _tokens.size() - 1)];
+	}
+
+	const Token& next()
+	{
+		const Token& token = peek();
+		if (_position < _tokens.size() - 1) { _position++; }
+		return token;
+	}
+
+	bool isOperator(const Token& token, const char* text) const
+	{
+		return token.type == OPERATOR && token.text == text;
+	}
+
+	void expect(const char* text)
+	{
+		if (!isOperator(peek(), text)) throw std::runtime_error(std::string("Expected '") + text + "'.");
+		next();
+	}
+
+	void statement()
+	{
+		if (peek().type == SEPARATOR) { next(); return; }
+
+		if (peek().type == NAME && peek().text == "clear" && (peek(1).type == END || peek(1).type == SEPARATOR || (peek(1).type == NAME && peek(1).spaceBefore)))
+		{
+			next();
+			clear();
+			return;
+		}
+
+		std::string target = "ans";
+		bool assignment = false;
+		if (peek().type == NAME && isOperator(peek(1), "="))
+		{
+			target = next().text;
+			next();
+			assignment = true;
+		} else if (peek().type == NAME && (peek(1).type == END || peek(1).type == SEPARATOR) && _workspace.count(peek().text) > 0)
+		{
+			// a variable on its own is displayed under its name, ans is not changed
+			target = peek().text;
+		}
+
+		Value value = expression();
+
+		if (peek().type != END && peek().type != SEPARATOR) throw std::runtime_error("Unexpected '" + peek().text + "'.");
+		bool show = !(peek().type == SEPARATOR && peek().text == ";");
+		next();
+
+		if (!value)
+		{
+			if (assignment) throw std::runtime_error("Too many output arguments.");
+			return;
+		}
+
+		_workspace[target] = value;
+		if (show) { display(target, value.get()); }
+	}
+
+	void clear()
+	{
+		if (peek().type != NAME)
+		{
+			_workspace.clear();
+		}
+		while (peek().type == NAME)
+		{
+			_workspace.erase(next().text);
+		}
+	}
+
+	Value expression()
+	{
+		Value value = term();
+		while (isOperator(peek(), "+") || isOperator(peek(), "-"))
+		{
+			// in a matrix, "a -b" are two elements but "a - b" and "a-b" are a difference
+			if (_inMatrix && peek().spaceBefore && !peek(1).spaceBefore) { break; }
+
+			bool plus = next().text == "+";
+			value = elementwise(value, term(), plus ? add : subtract);
+		}
+		return value;
+	}
+
+	Value term()
+	{
+		Value value = unary();
+		while (true)
+		{
+			if (isOperator(peek(), "*"))
+			{
+				next();
+				Value right = unary();
+				Eigen::MatrixXd a = toMatrix(value);
+				Eigen::MatrixXd b = toMatrix(right);
+				if (a.size() == 1 || b.size() == 1) { value = elementwise(value, right, multiply); continue; }
+				if (a.cols() != b.rows()) throw std::runtime_error("Inner matrix dimensions must agree.");
+				value = fromMatrix(a * b);
+			} else if (isOperator(peek(), "/"))
+			{
+				next();
+				Value right = unary();
+				if (toMatrix(right).size() != 1) throw std::runtime_error("Only division by scalars is supported.");
+				value = elementwise(value, right, divide);
+			} else if (isOperator(peek(), ".*"))
+			{
+				next();
+				value = elementwise(value, unary(), multiply);
+			} else if (isOperator(peek(), "./"))
+			{
+				next();
+				value = elementwise(value, unary(), divide);
+			} else
+			{
+				return value;
+			}
+		}
+	}
+
+	Value unary()
+	{
+		if (isOperator(peek(), "-")) { next(); return elementwise(fromScalar(0.0), unary(), subtract); }
+		if (isOperator(peek(), "+")) { next(); return fromMatrix(toMatrix(unary())); }
+		return power();
+	}
+
+	// binds stronger than unary minus, -2^2 is -4, but 2^-1 is allowed
+	Value power()
+	{
+		Value value = postfix();
+		while (isOperator(peek(), "^") || isOperator(peek(), ".^"))
+		{
+			bool matrixPower = next().text == "^";
+
+			Value exponent;
+			if (isOperator(peek(), "-")) { next(); exponent = elementwise(fromScalar(0.0), postfix(), subtract); }
+			else if (isOperator(peek(), "+")) { next(); exponent = postfix(); }
+			else { exponent = postfix(); }
+
+			if (matrixPower && (toMatrix(value).size() != 1 || toMatrix(exponent).size() != 1)) throw std::runtime_error("Only scalars are supported by ^, use .^ for matrices.");
+			value = elementwise(value, exponent, matlab::power);
+		}
+		return value;
+	}
+
+	Value postfix()
+	{
+		Value value = primary();
+		while (isOperator(peek(), "'") || isOperator(peek(), ".'"))
+		{
+			next();
+			Eigen::MatrixXd transposed = toMatrix(value).transpose();
+			value = fromMatrix(transposed);
+		}
+		return value;
+	}
+
+	Value primary()
+	{
+		Token token = next();
+		switch (token.type)
+		{
+			case NUMBER: return fromScalar(token.number);
+			case STRING: return makeValue(mxCreateString(token.text.c_str()));
+			case NAME:
+			{
+				// in a matrix, "a (1)" are two elements
+				if (isOperator(peek(), "(") && !(_inMatrix && peek().spaceBefore))
+				{
+					next();
+					std::vector<Value> arguments = argumentList();
+					LoopbackBackend::Workspace::iterator variable = _workspace.find(token.text);
+					if (variable != _workspace.end()) { return index(variable->second, arguments); }
+					return call(token.text, arguments);
+				}
+				LoopbackBackend::Workspace::iterator variable = _workspace.find(token.text);
+				if (variable != _workspace.end()) { return variable->second; }
+				return call(token.text, std::vector<Value>());
+			}
+			case OPERATOR:
+			{
+				if (token.text == "(")
+				{
+					bool inMatrix = _inMatrix;
+					_inMatrix = false;
+					Value value = expression();
+					expect(")");
+					_inMatrix = inMatrix;
+					return value;
+				}
+				if (token.text == "[") { return matrix(); }
+				break;
+			}
+			default: break;
+		}
+		throw std::runtime_error(token.type == END ? "The expression is incomplete." : "Unexpected '" + token.text + "'.");
+	}
+
+	std::vector<Value> argumentList()
+	{
+		bool inMatrix = _inMatrix;
+		_inMatrix = false;
+
+		std::vector<Value> arguments;
+		if (isOperator(peek(), ")")) { next(); _inMatrix = inMatrix; return arguments; }
+		while (true)
+		{
+			arguments.push_back(expression());
+			if (peek().type == SEPARATOR && peek().text == ",") { next(); continue; }
+			expect(")");
+			break;
+		}
+
+		_inMatrix = inMatrix;
+		return arguments;
+	}
+
+	// after the opening bracket
+	Value matrix()
+	{
+		bool inMatrix = _inMatrix;
+		_inMatrix = true;
+
+		std::vector<std::vector<Eigen::MatrixXd> > rows(1);
+		while (true)
+		{
+			const Token& token = peek();
+			if (isOperator(token, "]")) { next(); break; }
+			if (token.type == END) throw std::runtime_error("A matrix is not terminated.");
+			if (token.type == SEPARATOR)
+			{
+				next();
+				if (token.text != "," && !rows.back().empty()) { rows.push_back(std::vector<Eigen::MatrixXd>()); }
+				continue;
+			}
+			rows.back().push_back(toMatrix(expression()));
+		}
+		_inMatrix = inMatrix;
+
+		// concatenate each row horizontally, then the rows vertically; empty parts are skipped
+		std::vector<Eigen::MatrixXd> blocks;
+		for (size_t r=0; r<rows.size(); r++)
+		{
+			Eigen::Index nRows = -1, nCols = 0;
+			for (size_t c=0; c<rows[r].size(); c++)
+			{
+				if (rows[r][c].size() == 0) { continue; }
+				if (nRows >= 0 && rows[r][c].rows() != nRows) throw std::runtime_error("Dimensions of arrays being concatenated are not consistent.");
+				nRows = rows[r][c].rows();
+				nCols += rows[r][c].cols();
+			}
+			if (nRows < 0) { continue; }
+
+			Eigen::MatrixXd block(nRows, nCols);
+			Eigen::Index col = 0;
+			for (size_t c=0; c<rows[r].size(); c++)
+			{
+				if (rows[r][c].size() == 0) { continue; }
+				block.middleCols(col, rows[r][c].cols()) = rows[r][c];
+				col += rows[r][c].cols();
+			}
+			blocks.push_back(block);
+		}
+
+		Eigen::Index nRows = 0, nCols = blocks.empty() ? 0 : blocks[0].cols();
+		for (size_t b=0; b<blocks.size(); b++)
+		{
+			if (blocks[b].cols() != nCols) throw std::runtime_error("Dimensions of arrays being concatenated are not consistent.");
+			nRows += blocks[b].rows();
+		}
+		Eigen::MatrixXd result(nRows, nCols);
+		Eigen::Index row = 0;
+		for (size_t b=0; b<blocks.size(); b++)
+		{
+			result.middleRows(row, blocks[b].rows()) = blocks[b];
+			row += blocks[b].rows();
+		}
+		return fromMatrix(result);
+	}
+
+	// one-based indices, x(i) keeps the orientation of vectors, x(i, j) selects rows and columns
+	Value index(const Value& value, const std::vector<Value>& arguments)
+	{
+		Eigen::MatrixXd matrix = toMatrix(value);
+		if (arguments.size() == 1)
+		{
+			Eigen::MatrixXd indices = toMatrix(arguments[0]);
+			Eigen::MatrixXd result(indices.rows(), indices.cols());
+			if (matrix.rows() == 1) { result.resize(1, indices.size()); }
+			else if (matrix.cols() == 1) { result.resize(indices.size(), 1); }
+			for (Eigen::Index i=0; i<indices.size(); i++)
+			{
+				result(i) = matrix(checkedIndex(indices(i), matrix.size()));
+			}
+			return fromMatrix(result);
+		}
+		if (arguments.size() == 2)
+		{
+			Eigen::MatrixXd rows = toMatrix(arguments[0]);
+			Eigen::MatrixXd cols = toMatrix(arguments[1]);
+			Eigen::MatrixXd result(rows.size(), cols.size());
+			for (Eigen::Index j=0; j<cols.size(); j++)
+			{
+				for (Eigen::Index i=0; i<rows.size(); i++)
+				{
+					result(i, j) = matrix(checkedIndex(rows(i), matrix.rows()), checkedIndex(cols(j), matrix.cols()));
+				}
+			}
+			return fromMatrix(result);
+		}
+		throw std::runtime_error("Only one or two indices are supported.");
+	}
+
+	Eigen::Index checkedIndex(double index, Eigen::Index size)
+	{
+		if (index != std::floor(index) || index < 1.0) throw std::runtime_error("Array indices must be positive integers.");
+		if (index > size) throw std::runtime_error("Index exceeds array bounds.");
+		return static_cast<Eigen::Index>(index) - 1;
+	}
+
+	Value call(const std::string& name, const std::vector<Value>& arguments)
+	{
+		if (arguments.empty())
+		{
+			if (name == "pi") { return fromScalar(3.14159265358979323846); }
+			if (name == "Inf" || name == "inf") { return fromScalar(std::numeric_limits<double>::infinity()); }
+			if (name == "NaN" || name == "nan") { return fromScalar(std::numeric_limits<double>::quiet_NaN()); }
+		}
+
+		if (name == "zeros" || name == "ones" || name == "eye")
+		{
+			if (arguments.size() > 2) throw std::runtime_error("Too many input arguments.");
+			size_t rows = arguments.empty() ? 1 : toSize(arguments[0], "The size");
+			size_t cols = arguments.size() < 2 ? rows : toSize(arguments[1], "The size");
+			if (name == "zeros") { return fromMatrix(Eigen::MatrixXd::Zero(rows, cols)); }
+			if (name == "ones") { return fromMatrix(Eigen::MatrixXd::Ones(rows, cols)); }
+			return fromMatrix(Eigen::MatrixXd::Identity(rows, cols));
+		}
+
+		if (name == "size" || name == "numel" || name == "disp")
+		{
+			if (arguments.size() != 1) throw std::runtime_error("Exactly one input argument is required.");
+			const mxArray* array = arguments[0].get();
+			if (array == NULL) throw std::runtime_error("The expression does not return a value.");
+
+			if (name == "numel") { return fromScalar(static_cast<double>(mxGetNumberOfElements(array))); }
+			if (name == "size")
+			{
+				Eigen::MatrixXd dims(1, mxGetNumberOfDimensions(array));
+				for (size_t i=0; i<mxGetNumberOfDimensions(array); i++) { dims(i) = static_cast<double>(mxGetDimensions(array)[i]); }
+				return fromMatrix(dims);
+			}
+			appendValue(array);
+			return Value();
+		}
+
+		throw std::runtime_error("Undefined function or variable '" + name + "'.");
+	}
+
+	void display(const std::string& name, const mxArray* array)
+	{
+		_output += name + " =\n\n";
+		if (mxIsChar(array))
+		{
+			_output += "    '";
+			appendValue(array);
+			_output.insert(_output.size() - 1, "'");
+		} else
+		{
+			appendValue(array);
+		}
+		_output += "\n";
+	}
+
+	// like disp
+	void appendValue(const mxArray* array)
+	{
+		if (mxIsChar(array))
+		{
+			char* text = mxArrayToString(array);
+			if (text != NULL) { _output += text; mxFree(text); }
+			_output += "\n";
+			return;
+		}
+		if (!mxIsNumeric(array) && !mxIsLogical(array))
+		{
+			_output += "  " + std::string(mxGetClassName(array)) + " array\n";
+			return;
+		}
+
+		Eigen::MatrixXd matrix = toMatrix(Value(const_cast<mxArray*>(array), [](mxArray*) {}));
+		char element[32];
+		for (Eigen::Index i=0; i<matrix.rows(); i++)
+		{
+			for (Eigen::Index j=0; j<matrix.cols(); j++)
+			{
+				snprintf(element, sizeof(element), "%10.5g", matrix(i, j));
+				_output += element;
+			}
+			_output += "\n";
+		}
+	}
+
+	LoopbackBackend::Workspace& _workspace;
+	std::string& _output;
+	std::vector<Token> _tokens;
+	size_t _position;
+	bool _inMatrix;
+};
+
+} // namespace
+
+
+LoopbackBackend::LoopbackBackend() :
+	_open(false)
+{}
+
+LoopbackBackend::~LoopbackBackend()
+{
+	close();
+}
+
+bool LoopbackBackend::open()
+{
+	_open = true;
+	return true;
+}
+
+bool LoopbackBackend::close()
+{
+	_workspace.clear();
+	_open = false;
+	return true;
+}
+
+bool LoopbackBackend::evaluate(const std::string& command, std::string* output, const OutputCallback& callback)
+{
+	if (!_open) { return false; }
+
+	std::string captured;
+	Evaluator evaluator(_workspace, captured);
+	try
+	{
+		evaluator.run(command);
+	}
+	catch (const std::runtime_error& error)
+	{
+		// reported like Matlab does, the statements before the error stay executed
+		captured += std::string("Error: ") + error.what() + "\n";
+	}
+
+	if (callback && !captured.empty()) { callback(captured); }
+	if (output != NULL) { *output += captured; }
+	return true;
+}
+
+bool LoopbackBackend::putVariable(const std::string& name, const mxArray* value)
+{
+	if (!_open || value == NULL) { return false; }
+
+	_workspace[name] = makeValue(mxDuplicateArray(value));
+	return true;
+}
+
+mxArray* LoopbackBackend::getVariable(const std::string& name)
+{
+	Workspace::iterator variable = _workspace.find(name);
+	if (!_open || variable == _workspace.end()) { return NULL; }
+
+	return mxDuplicateArray(variable->second.get());
+}
+
+bool LoopbackBackend::putVariableShared(const std::string& name, const SharedArrayDescriptor& array)
+{
+	mxClassID classId = SharedMemorySegment::numericClass(array.className);
+	if (!_open || classId == mxUNKNOWN_CLASS) { return false; }
+
+	Value value = makeValue(mxCreateUninitNumericArray(array.dims.size(), array.dims.data(), classId, mxREAL));
+	size_t bytes = mxGetNumberOfElements(value.get()) * mxGetElementSize(value.get());
+
+	// like memmapfile, the file has to hold the complete array
+	SharedMemorySegment segment;
+	if (!segment.open(array.file, bytes, false)) { return false; }
+	memcpy(mxGetData(value.get()), segment.data(), bytes);
+
+	_workspace[name] = value;
+	return true;
+}
+
+bool LoopbackBackend::getVariableShared(const std::string& name, const SharedArrayDescriptor& array)
+{
+	Workspace::iterator variable = _workspace.find(name);
+	if (!_open || variable == _workspace.end()) { return false; }
+
+	const mxArray* value = variable->second.get();
+	if (mxIsSparse(value) || mxIsComplex(value) || array.className != mxGetClassName(value)) { return false; }
+	const mwSize* dims = mxGetDimensions(value);
+	if (std::vector<size_t>(dims, dims + mxGetNumberOfDimensions(value)) != array.dims) { return false; }
+
+	size_t bytes = mxGetNumberOfElements(value) * mxGetElementSize(value);
+	SharedMemorySegment segment;
+	if (!segment.open(array.file, bytes, true)) { return false; }
+	memcpy(segment.data(), mxGetData(value), bytes);
+	return true;
+}
+
+bool LoopbackBackend::putVariables(const std::vector<std::string>& names, const std::vector<mxArray*>& values)
+{
+	for (size_t i=0; i<names.size(); i++)
+	{
+		if (!_open) { mxDestroyArray(values[i]); continue; }
+		_workspace[names[i]] = makeValue(values[i]);
+	}
+	return _open;
+}
+
+std::vector<VariableInfo> LoopbackBackend::describeVariables(const std::vector<std::string>& names)
+{
+	std::vector<VariableInfo> infos(names.size());
+	for (size_t i=0; i<names.size(); i++)
+	{
+		Workspace::iterator variable = _workspace.find(names[i]);
+		const mxArray* value = (_open && variable != _workspace.end()) ? variable->second.get() : NULL;
+		infos[i] = VariableInfo::describe(names[i], value);
+	}
+	return infos;
+}
+
+} // namespace matlab
@@ -5,6 +5,7 @@
  *      Author: neunertm
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include <matlabCppInterface/MatFile.hpp>
@@ -15,14 +16,18 @@ MatFile::MatFile() :
 	_file(NULL),
 	_isOpen(false),
 	_isWritable(true),
-	_isModifyable(false)
+	_isModifyable(false),
+	_numericStorage(STORE_AS_DOUBLE),
+	_compressionLevel(6)
 {};
 
 MatFile::MatFile(const std::string& filename, OPEN_MODE mode) :
 	_file(NULL),
 	_isOpen(false),
 	_isWritable(true),
-	_isModifyable(false)
+	_isModifyable(false),
+	_numericStorage(STORE_AS_DOUBLE),
+	_compressionLevel(6)
 {
 	open(filename, mode);
 }
@@ -32,12 +37,29 @@ MatFile::~MatFile()
 	close();
 }
 
+void MatFile::setNumericStorage(NUMERIC_STORAGE numericStorage)
+{
+	_numericStorage = numericStorage;
+	_nativeWriter.setNumericStorage(numericStorage);
+}
+
+void MatFile::setCompressionLevel(int level)
+{
+	_compressionLevel = std::min(std::max(level, 1), 9);
+
+	// an open WRITE_NATIVE_COMPRESSED file uses it from the next put on, WRITE_NATIVE stays uncompressed
+	if (_nativeWriter.isOpen() && _nativeWriter.getCompressionLevel() > 0)
+	{
+		_nativeWriter.setCompressionLevel(_compressionLevel);
+	}
+}
+
 // open a mat file
 // [in] string - filename
 // [in] ioFlag - either 'r' for read, 'w' for write or 'u' for update (read/write)
 bool MatFile::open(const std::string& filename, OPEN_MODE mode)
 {
-	if (_file) { std::cout<<"Warning, file already open, will close."<<std::endl; matClose(_file); }
+	if (_file || _nativeWriter.isOpen() || _mappedReader.isOpen()) { std::cout<<"Warning, file already open, will close."<<std::endl; close(); }
 
 	std::string ioflags = "";
 	_isWritable = true;
@@ -50,17 +72,45 @@ bool MatFile::open(const std::string& filename, OPEN_MODE mode)
 		case WRITE: { ioflags = "w"; break; }
 		case WRITE_COMPRESSED: { ioflags = "wz"; break; }
 		case WRITE_HDF5: { ioflags = "w7.3"; break; }
+		case WRITE_NATIVE: { break; }
+		case READ_MAPPED: { _isWritable = false; break; }
+		case WRITE_NATIVE_COMPRESSED: { break; }
 	}
 
+	Statistics::Call call(_statistics, Statistics::OPEN);
+	call.transport();
+
 	if (ioflags != "" && filename != "")
 	{
 		_file = matOpen(filename.c_str(), ioflags.c_str());
 	}
 
-	if (_file)
+	if ((mode == WRITE_NATIVE || mode == WRITE_NATIVE_COMPRESSED) && filename != "")
+	{
+		_nativeWriter.setCompressionLevel((mode == WRITE_NATIVE_COMPRESSED) ? _compressionLevel : 0);
+		_nativeWriter.open(filename);
+	}
+
+	if (mode == READ_MAPPED && filename != "" && _mappedReader.open(filename) && _mappedReader.hasCompressedVariables())
+	{
+		// compressed variables cannot be mapped, libmat reads them
+		_file = matOpen(filename.c_str(), "r");
+		if (!_file)
+		{
+			std::cout<<"Error, "<<filename<<" has compressed variables, they cannot be mapped and libmat could not open the file."<<std::endl;
+			_mappedReader.close();
+		}
+	}
+
+	if (_file || _nativeWriter.isOpen() || _mappedReader.isOpen())
 	{
 		_filename = filename;
 		_isOpen = true;
+
+		// written files start empty
+		_directory.clear();
+		if (mode == READ || mode == UPDATE || mode == READ_MAPPED) { indexVariables(filename); }
+		call.setSucceeded(true);
 		return true;
 	}
 
@@ -71,14 +121,40 @@ bool MatFile::open(const std::string& filename, OPEN_MODE mode)
 bool MatFile::close()
 {
 	_isWritable = false;
-	if (_file)
+	_directory.clear();
+	if (!_nativeWriter.isOpen() && !_mappedReader.isOpen() && !_file) { return false; }
+
+	Statistics::Call call(_statistics, Statistics::CLOSE);
+	call.transport();
+
+	if (_nativeWriter.isOpen())
+	{
+		// appended variables are completed here
+		_isOpen = false;
+		uint64_t bytesWritten = _nativeWriter.bytesWritten();
+		bool success = _nativeWriter.close();
+		call.addBytes(_nativeWriter.bytesWritten() - bytesWritten);
+		call.setSucceeded(success);
+		return success;
+	}
+	if (_mappedReader.isOpen())
 	{
-		if (matClose(_file) == 0)
+		_isOpen = false;
+		bool success = _mappedReader.close();
+		if (_file)
 		{
-			_isOpen = false;
+			success = (matClose(_file) == 0) && success;
 			_file = NULL;
-			return true;
 		}
+		call.setSucceeded(success);
+		return success;
+	}
+	if (matClose(_file) == 0)
+	{
+		_isOpen = false;
+		_file = NULL;
+		call.setSucceeded(true);
+		return true;
 	}
 	return false;
 }
@@ -90,29 +166,77 @@ bool MatFile::deleteVariable(const std::string& name)
 
 	if (matDeleteVariable(_file, name.c_str()) == 0)
 	{
+		// libmat rewrites the file, the following variables move
+		_directory.erase(name);
+		_directory.invalidateOffsets();
 		return true;
 	}
 	return false;
 }
 
+bool MatFile::getMap(const std::string& name, Eigen::Map<const Eigen::MatrixXd>& view)
+{
+	if (!_isOpen || !_mappedReader.isOpen()) { return false; }
+	helpers::assertValidVariableName(name);
+
+	Statistics::Call call(_statistics, Statistics::GET);
+	bool success = _mappedReader.map(name, view);
+	if (call.isEnabled()) { call.addBytes(mappedBytes(name)); }
+	call.setSucceeded(success);
+	return success;
+}
+
+uint64_t MatFile::mappedBytes(const std::string& name) const
+{
+	const MatV5Reader::Variable* variable = _mappedReader.find(name);
+	return variable != NULL ? variable->dataBytes : 0;
+}
+
+void MatFile::indexVariables(const std::string& filename)
+{
+	if (_directory.build(filename) || !_file) { return; }
+
+	// e.g. v7.3 files, libmat reads one header after the other
+	const char* name = NULL;
+	mxArray* info = NULL;
+	while ((info = matGetNextVariableInfo(_file, &name)) != NULL)
+	{
+		indexVariable(name, info, mxIsFromGlobalWS(info));
+		mxDestroyArray(info);
+	}
+}
+
+void MatFile::indexVariable(const std::string& name, const mxArray* array, bool globalVariable)
+{
+	MatV5Directory::Entry entry;
+	entry.name = name;
+
+	// the classes of libmat and the file format match, except for logical and sparse arrays
+	mxClassID classId = mxGetClassID(array);
+	entry.arrayClass = (classId > mxUINT64_CLASS) ? static_cast<uint8_t>(matv5::mxOBJECT) : static_cast<uint8_t>(classId);
+	if (mxIsLogical(array)) { entry.arrayClass = matv5::mxUINT8; entry.flags |= matv5::FLAG_LOGICAL; }
+	if (mxIsSparse(array)) { entry.arrayClass = matv5::mxSPARSE; }
+	if (mxIsComplex(array)) { entry.flags |= matv5::FLAG_COMPLEX; }
+	if (globalVariable) { entry.flags |= matv5::FLAG_GLOBAL; }
+
+	const mwSize* dims = mxGetDimensions(array);
+	entry.dims.assign(dims, dims + mxGetNumberOfDimensions(array));
+
+	// libmat decides where the variable goes, a replaced variable moves the following ones
+	if (_directory.find(name) != NULL) { _directory.invalidateOffsets(); }
+	_directory.insert(entry);
+}
+
 bool MatFile::getVariableList(std::vector<std::string>& variableList)
 {
-	if (!_isOpen) { return false; }
+	if (!_isOpen || _nativeWriter.isOpen()) { return false; }
 
 	variableList.clear();
-
-	int nVariables = 0;
-	char** dir = matGetDir(_file, &nVariables);
-	if (dir == NULL) {
-		return false;
-	} else {
-		for (int i=0; i < nVariables; i++)
-		{
-			variableList.push_back(dir[i]);
-		}
-  }
-  mxFree(dir);
-  return true;
+	for (size_t i=0; i<_directory.entries().size(); i++)
+	{
+		variableList.push_back(_directory.entries()[i].name);
+	}
+	return true;
 }
 
 void MatFile::printVariableList(bool verbose)
@@ -148,19 +272,28 @@ bool MatFile::getVariableInfo(const std::string& variableName, int& dimensions,
 {
 	if (!_isOpen) { return false; }
 
-	mxArray* mxArray = matGetVariableInfo(_file, variableName.c_str());
-
-	if (mxArray == NULL)
+	const MatV5Directory::Entry* entry = _directory.find(variableName);
+	if (entry == NULL)
 	{
 		return false;
 	}
 
-	dimensions = mxGetNumberOfDimensions(mxArray);
+	dimensions = entry->dims.size();
+	isGlobalVariable = entry->isGlobal();
+	return true;
+}
 
-	isGlobalVariable = mxIsFromGlobalWS(mxArray);
+bool MatFile::getVariableDims(const std::string& variableName, std::vector<size_t>& dims)
+{
+	if (!_isOpen) { return false; }
 
-	mxDestroyArray(mxArray);
+	const MatV5Directory::Entry* entry = _directory.find(variableName);
+	if (entry == NULL)
+	{
+		return false;
+	}
 
+	dims = entry->dims;
 	return true;
 }
 
@@ -0,0 +1,140 @@
+/*
+ * MxArrayPool.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <matlabCppInterface/MxArrayPool.hpp>
+#include <matlabCppInterface/Statistics.hpp>
+
+namespace matlab {
+
+bool MxArrayPool::Key::operator<(const Key& other) const
+{
+	if (classId != other.classId) { return classId < other.classId; }
+	if (isComplex != other.isComplex) { return isComplex < other.isComplex; }
+	return dims < other.dims;
+}
+
+MxArrayPool::MxArrayPool(uint64_t capacity) :
+	_capacity(capacity),
+	_pooledBytes(0)
+{}
+
+MxArrayPool::~MxArrayPool()
+{
+	clear();
+}
+
+mxArray* MxArrayPool::acquire(size_t nDims, const size_t* dims, mxClassID classId, mxComplexity complexity)
+{
+	Key key;
+	key.classId = classId;
+	key.isComplex = (complexity == mxCOMPLEX);
+	key.dims.assign(dims, dims + nDims);
+
+	// Matlab reports at least two dimensions and drops trailing singletons, released arrays are keyed that way
+	while (key.dims.size() < 2) { key.dims.push_back(1); }
+	while (key.dims.size() > 2 && key.dims.back() == 1) { key.dims.pop_back(); }
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		std::map<Key, std::vector<mxArray*> >::iterator kept = _arrays.find(key);
+		if (kept != _arrays.end())
+		{
+			mxArray* array = kept->second.back();
+			kept->second.pop_back();
+			if (kept->second.empty()) { _arrays.erase(kept); }
+			_pooledBytes -= Statistics::payloadBytes(array);
+			_counters.hits++;
+			return array;
+		}
+		_counters.misses++;
+	}
+	return mxCreateUninitNumericArray(nDims, dims, classId, complexity);
+}
+
+void MxArrayPool::release(mxArray* array)
+{
+	if (array == NULL) { return; }
+
+	// only dense numeric arrays can be handed out again as they are
+	bool reusable = (mxIsNumeric(array) || mxIsLogical(array)) && !mxIsSparse(array) && !mxIsEmpty(array);
+	uint64_t bytes = reusable ? Statistics::payloadBytes(array) : 0;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (reusable && _pooledBytes + bytes <= _capacity)
+		{
+			_arrays[keyOf(array)].push_back(array);
+			_pooledBytes += bytes;
+			_counters.recycled++;
+			return;
+		}
+		_counters.discarded++;
+	}
+	mxDestroyArray(array);
+}
+
+void MxArrayPool::setCapacity(uint64_t capacity)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_capacity = capacity;
+	trim();
+}
+
+uint64_t MxArrayPool::capacity() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _capacity;
+}
+
+uint64_t MxArrayPool::pooledBytes() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _pooledBytes;
+}
+
+MxArrayPool::Counters MxArrayPool::counters() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _counters;
+}
+
+void MxArrayPool::resetCounters()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_counters = Counters();
+}
+
+void MxArrayPool::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	uint64_t capacity = _capacity;
+	_capacity = 0;
+	trim();
+	_capacity = capacity;
+}
+
+MxArrayPool::Key MxArrayPool::keyOf(const mxArray* array)
+{
+	Key key;
+	key.classId = mxGetClassID(array);
+	key.isComplex = mxIsComplex(array);
+	key.dims.assign(mxGetDimensions(array), mxGetDimensions(array) + mxGetNumberOfDimensions(array));
+	return key;
+}
+
+void MxArrayPool::trim()
+{
+	while (_pooledBytes > _capacity && !_arrays.empty())
+	{
+		std::map<Key, std::vector<mxArray*> >::iterator kept = _arrays.begin();
+		mxArray* array = kept->second.back();
+		kept->second.pop_back();
+		if (kept->second.empty()) { _arrays.erase(kept); }
+		_pooledBytes -= Statistics::payloadBytes(array);
+		mxDestroyArray(array);
+	}
+}
+
+} // namespace matlab
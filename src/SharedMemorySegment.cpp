@@ -0,0 +1,140 @@
+/*
+ * SharedMemorySegment.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+
+#include <matlabCppInterface/SharedMemorySegment.hpp>
+
+namespace matlab {
+
+const char* SharedMemorySegment::DEFAULT_DIRECTORY = "/dev/shm";
+
+SharedMemorySegment::SharedMemorySegment() :
+	_data(NULL),
+	_size(0),
+	_created(false)
+{}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+	close();
+}
+
+bool SharedMemorySegment::create(const std::string& directory, size_t bytes)
+{
+	close();
+	if (bytes == 0) { return false; }
+
+	std::string name = directory + "/matlabCppInterfaceXXXXXX";
+	std::vector<char> path(name.begin(), name.end());
+	path.push_back('\0');
+	int fd = mkstemp(path.data());
+	if (fd < 0) { return false; }
+
+	// the pages are reserved up front, a full tmpfs would otherwise only show up as a SIGBUS on the first write
+	void* mapping = MAP_FAILED;
+	int error = posix_fallocate(fd, 0, bytes);
+	if (error == 0)
+	{
+		mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	} else
+	{
+		std::cout<<"Warning, could not allocate "<<bytes<<" bytes for "<<path.data()<<": "<<strerror(error)<<std::endl;
+	}
+	// the mapping stays valid after closing the descriptor
+	::close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		unlink(path.data());
+		return false;
+	}
+
+	_file = path.data();
+	_data = mapping;
+	_size = bytes;
+	_created = true;
+	return true;
+}
+
+bool SharedMemorySegment::open(const std::string& file, size_t bytes, bool writable)
+{
+	close();
+	if (bytes == 0) { return false; }
+
+	int fd = ::open(file.c_str(), writable ? O_RDWR : O_RDONLY);
+	if (fd < 0) { return false; }
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < bytes)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* mapping = mmap(NULL, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED) { return false; }
+
+	_file = file;
+	_data = mapping;
+	_size = bytes;
+	_created = false;
+	return true;
+}
+
+void SharedMemorySegment::close()
+{
+	if (_data != NULL) { munmap(_data, _size); }
+	if (_created) { unlink(_file.c_str()); }
+
+	_file.clear();
+	_data = NULL;
+	_size = 0;
+	_created = false;
+}
+
+mxClassID SharedMemorySegment::numericClass(const std::string& className)
+{
+	// the classes memmapfile can map
+	if (className == "double") { return mxDOUBLE_CLASS; }
+	if (className == "single") { return mxSINGLE_CLASS; }
+	if (className == "int8") { return mxINT8_CLASS; }
+	if (className == "uint8") { return mxUINT8_CLASS; }
+	if (className == "int16") { return mxINT16_CLASS; }
+	if (className == "uint16") { return mxUINT16_CLASS; }
+	if (className == "int32") { return mxINT32_CLASS; }
+	if (className == "uint32") { return mxUINT32_CLASS; }
+	if (className == "int64") { return mxINT64_CLASS; }
+	if (className == "uint64") { return mxUINT64_CLASS; }
+	return mxUNKNOWN_CLASS;
+}
+
+const char* SharedMemorySegment::className(mxClassID classId)
+{
+	switch (classId)
+	{
+		case mxDOUBLE_CLASS: return "double";
+		case mxSINGLE_CLASS: return "single";
+		case mxINT8_CLASS: return "int8";
+		case mxUINT8_CLASS: return "uint8";
+		case mxINT16_CLASS: return "int16";
+		case mxUINT16_CLASS: return "uint16";
+		case mxINT32_CLASS: return "int32";
+		case mxUINT32_CLASS: return "uint32";
+		case mxINT64_CLASS: return "int64";
+		case mxUINT64_CLASS: return "uint64";
+		default: return NULL;
+	}
+}
+
+} // namespace matlab
@@ -0,0 +1,228 @@
+/*
+ * Statistics.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <matlabCppInterface/Statistics.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace matlab {
+
+static uint64_t nanosecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+void LatencyHistogram::reset()
+{
+	for (size_t i=0; i<NUMBER_OF_BUCKETS; i++) { _buckets[i] = 0; }
+	_count = 0;
+	_total = 0;
+	_minimum = 0;
+	_maximum = 0;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+	size_t bucket = 0;
+	while (bucket < NUMBER_OF_BUCKETS - 1 && (nanoseconds >> (bucket + 1)) != 0) { bucket++; }
+
+	_buckets[bucket]++;
+	_minimum = (_count == 0 || nanoseconds < _minimum) ? nanoseconds : _minimum;
+	_maximum = (nanoseconds > _maximum) ? nanoseconds : _maximum;
+	_total += nanoseconds;
+	_count++;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const
+{
+	if (_count == 0) { return 0; }
+
+	uint64_t rank = static_cast<uint64_t>(fraction * _count + 0.5);
+	uint64_t seen = 0;
+	for (size_t i=0; i<NUMBER_OF_BUCKETS; i++)
+	{
+		seen += _buckets[i];
+		if (seen >= rank && seen > 0) { return std::min(uint64_t(2) << i, _maximum); }
+	}
+	return _maximum;
+}
+
+
+void Statistics::Call::switchPhase(Phase phase)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (_phase == CONVERSION) { _conversionNanoseconds += nanosecondsBetween(_phaseStart, now); }
+	if (_phase == TRANSPORT) { _transportNanoseconds += nanosecondsBetween(_phaseStart, now); }
+	_phase = phase;
+	_phaseStart = now;
+}
+
+void Statistics::Call::record()
+{
+	switchPhase(NONE);
+	_statistics->record(_operation, nanosecondsBetween(_start, _phaseStart), _conversionNanoseconds, _transportNanoseconds,
+			_bytes, _arrays, _succeeded);
+	_statistics = NULL;
+}
+
+
+const char* Statistics::operationName(Operation operation)
+{
+	switch (operation)
+	{
+		case PUT: return "put";
+		case GET: return "get";
+		case EXECUTE_COMMAND: return "executeCommand";
+		case OPEN: return "open";
+		case CLOSE: return "close";
+		case DESCRIBE: return "describe";
+		default: return "unknown";
+	}
+}
+
+Statistics::Statistics() :
+	_enabled(false),
+	_start(std::chrono::steady_clock::now()),
+	_dumpInterval(0),
+	_lastDump(_start)
+{}
+
+void Statistics::setEnabled(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (enabled && !_enabled) { _start = _lastDump = std::chrono::steady_clock::now(); }
+	_enabled = enabled;
+}
+
+void Statistics::reset()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (size_t i=0; i<NUMBER_OF_OPERATIONS; i++) { _operations[i] = OperationStatistics(); }
+	_start = _lastDump = std::chrono::steady_clock::now();
+}
+
+Statistics::Snapshot Statistics::snapshot() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return snapshotLocked();
+}
+
+Statistics::Snapshot Statistics::snapshotLocked() const
+{
+	Snapshot snapshot;
+	for (size_t i=0; i<NUMBER_OF_OPERATIONS; i++) { snapshot.operations[i] = _operations[i]; }
+	snapshot.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+	return snapshot;
+}
+
+void Statistics::setDumpCallback(const DumpCallback& callback, std::chrono::milliseconds interval)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_dumpCallback = callback;
+	_dumpInterval = interval;
+	_lastDump = std::chrono::steady_clock::now();
+}
+
+void Statistics::record(Operation operation, uint64_t nanoseconds, uint64_t conversionNanoseconds, uint64_t transportNanoseconds,
+		uint64_t bytes, uint64_t arrays, bool succeeded)
+{
+	Snapshot dump;
+	DumpCallback callback;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		OperationStatistics& statistics = _operations[operation];
+		statistics.calls++;
+		statistics.failures += succeeded ? 0 : 1;
+		statistics.bytes += bytes;
+		statistics.arrays += arrays;
+		statistics.conversionNanoseconds += conversionNanoseconds;
+		statistics.transportNanoseconds += transportNanoseconds;
+		statistics.latency.record(nanoseconds);
+
+		if (!_dumpCallback) { return; }
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now - _lastDump < _dumpInterval) { return; }
+		_lastDump = now;
+		dump = snapshotLocked();
+		callback = _dumpCallback;
+	}
+	// outside the lock, the callback may take a snapshot itself
+	callback(dump);
+}
+
+void Statistics::printSnapshot(const Snapshot& snapshot)
+{
+	std::cout<<snapshot.toString()<<std::flush;
+}
+
+uint64_t Statistics::payloadBytes(const mxArray* array)
+{
+	if (array == NULL) { return 0; }
+
+	size_t n = mxGetNumberOfElements(array);
+	if (mxIsCell(array))
+	{
+		uint64_t bytes = 0;
+		for (size_t i=0; i<n; i++) { bytes += payloadBytes(mxGetCell(array, i)); }
+		return bytes;
+	}
+	if (mxIsStruct(array))
+	{
+		uint64_t bytes = 0;
+		int nFields = mxGetNumberOfFields(array);
+		for (size_t i=0; i<n; i++)
+		{
+			for (int field=0; field<nFields; field++) { bytes += payloadBytes(mxGetFieldByNumber(array, i, field)); }
+		}
+		return bytes;
+	}
+
+#if MX_HAS_INTERLEAVED_COMPLEX
+	// the element size of interleaved complex arrays covers both parts
+	uint64_t elementBytes = mxGetElementSize(array);
+#else
+	uint64_t elementBytes = mxGetElementSize(array) * (mxIsComplex(array) ? 2 : 1);
+#endif
+	if (mxIsSparse(array))
+	{
+		// the non-zeros with their row indices and the column pointers, not the dense size
+		uint64_t nonZeros = mxGetJc(array)[mxGetN(array)];
+		return nonZeros * (elementBytes + sizeof(mwIndex)) + (mxGetN(array) + 1) * sizeof(mwIndex);
+	}
+	return uint64_t(n) * elementBytes;
+}
+
+std::string Statistics::Snapshot::toString() const
+{
+	std::string table;
+	char line[256];
+	snprintf(line, sizeof(line), "%-15s %10s %8s %12s %8s %12s %13s %10s %10s %10s\n",
+			"operation", "calls", "failed", "bytes", "arrays", "convert[ms]", "transport[ms]", "mean[us]", "p99[us]", "max[us]");
+	table += line;
+
+	for (size_t i=0; i<NUMBER_OF_OPERATIONS; i++)
+	{
+		const OperationStatistics& statistics = operations[i];
+		if (statistics.calls == 0) { continue; }
+
+		snprintf(line, sizeof(line), "%-15s %10llu %8llu %12llu %8llu %12.3f %13.3f %10.1f %10.1f %10.1f\n",
+				operationName(static_cast<Operation>(i)),
+				static_cast<unsigned long long>(statistics.calls),
+				static_cast<unsigned long long>(statistics.failures),
+				static_cast<unsigned long long>(statistics.bytes),
+				static_cast<unsigned long long>(statistics.arrays),
+				statistics.conversionNanoseconds * 1e-6,
+				statistics.transportNanoseconds * 1e-6,
+				statistics.latency.mean() * 1e-3,
+				statistics.latency.percentile(0.99) * 1e-3,
+				statistics.latency.maximum() * 1e-3);
+		table += line;
+	}
+	return table;
+}
+
+} // namespace matlab
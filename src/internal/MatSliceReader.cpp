@@ -0,0 +1,211 @@
+/*
+ * MatSliceReader.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <zlib.h>
+
+#ifdef MATLAB_CPP_INTERFACE_HDF5
+#include <hdf5.h>
+#endif
+
+#include <matlabCppInterface/internal/MatSliceReader.hpp>
+
+namespace matlab {
+
+// inflated bytes per step when streaming through a compressed variable
+static const size_t INFLATE_CHUNK = 256 * 1024;
+
+bool MatSliceReader::supportsHdf5()
+{
+#ifdef MATLAB_CPP_INTERFACE_HDF5
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool MatSliceReader::readV5Columns(const std::string& filename, const MatV5Directory::Entry& entry,
+		const IndexRange& rows, const IndexRange& cols, const ColumnSink& sink)
+{
+	if (!entry.isNumeric() || entry.isComplex() || entry.offset == 0 || entry.dims.empty()) { return false; }
+
+	size_t elementSize = MatSliceReader::elementSize(entry.dataType);
+	size_t nRows = entry.dims[0];
+	size_t nCols = (nRows == 0) ? 0 : entry.numberOfElements() / nRows;
+	if (elementSize == 0 || entry.dataBytes < entry.numberOfElements()*elementSize) { return false; }
+	if (rows.first + rows.size > nRows || cols.first + cols.size > nCols) { return false; }
+	if (rows.size == 0 || cols.size == 0) { return true; }
+
+	FILE* file = fopen(filename.c_str(), "rb");
+	if (!file) { return false; }
+
+	// the variable may have moved since the directory was built, e.g. when libmat rewrote the file
+	MatV5Directory::Entry current;
+	if (!MatV5Directory::readEntry(file, entry.offset, current) || current.name != entry.name || current.bytes != entry.bytes
+			|| current.compressed != entry.compressed || current.dims != entry.dims || current.dataType != entry.dataType
+			|| current.dataOffset != entry.dataOffset)
+	{
+		fclose(file);
+		return false;
+	}
+
+	bool success = entry.compressed
+			? inflateColumns(file, entry, elementSize, rows, cols, sink)
+			: readUncompressedColumns(file, entry, elementSize, rows, cols, sink);
+	fclose(file);
+	return success;
+}
+
+bool MatSliceReader::readUncompressedColumns(FILE* file, const MatV5Directory::Entry& entry, size_t elementSize,
+		const IndexRange& rows, const IndexRange& cols, const ColumnSink& sink)
+{
+	std::vector<char> column(rows.size*elementSize);
+	for (size_t i=0; i<cols.size; i++)
+	{
+		uint64_t element = uint64_t(cols.first + i)*entry.dims[0] + rows.first;
+		if (fseeko(file, entry.offset + entry.dataOffset + element*elementSize, SEEK_SET) != 0) { return false; }
+		if (fread(column.data(), 1, column.size(), file) != column.size()) { return false; }
+		sink(i, column.data());
+	}
+	return true;
+}
+
+bool MatSliceReader::inflateColumns(FILE* file, const MatV5Directory::Entry& entry, size_t elementSize,
+		const IndexRange& rows, const IndexRange& cols, const ColumnSink& sink)
+{
+	if (fseeko(file, entry.offset + matv5::TAG_SIZE, SEEK_SET) != 0) { return false; }
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (inflateInit(&stream) != Z_OK) { return false; }
+
+	std::vector<char> input(64 * 1024);
+	std::vector<char> chunk(INFLATE_CHUNK);
+	std::vector<char> column(rows.size*elementSize);
+	uint64_t remaining = entry.bytes - matv5::TAG_SIZE;
+
+	// position of the end of the inflated data, the data before the block is inflated and dropped
+	uint64_t position = 0;
+	size_t i = 0, filled = 0;
+	int status = Z_OK;
+	while (i < cols.size && status != Z_STREAM_END)
+	{
+		stream.next_out = reinterpret_cast<Bytef*>(chunk.data());
+		stream.avail_out = chunk.size();
+		while (stream.avail_out > 0 && status != Z_STREAM_END)
+		{
+			if (stream.avail_in == 0)
+			{
+				size_t n = fread(input.data(), 1, std::min<uint64_t>(input.size(), remaining), file);
+				if (n == 0) { break; }
+				remaining -= n;
+				stream.next_in = reinterpret_cast<Bytef*>(input.data());
+				stream.avail_in = n;
+			}
+			status = inflate(&stream, Z_NO_FLUSH);
+			if (status != Z_OK && status != Z_STREAM_END) { break; }
+		}
+		if (status != Z_OK && status != Z_STREAM_END) { break; }
+
+		uint64_t chunkStart = position;
+		position += chunk.size() - stream.avail_out;
+		if (position == chunkStart) { break; }
+
+		// copy the parts of the columns that are in this chunk
+		while (i < cols.size)
+		{
+			uint64_t element = uint64_t(cols.first + i)*entry.dims[0] + rows.first;
+			uint64_t next = entry.dataOffset + element*elementSize + filled;
+			if (next >= position) { break; }
+
+			size_t n = std::min<uint64_t>(column.size() - filled, position - next);
+			memcpy(&column[filled], &chunk[next - chunkStart], n);
+			filled += n;
+			if (filled == column.size())
+			{
+				sink(i, column.data());
+				i++;
+				filled = 0;
+			}
+		}
+	}
+	inflateEnd(&stream);
+
+	return i == cols.size;
+}
+
+bool MatSliceReader::readHdf5Block(const std::string& filename, const std::string& name,
+		const IndexRange& rows, const IndexRange& cols, uint32_t& dataType, std::vector<char>& block)
+{
+#ifdef MATLAB_CPP_INTERFACE_HDF5
+	if (H5Fis_hdf5(filename.c_str()) <= 0) { return false; }
+
+	hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (file < 0) { return false; }
+	if (H5Lexists(file, name.c_str(), H5P_DEFAULT) <= 0) { H5Fclose(file); return false; }
+
+	bool success = false;
+	hid_t dataset = H5Dopen2(file, name.c_str(), H5P_DEFAULT);
+	hid_t space = H5Dget_space(dataset);
+	hid_t type = H5Dget_type(dataset);
+	hid_t nativeType = H5Tget_native_type(type, H5T_DIR_ASCEND);
+
+	// Matlab stores the transposed matrix, the HDF5 dimensions are cols x rows
+	hsize_t dims[2];
+	H5T_class_t typeClass = H5Tget_class(nativeType);
+	size_t size = H5Tget_size(nativeType);
+	dataType = 0;
+	if (typeClass == H5T_FLOAT) { dataType = (size == 8) ? matv5::miDOUBLE : (size == 4) ? matv5::miSINGLE : 0; }
+	if (typeClass == H5T_INTEGER)
+	{
+		bool isSigned = H5Tget_sign(nativeType) == H5T_SGN_2;
+		switch (size)
+		{
+			case 1: { dataType = isSigned ? matv5::miINT8 : matv5::miUINT8; break; }
+			case 2: { dataType = isSigned ? matv5::miINT16 : matv5::miUINT16; break; }
+			case 4: { dataType = isSigned ? matv5::miINT32 : matv5::miUINT32; break; }
+			case 8: { dataType = isSigned ? matv5::miINT64 : matv5::miUINT64; break; }
+		}
+	}
+
+	if (dataType != 0 && H5Sget_simple_extent_ndims(space) == 2 && H5Sget_simple_extent_dims(space, dims, NULL) == 2
+			&& rows.first + rows.size <= dims[1] && cols.first + cols.size <= dims[0])
+	{
+		// only the chunks of the dataset that intersect the block are read
+		hsize_t start[2] = { cols.first, rows.first };
+		hsize_t count[2] = { cols.size, rows.size };
+		block.resize(rows.size*cols.size*size);
+		hid_t memorySpace = H5Screate_simple(2, count, NULL);
+		success = H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) >= 0
+				&& (block.empty() || H5Dread(dataset, nativeType, memorySpace, space, H5P_DEFAULT, block.data()) >= 0);
+		H5Sclose(memorySpace);
+	}
+
+	H5Tclose(nativeType);
+	H5Tclose(type);
+	H5Sclose(space);
+	H5Dclose(dataset);
+	H5Fclose(file);
+	return success;
+#else
+	return false;
+#endif
+}
+
+size_t MatSliceReader::elementSize(uint32_t dataType)
+{
+	switch (dataType)
+	{
+		case matv5::miINT8: case matv5::miUINT8: case matv5::miUTF8: return 1;
+		case matv5::miINT16: case matv5::miUINT16: return 2;
+		case matv5::miINT32: case matv5::miUINT32: case matv5::miSINGLE: return 4;
+		case matv5::miINT64: case matv5::miUINT64: case matv5::miDOUBLE: return 8;
+		default: return 0;
+	}
+}
+
+} // namespace matlab
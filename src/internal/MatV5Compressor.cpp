@@ -0,0 +1,198 @@
+/*
+ * MatV5Compressor.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sys/types.h>
+#include <thread>
+#include <zlib.h>
+
+#include <matlabCppInterface/internal/MatV5Compressor.hpp>
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+
+namespace matlab {
+
+MatV5Compressor::MatV5Compressor() :
+	_level(0),
+	_threads(std::max(1u, std::thread::hardware_concurrency())),
+	_nextWorker(0),
+	_file(NULL),
+	_staging(false),
+	_firstChunk(false),
+	_elementOffset(0),
+	_elementBytes(0),
+	_elementAdler(1),
+	_bytesWritten(0),
+	_failed(false)
+{}
+
+MatV5Compressor::~MatV5Compressor()
+{
+	flush();
+}
+
+void MatV5Compressor::setThreads(size_t threads)
+{
+	_threads = std::max<size_t>(threads, 1);
+}
+
+void MatV5Compressor::begin(FILE* file)
+{
+	// an element that was abandoned after a failed write is closed, like a truncated uncompressed one
+	if (_staging) { end(); }
+	if (_file != file) { flush(); }
+	_file = file;
+	_staging = true;
+	_firstChunk = true;
+}
+
+bool MatV5Compressor::stage(const void* data, size_t nBytes)
+{
+	const char* bytes = static_cast<const char*>(data);
+	while (nBytes > 0)
+	{
+		if (!_staged)
+		{
+			_staged = std::make_shared<std::vector<char> >();
+			_staged->reserve(CHUNK_SIZE);
+		}
+
+		size_t n = std::min<size_t>(nBytes, CHUNK_SIZE - _staged->size());
+		_staged->insert(_staged->end(), bytes, bytes + n);
+		bytes += n;
+		nBytes -= n;
+
+		if (_staged->size() == CHUNK_SIZE) { submit(false); }
+	}
+	return !_failed;
+}
+
+bool MatV5Compressor::end()
+{
+	submit(true);
+	_staging = false;
+	return !_failed;
+}
+
+bool MatV5Compressor::flush()
+{
+	while (!_pending.empty()) { writePending(); }
+	bool success = !_failed;
+	_failed = false;
+	return success;
+}
+
+void MatV5Compressor::submit(bool last)
+{
+	if (_workers.size() != _threads)
+	{
+		// the old workers finish their chunks before they are destroyed
+		while (!_pending.empty()) { writePending(); }
+		_workers.clear();
+		for (size_t i=0; i<_threads; i++) { _workers.push_back(std::unique_ptr<WorkerThread>(new WorkerThread())); }
+		_nextWorker = 0;
+	}
+
+	std::shared_ptr<std::vector<char> > input = _staged ? _staged : std::make_shared<std::vector<char> >();
+	_staged.reset();
+	int level = _level;
+
+	Pending pending;
+	pending.chunk = _workers[_nextWorker]->submit([input, level, last]() { return deflateChunk(*input, level, last); });
+	pending.first = _firstChunk;
+	pending.last = last;
+	_pending.push_back(std::move(pending));
+	_nextWorker = (_nextWorker + 1) % _workers.size();
+	_firstChunk = false;
+
+	// bounds the memory, a few chunks per thread keep all threads busy
+	while (_pending.size() > 4*_workers.size()) { writePending(); }
+}
+
+void MatV5Compressor::writePending()
+{
+	Pending pending = std::move(_pending.front());
+	_pending.pop_front();
+	Chunk chunk = pending.chunk.get();
+	_failed = _failed || !chunk.succeeded;
+
+	if (pending.first)
+	{
+		// the length is not known yet, the tag is patched at the end
+		uint32_t tag[2] = { matv5::miCOMPRESSED, 0 };
+		_elementOffset = ftello(_file);
+		_elementBytes = 0;
+		_elementAdler = adler32(0, NULL, 0);
+		write(tag, sizeof(tag));
+
+		// zlib header, deflate with a 32K window and the level in the flags
+		int levelFlags = (_level < 2) ? 0 : (_level < 6) ? 1 : (_level == 6) ? 2 : 3;
+		unsigned char header[2] = { 0x78, static_cast<unsigned char>(levelFlags << 6) };
+		header[1] += 31 - ((header[0]*256 + header[1]) % 31);
+		write(header, sizeof(header));
+		_elementBytes += sizeof(header);
+	}
+
+	write(chunk.data.data(), chunk.data.size());
+	_elementBytes += chunk.data.size();
+	_elementAdler = adler32_combine(_elementAdler, chunk.adler, chunk.inputBytes);
+
+	if (pending.last)
+	{
+		// the checksum is stored in big endian
+		unsigned char trailer[4] = {
+				static_cast<unsigned char>(_elementAdler >> 24), static_cast<unsigned char>(_elementAdler >> 16),
+				static_cast<unsigned char>(_elementAdler >> 8), static_cast<unsigned char>(_elementAdler) };
+		write(trailer, sizeof(trailer));
+		_elementBytes += sizeof(trailer);
+
+		// Level 5 files store sizes in 32 bit
+		uint32_t length = static_cast<uint32_t>(_elementBytes);
+		_failed = _failed || _elementBytes > std::numeric_limits<uint32_t>::max();
+		_failed = _failed || fseeko(_file, _elementOffset + sizeof(uint32_t), SEEK_SET) != 0
+				|| fwrite(&length, 1, sizeof(length), _file) != sizeof(length)
+				|| fseeko(_file, 0, SEEK_END) != 0;
+	}
+}
+
+bool MatV5Compressor::write(const void* data, size_t nBytes)
+{
+	if (nBytes == 0) { return true; }
+	size_t written = fwrite(data, 1, nBytes, _file);
+	_bytesWritten += written;
+	_failed = _failed || written != nBytes;
+	return written == nBytes;
+}
+
+MatV5Compressor::Chunk MatV5Compressor::deflateChunk(const std::vector<char>& input, int level, bool last)
+{
+	Chunk chunk;
+	chunk.inputBytes = input.size();
+	chunk.adler = adler32(adler32(0, NULL, 0), reinterpret_cast<const Bytef*>(input.data()), input.size());
+
+	// a raw deflate stream, the zlib header and trailer are written around all chunks
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) { return chunk; }
+
+	// the bound does not include the markers of the flush
+	chunk.data.resize(deflateBound(&stream, input.size()) + 16);
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+	stream.avail_in = input.size();
+	stream.next_out = reinterpret_cast<Bytef*>(chunk.data.data());
+	stream.avail_out = chunk.data.size();
+
+	// a sync flush ends the chunk on a byte boundary without ending the stream
+	int status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+	chunk.succeeded = last ? (status == Z_STREAM_END) : (status == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+	chunk.data.resize(stream.total_out);
+	deflateEnd(&stream);
+
+	return chunk;
+}
+
+} // namespace matlab
@@ -0,0 +1,241 @@
+/*
+ * MatV5Directory.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <zlib.h>
+
+#include <matlabCppInterface/internal/MatV5Directory.hpp>
+
+namespace matlab {
+
+// reads a data element tag from a buffer, supports the small data element format
+static bool readTag(const char* data, uint64_t offset, uint64_t end, uint32_t& dataType, uint64_t& nBytes, uint64_t& dataOffset, uint64_t& nextOffset)
+{
+	if (offset + matv5::TAG_SIZE > end) { return false; }
+
+	uint32_t tag[2];
+	memcpy(tag, &data[offset], sizeof(tag));
+
+	if (tag[0] >> 16)
+	{
+		dataType = tag[0] & 0xFFFF;
+		nBytes = tag[0] >> 16;
+		dataOffset = offset + 4;
+		nextOffset = offset + matv5::TAG_SIZE;
+		return nBytes <= 4;
+	}
+
+	dataType = tag[0];
+	nBytes = tag[1];
+	dataOffset = offset + matv5::TAG_SIZE;
+	nextOffset = dataOffset + matv5::padded(nBytes);
+	return dataOffset + nBytes <= end;
+}
+
+size_t MatV5Directory::Entry::numberOfElements() const
+{
+	size_t n = 1;
+	for (size_t i=0; i<dims.size(); i++) { n *= dims[i]; }
+	return n;
+}
+
+bool MatV5Directory::build(const std::string& filename)
+{
+	clear();
+
+	FILE* file = fopen(filename.c_str(), "rb");
+	if (!file) { return false; }
+
+	// only Level 5 files in native byte order
+	char header[matv5::HEADER_SIZE];
+	uint16_t version = 0, endian = 0;
+	if (fread(header, 1, sizeof(header), file) == sizeof(header))
+	{
+		memcpy(&version, &header[124], sizeof(version));
+		memcpy(&endian, &header[126], sizeof(endian));
+	}
+	if (version != 0x0100 || endian != (('M' << 8) | 'I'))
+	{
+		fclose(file);
+		return false;
+	}
+
+	bool success = true;
+	uint64_t offset = matv5::HEADER_SIZE;
+	while (true)
+	{
+		Entry entry;
+		bool isVariable = false;
+		success = readElement(file, offset, entry, isVariable);
+		if (!success || entry.bytes == 0) { break; }
+
+		if (isVariable) { insert(entry); }
+		offset += entry.bytes;
+	}
+	fclose(file);
+
+	if (!success) { clear(); }
+	return success;
+}
+
+void MatV5Directory::clear()
+{
+	_entries.clear();
+	_index.clear();
+}
+
+const MatV5Directory::Entry* MatV5Directory::find(const std::string& name) const
+{
+	std::map<std::string, size_t>::const_iterator it = _index.find(name);
+	if (it == _index.end()) { return NULL; }
+	return &_entries[it->second];
+}
+
+void MatV5Directory::insert(const Entry& entry)
+{
+	std::map<std::string, size_t>::iterator it = _index.find(entry.name);
+	if (it != _index.end())
+	{
+		_entries[it->second] = entry;
+		return;
+	}
+	_index[entry.name] = _entries.size();
+	_entries.push_back(entry);
+}
+
+bool MatV5Directory::erase(const std::string& name)
+{
+	std::map<std::string, size_t>::iterator it = _index.find(name);
+	if (it == _index.end()) { return false; }
+
+	_entries.erase(_entries.begin() + it->second);
+	_index.clear();
+	for (size_t i=0; i<_entries.size(); i++) { _index[_entries[i].name] = i; }
+	return true;
+}
+
+bool MatV5Directory::parseHeader(const char* data, uint64_t nBytes, Entry& entry)
+{
+	uint32_t type;
+	uint64_t elementBytes, dataOffset, offset = 0;
+
+	// array flags
+	if (!readTag(data, offset, nBytes, type, elementBytes, dataOffset, offset) || type != matv5::miUINT32 || elementBytes < 8) { return false; }
+	uint32_t flags;
+	memcpy(&flags, &data[dataOffset], sizeof(flags));
+	entry.arrayClass = flags & 0xFF;
+	entry.flags = (flags >> 8) & 0xFF;
+
+	// dimensions, every array has at least two
+	if (!readTag(data, offset, nBytes, type, elementBytes, dataOffset, offset) || type != matv5::miINT32 || elementBytes < 2*sizeof(int32_t)) { return false; }
+	entry.dims.resize(elementBytes/sizeof(int32_t));
+	for (size_t i=0; i<entry.dims.size(); i++)
+	{
+		int32_t dim;
+		memcpy(&dim, &data[dataOffset + i*sizeof(int32_t)], sizeof(dim));
+		entry.dims[i] = dim;
+	}
+
+	// name
+	if (!readTag(data, offset, nBytes, type, elementBytes, dataOffset, offset) || type != matv5::miINT8) { return false; }
+	entry.name.assign(&data[dataOffset], elementBytes);
+
+	// real part, if it starts within the parsed bytes
+	if ((entry.isNumeric() || entry.arrayClass == matv5::mxCHAR) && offset + matv5::TAG_SIZE <= nBytes)
+	{
+		uint32_t tag[2];
+		memcpy(tag, &data[offset], sizeof(tag));
+		bool isSmall = (tag[0] >> 16) != 0;
+		entry.dataType = isSmall ? (tag[0] & 0xFFFF) : tag[0];
+		entry.dataBytes = isSmall ? (tag[0] >> 16) : tag[1];
+		entry.dataOffset = matv5::TAG_SIZE + offset + (isSmall ? 4 : matv5::TAG_SIZE);
+	}
+	return true;
+}
+
+void MatV5Directory::invalidateOffsets()
+{
+	for (size_t i=0; i<_entries.size(); i++) { _entries[i].offset = 0; }
+}
+
+bool MatV5Directory::readEntry(FILE* file, uint64_t offset, Entry& entry)
+{
+	bool isVariable = false;
+	return readElement(file, offset, entry, isVariable) && isVariable;
+}
+
+bool MatV5Directory::readElement(FILE* file, uint64_t offset, Entry& entry, bool& isVariable)
+{
+	entry = Entry();
+	isVariable = false;
+
+	uint32_t tag[2];
+	if (fseeko(file, offset, SEEK_SET) != 0 || fread(tag, 1, sizeof(tag), file) != sizeof(tag)) { return true; }
+
+	uint32_t type = tag[0];
+	uint64_t nBytes = tag[1];
+	// compressed elements are not padded
+	entry.offset = offset;
+	entry.bytes = matv5::TAG_SIZE + (type == matv5::miCOMPRESSED ? nBytes : matv5::padded(nBytes));
+
+	std::vector<char> buffer;
+	if (type == matv5::miMATRIX)
+	{
+		buffer.resize(std::min<uint64_t>(nBytes, HEADER_BYTES));
+		isVariable = fread(buffer.data(), 1, buffer.size(), file) == buffer.size()
+				&& parseHeader(buffer.data(), buffer.size(), entry);
+		return isVariable;
+	}
+	if (type == matv5::miCOMPRESSED)
+	{
+		// the inflated element starts with its own miMATRIX tag
+		entry.compressed = true;
+		isVariable = inflateHeader(file, nBytes, buffer) && buffer.size() >= matv5::TAG_SIZE;
+		if (isVariable)
+		{
+			memcpy(tag, &buffer[0], sizeof(tag));
+			isVariable = tag[0] == matv5::miMATRIX
+					&& parseHeader(&buffer[matv5::TAG_SIZE], buffer.size() - matv5::TAG_SIZE, entry);
+		}
+		return isVariable;
+	}
+	return true;
+}
+
+bool MatV5Directory::inflateHeader(FILE* file, uint64_t nBytes, std::vector<char>& header)
+{
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (inflateInit(&stream) != Z_OK) { return false; }
+
+	header.resize(HEADER_BYTES);
+	stream.next_out = reinterpret_cast<Bytef*>(&header[0]);
+	stream.avail_out = header.size();
+
+	// feed small pieces until the header is inflated, the rest of the variable is not read
+	char input[4096];
+	uint64_t remaining = nBytes;
+	int status = Z_OK;
+	while (status == Z_OK && stream.avail_out > 0 && remaining > 0)
+	{
+		size_t n = fread(input, 1, std::min<uint64_t>(sizeof(input), remaining), file);
+		if (n == 0) { break; }
+		remaining -= n;
+
+		stream.next_in = reinterpret_cast<Bytef*>(input);
+		stream.avail_in = n;
+		status = inflate(&stream, Z_NO_FLUSH);
+		// the output is full before the input is used up
+		if (status == Z_BUF_ERROR) { status = Z_OK; }
+	}
+	header.resize(header.size() - stream.avail_out);
+	inflateEnd(&stream);
+
+	return status == Z_OK || status == Z_STREAM_END;
+}
+
+} // namespace matlab
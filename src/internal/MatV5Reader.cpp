@@ -0,0 +1,335 @@
+/*
+ * MatV5Reader.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <matlabCppInterface/internal/MatV5Reader.hpp>
+
+namespace matlab {
+
+// the UTF-8 bytes of one code point
+static void appendUtf8(uint32_t codePoint, std::string& value)
+{
+	if (codePoint < 0x80)
+	{
+		value.push_back(static_cast<char>(codePoint));
+	} else if (codePoint < 0x800)
+	{
+		value.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+		value.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+	} else if (codePoint < 0x10000)
+	{
+		value.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+		value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+		value.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+	} else
+	{
+		value.push_back(static_cast<char>(0xf0 | (codePoint >> 18)));
+		value.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+		value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+		value.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+	}
+}
+
+size_t MatV5Reader::Variable::numberOfElements() const
+{
+	size_t n = 1;
+	for (size_t i=0; i<dims.size(); i++) { n *= dims[i]; }
+	return n;
+}
+
+MatV5Reader::MatV5Reader() :
+	_mapping(NULL),
+	_mappingSize(0),
+	_hasCompressedVariables(false)
+{}
+
+MatV5Reader::~MatV5Reader()
+{
+	close();
+}
+
+bool MatV5Reader::open(const std::string& filename)
+{
+	close();
+
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) { return false; }
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < matv5::HEADER_SIZE)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	// the mapping stays valid after closing the descriptor
+	::close(fd);
+	if (mapping == MAP_FAILED) { return false; }
+
+	_mapping = static_cast<const char*>(mapping);
+	_mappingSize = fileStat.st_size;
+
+	if (!index())
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MatV5Reader::close()
+{
+	if (!_mapping) { return false; }
+
+	bool success = (munmap(const_cast<char*>(_mapping), _mappingSize) == 0);
+	_mapping = NULL;
+	_mappingSize = 0;
+	_variables.clear();
+	_variableIndex.clear();
+	_hasCompressedVariables = false;
+	return success;
+}
+
+const MatV5Reader::Variable* MatV5Reader::find(const std::string& name) const
+{
+	std::map<std::string, size_t>::const_iterator it = _variableIndex.find(name);
+	if (it == _variableIndex.end()) { return NULL; }
+	return &_variables[it->second];
+}
+
+bool MatV5Reader::map(const std::string& name, Eigen::Map<const Eigen::MatrixXd>& view) const
+{
+	const Variable* variable = find(name);
+	if (!variable || variable->arrayClass != matv5::mxDOUBLE || variable->dataType != matv5::miDOUBLE || variable->isComplex()) { return false; }
+
+	size_t n = variable->numberOfElements();
+	if (n*sizeof(double) > variable->dataBytes) { return false; }
+
+	Eigen::Index rows = variable->dims[0];
+	Eigen::Index cols = (rows == 0) ? 0 : n / rows;
+
+	// Eigen::Map cannot be reassigned, it has to be reconstructed in place
+	new (&view) Eigen::Map<const Eigen::MatrixXd>(reinterpret_cast<const double*>(variable->data), rows, cols);
+	return true;
+}
+
+bool MatV5Reader::read(const std::string& name, bool& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable || !variable->isNumeric() || variable->numberOfElements() != 1) { return false; }
+
+	return copyData(*variable, 0, 1, &value);
+}
+
+bool MatV5Reader::read(const std::string& name, std::string& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable || variable->arrayClass != matv5::mxCHAR) { return false; }
+
+	return readChars(*variable, 0, variable->numberOfElements(), 1, value);
+}
+
+bool MatV5Reader::read(const std::string& name, std::vector<std::string>& value) const
+{
+	const Variable* variable = find(name);
+	if (!variable) { return false; }
+
+	if (variable->arrayClass == matv5::mxCHAR)
+	{
+		if (variable->dims.size() != 2) { return false; }
+
+		// the characters of a row are one column apart, trailing blanks are removed like cellstr does
+		size_t rows = variable->dims[0];
+		value.resize(rows);
+		for (size_t i=0; i<rows; i++)
+		{
+			if (!readChars(*variable, i, variable->dims[1], rows, value[i])) { return false; }
+			value[i].erase(value[i].find_last_not_of(' ') + 1);
+		}
+		return true;
+	}
+	if (variable->arrayClass != matv5::mxCELL) { return false; }
+
+	value.resize(variable->numberOfElements());
+	uint64_t offset = variable->data - _mapping;
+	uint64_t end = offset + variable->dataBytes;
+	for (size_t i=0; i<value.size(); i++)
+	{
+		uint32_t type;
+		uint64_t nBytes, dataOffset;
+		if (!readTag(offset, end, type, nBytes, dataOffset, offset) || type != matv5::miMATRIX) { return false; }
+
+		// empty cells can be empty arrays of any class or elements without subelements
+		Variable cell;
+		if (nBytes > 0 && !parseArray(dataOffset, dataOffset + nBytes, cell)) { return false; }
+		if (nBytes == 0 || cell.numberOfElements() == 0)
+		{
+			value[i].clear();
+			continue;
+		}
+		if (cell.arrayClass != matv5::mxCHAR || !readChars(cell, 0, cell.numberOfElements(), 1, value[i])) { return false; }
+	}
+	return true;
+}
+
+bool MatV5Reader::readChars(const Variable& variable, size_t first, size_t n, size_t stride, std::string& value) const
+{
+	size_t last = (n == 0) ? first : first + (n-1)*stride + 1;
+	if (last*elementSize(variable.dataType) > variable.dataBytes) { return false; }
+
+	// UTF-16 code units are encoded as UTF-8, a surrogate without its partner as U+FFFD
+	if (variable.dataType == matv5::miUINT16)
+	{
+		const uint16_t* chars = reinterpret_cast<const uint16_t*>(variable.data) + first;
+		value.clear();
+		value.reserve(n);
+		for (size_t i=0; i<n; i++)
+		{
+			uint32_t codePoint = chars[i*stride];
+			if (codePoint >= 0xd800 && codePoint < 0xe000)
+			{
+				uint32_t low = (i+1 < n) ? chars[(i+1)*stride] : 0;
+				if (codePoint < 0xdc00 && low >= 0xdc00 && low < 0xe000)
+				{
+					codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+					i++;
+				} else
+				{
+					codePoint = 0xfffd;
+				}
+			}
+			appendUtf8(codePoint, value);
+		}
+		return true;
+	}
+	// straight into the storage of value
+	value.resize(n);
+	if (variable.dataType == matv5::miUTF8 || variable.dataType == matv5::miUINT8 || variable.dataType == matv5::miINT8)
+	{
+		const char* chars = variable.data + first;
+		for (size_t i=0; i<n; i++) { value[i] = chars[i*stride]; }
+		return true;
+	}
+	return false;
+}
+
+bool MatV5Reader::index()
+{
+	// only Level 5 files in native byte order can be mapped
+	uint16_t version, endian;
+	memcpy(&version, &_mapping[124], sizeof(version));
+	memcpy(&endian, &_mapping[126], sizeof(endian));
+	if (version != 0x0100 || endian != (('M' << 8) | 'I')) { return false; }
+
+	uint64_t offset = matv5::HEADER_SIZE;
+	while (offset + matv5::TAG_SIZE <= _mappingSize)
+	{
+		uint32_t type;
+		uint64_t nBytes, dataOffset, nextOffset;
+		if (!readTag(offset, _mappingSize, type, nBytes, dataOffset, nextOffset)) { return false; }
+		offset = nextOffset;
+
+		// compressed variables cannot be mapped
+		if (type == matv5::miCOMPRESSED) { _hasCompressedVariables = true; }
+		if (type != matv5::miMATRIX) { continue; }
+
+		Variable variable;
+		if (!parseArray(dataOffset, dataOffset + nBytes, variable)) { return false; }
+
+		_variableIndex[variable.name] = _variables.size();
+		_variables.push_back(variable);
+	}
+	return true;
+}
+
+bool MatV5Reader::parseArray(uint64_t offset, uint64_t end, Variable& variable) const
+{
+	uint32_t type;
+	uint64_t nBytes, dataOffset;
+
+	// array flags
+	uint64_t subOffset = offset;
+	if (!readTag(subOffset, end, type, nBytes, dataOffset, subOffset) || type != matv5::miUINT32 || nBytes < 8) { return false; }
+	uint32_t flags;
+	memcpy(&flags, &_mapping[dataOffset], sizeof(flags));
+	variable.arrayClass = flags & 0xFF;
+	variable.flags = (flags >> 8) & 0xFF;
+
+	// dimensions, every array has at least two
+	if (!readTag(subOffset, end, type, nBytes, dataOffset, subOffset) || type != matv5::miINT32 || nBytes < 2*sizeof(int32_t)) { return false; }
+	variable.dims.resize(nBytes/sizeof(int32_t));
+	for (size_t i=0; i<variable.dims.size(); i++)
+	{
+		int32_t dim;
+		memcpy(&dim, &_mapping[dataOffset + i*sizeof(int32_t)], sizeof(dim));
+		variable.dims[i] = dim;
+	}
+
+	// name
+	if (!readTag(subOffset, end, type, nBytes, dataOffset, subOffset) || type != matv5::miINT8) { return false; }
+	variable.name.assign(&_mapping[dataOffset], nBytes);
+
+	// real part, only for numeric and char arrays, the elements of cell arrays follow the name
+	variable.dataType = 0;
+	variable.data = NULL;
+	variable.dataBytes = 0;
+	if (variable.isNumeric() || variable.arrayClass == matv5::mxCHAR)
+	{
+		if (!readTag(subOffset, end, type, nBytes, dataOffset, subOffset)) { return false; }
+		variable.dataType = type;
+		variable.data = &_mapping[dataOffset];
+		variable.dataBytes = nBytes;
+	} else if (variable.arrayClass == matv5::mxCELL)
+	{
+		variable.data = &_mapping[subOffset];
+		variable.dataBytes = end - subOffset;
+	}
+	return true;
+}
+
+bool MatV5Reader::readTag(uint64_t offset, uint64_t end, uint32_t& dataType, uint64_t& nBytes, uint64_t& dataOffset, uint64_t& nextOffset) const
+{
+	if (offset + matv5::TAG_SIZE > end) { return false; }
+
+	uint32_t tag[2];
+	memcpy(tag, &_mapping[offset], sizeof(tag));
+
+	if (tag[0] >> 16)
+	{
+		// small data element, type and size share the first 4 bytes
+		dataType = tag[0] & 0xFFFF;
+		nBytes = tag[0] >> 16;
+		dataOffset = offset + 4;
+		nextOffset = offset + matv5::TAG_SIZE;
+		return nBytes <= 4;
+	}
+
+	dataType = tag[0];
+	nBytes = tag[1];
+	dataOffset = offset + matv5::TAG_SIZE;
+	// compressed elements are not padded
+	nextOffset = dataOffset + (dataType == matv5::miCOMPRESSED ? nBytes : matv5::padded(nBytes));
+	return dataOffset + nBytes <= end;
+}
+
+size_t MatV5Reader::elementSize(uint32_t dataType)
+{
+	switch (dataType)
+	{
+		case matv5::miINT8: case matv5::miUINT8: case matv5::miUTF8: return 1;
+		case matv5::miINT16: case matv5::miUINT16: return 2;
+		case matv5::miINT32: case matv5::miUINT32: case matv5::miSINGLE: return 4;
+		case matv5::miINT64: case matv5::miUINT64: case matv5::miDOUBLE: return 8;
+		default: return 0;
+	}
+}
+
+} // namespace matlab
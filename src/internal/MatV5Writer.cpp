@@ -0,0 +1,615 @@
+/*
+ * MatV5Writer.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <ctime>
+#include <limits>
+
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+
+namespace matlab {
+
+// class, storage type and flags of an mxArray in the file, false if the array cannot be written
+static bool arrayStorage(const mxArray* array, uint8_t& arrayClass, uint32_t& dataType, uint8_t& flags)
+{
+	flags = 0;
+	dataType = 0;
+
+	// sparse matrices store the non-zeros as double with 32 bit row indices and column pointers
+	if (mxIsSparse(array))
+	{
+		arrayClass = matv5::mxSPARSE;
+		dataType = matv5::miDOUBLE;
+		return mxIsDouble(array) && !mxIsComplex(array) && mxGetM(array) <= size_t(std::numeric_limits<int32_t>::max())
+				&& mxGetJc(array)[mxGetN(array)] <= size_t(std::numeric_limits<int32_t>::max());
+	}
+
+	// complex arrays store the real parts, followed by the imaginary parts
+	if (mxIsComplex(array))
+	{
+		flags = matv5::FLAG_COMPLEX;
+		if (!mxIsNumeric(array)) { return false; }
+	}
+
+	switch (mxGetClassID(array))
+	{
+		case mxDOUBLE_CLASS: { arrayClass = matv5::mxDOUBLE; dataType = matv5::miDOUBLE; return true; }
+		case mxSINGLE_CLASS: { arrayClass = matv5::mxSINGLE; dataType = matv5::miSINGLE; return true; }
+		case mxINT8_CLASS: { arrayClass = matv5::mxINT8; dataType = matv5::miINT8; return true; }
+		case mxUINT8_CLASS: { arrayClass = matv5::mxUINT8; dataType = matv5::miUINT8; return true; }
+		case mxINT16_CLASS: { arrayClass = matv5::mxINT16; dataType = matv5::miINT16; return true; }
+		case mxUINT16_CLASS: { arrayClass = matv5::mxUINT16; dataType = matv5::miUINT16; return true; }
+		case mxINT32_CLASS: { arrayClass = matv5::mxINT32; dataType = matv5::miINT32; return true; }
+		case mxUINT32_CLASS: { arrayClass = matv5::mxUINT32; dataType = matv5::miUINT32; return true; }
+		case mxINT64_CLASS: { arrayClass = matv5::mxINT64; dataType = matv5::miINT64; return true; }
+		case mxUINT64_CLASS: { arrayClass = matv5::mxUINT64; dataType = matv5::miUINT64; return true; }
+		case mxLOGICAL_CLASS: { arrayClass = matv5::mxUINT8; dataType = matv5::miUINT8; flags = matv5::FLAG_LOGICAL; return true; }
+		case mxCHAR_CLASS: { arrayClass = matv5::mxCHAR; dataType = matv5::miUINT16; return true; }
+		case mxCELL_CLASS: { arrayClass = matv5::mxCELL; return true; }
+		case mxSTRUCT_CLASS: { arrayClass = matv5::mxSTRUCT; return true; }
+		default: return false;
+	}
+}
+
+// bytes of one element, of one part of it for complex arrays
+static size_t partSize(const mxArray* array)
+{
+#if MX_HAS_INTERLEAVED_COMPLEX
+	return mxGetElementSize(array) / (mxIsComplex(array) ? 2 : 1);
+#else
+	return mxGetElementSize(array);
+#endif
+}
+
+// Matlab stores characters as UTF-16 code units, the strings of the interface are UTF-8,
+// a byte that does not start a valid sequence is taken as Latin-1 like before
+static std::vector<uint16_t> toUtf16(const std::string& value)
+{
+	std::vector<uint16_t> characters;
+	characters.reserve(value.size());
+	for (size_t i=0; i<value.size(); )
+	{
+		unsigned char lead = value[i];
+		size_t length = 1;
+		if (lead >= 0xc2 && lead < 0xe0) { length = 2; }
+		else if (lead >= 0xe0 && lead < 0xf0) { length = 3; }
+		else if (lead >= 0xf0 && lead < 0xf5) { length = 4; }
+		uint32_t codePoint = (length == 1) ? lead : (lead & (0x7f >> length));
+		for (size_t j=1; j<length; j++)
+		{
+			unsigned char next = (i+j < value.size()) ? value[i+j] : 0;
+			if ((next & 0xc0) != 0x80)
+			{
+				length = 1;
+				codePoint = lead;
+				break;
+			}
+			codePoint = (codePoint << 6) | (next & 0x3f);
+		}
+		// overlong sequences and surrogates are not valid UTF-8 either
+		if ((length == 3 && (codePoint < 0x800 || (codePoint >= 0xd800 && codePoint < 0xe000))) || (length == 4 && (codePoint < 0x10000 || codePoint > 0x10ffff)))
+		{
+			length = 1;
+			codePoint = lead;
+		}
+
+		if (codePoint >= 0x10000)
+		{
+			characters.push_back(static_cast<uint16_t>(0xd800 + ((codePoint - 0x10000) >> 10)));
+			characters.push_back(static_cast<uint16_t>(0xdc00 + ((codePoint - 0x10000) & 0x3ff)));
+		} else
+		{
+			characters.push_back(static_cast<uint16_t>(codePoint));
+		}
+		i += length;
+	}
+	return characters;
+}
+
+// all field names of a struct are stored with the length of the longest one plus a terminating zero
+static size_t fieldNameLength(const mxArray* array)
+{
+	size_t length = 0;
+	for (int i=0; i<mxGetNumberOfFields(array); i++)
+	{
+		length = std::max(length, strlen(mxGetFieldNameByNumber(array, i)));
+	}
+	return length + 1;
+}
+
+MatV5Writer::MatV5Writer() :
+	_file(NULL),
+	_numericStorage(STORE_AS_DOUBLE),
+	_bytesWritten(0)
+{}
+
+MatV5Writer::~MatV5Writer()
+{
+	close();
+}
+
+bool MatV5Writer::open(const std::string& filename)
+{
+	close();
+
+	// appended variables are grown by moving elements, which are read back
+	_file = fopen(filename.c_str(), "w+b");
+	if (!_file) { return false; }
+	_names.clear();
+
+	// large buffer, most writes of matrix data bypass it anyway
+	_fileBuffer.resize(1 << 20);
+	setvbuf(_file, &_fileBuffer[0], _IOFBF, _fileBuffer.size());
+
+	if (!writeHeader())
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MatV5Writer::close()
+{
+	if (!_file) { return false; }
+
+	// the last buffered slices, the headers are up to date afterwards
+	bool success = true;
+	for (std::map<std::string, AppendedVariable>::iterator it = _appended.begin(); it != _appended.end(); ++it)
+	{
+		success = writeAppended(it->first, it->second) && success;
+	}
+	_appended.clear();
+	success = _compressor.flush() && success;
+	success = (fclose(_file) == 0) && success;
+	_file = NULL;
+	return success;
+}
+
+bool MatV5Writer::write(const std::string& name, const bool& value, bool globalVariable)
+{
+	std::vector<uint32_t> dims(2, 1);
+	uint8_t flags = matv5::FLAG_LOGICAL | (globalVariable ? matv5::FLAG_GLOBAL : 0);
+	uint8_t data = value ? 1 : 0;
+
+	if (!beginArray(name, matv5::mxUINT8, flags, dims, matv5::miUINT8, sizeof(data))) { return false; }
+	if (!writeBytes(&data, sizeof(data))) { return abortArray(); }
+	return endArray(sizeof(data));
+}
+
+bool MatV5Writer::write(const std::string& name, const std::string& value, bool globalVariable)
+{
+	std::vector<uint16_t> characters = toUtf16(value);
+
+	// Matlab creates empty strings as 0x0 char arrays
+	std::vector<uint32_t> dims(2);
+	dims[0] = value.empty() ? 0 : 1;
+	dims[1] = static_cast<uint32_t>(characters.size());
+
+	uint64_t dataBytes = characters.size()*sizeof(uint16_t);
+	if (!beginArray(name, matv5::mxCHAR, globalVariable ? matv5::FLAG_GLOBAL : 0, dims, matv5::miUINT16, dataBytes)) { return false; }
+	if (!writeBytes(characters.data(), dataBytes)) { return abortArray(); }
+	return endArray(dataBytes);
+}
+
+bool MatV5Writer::write(const std::string& name, const mxArray* value, bool globalVariable)
+{
+	if (!_file || value == NULL) { return false; }
+
+	// Level 5 files store sizes in 32 bit, larger variables need WRITE_HDF5
+	uint64_t bytes = arrayBytes(value, name.size());
+	if (bytes == 0 || bytes > std::numeric_limits<uint32_t>::max() || !addName(name)) { return false; }
+
+	if (_compressor.level() > 0) { _compressor.begin(_file); }
+	if (!writeArray(name, value, globalVariable ? matv5::FLAG_GLOBAL : 0)) { return abortArray(); }
+	return !_compressor.isStaging() || _compressor.end();
+}
+
+MatV5Writer::AppendedVariable* MatV5Writer::beginAppend(const std::string& name, uint32_t rows, uint32_t cols,
+		uint8_t arrayClass, uint32_t dataType, uint8_t flags, size_t elementSize)
+{
+	if (!_file) { return NULL; }
+
+	std::map<std::string, AppendedVariable>::iterator it = _appended.find(name);
+	if (it == _appended.end())
+	{
+		// variables that were written as a whole cannot be extended
+		if (!addName(name)) { return NULL; }
+
+		AppendedVariable variable;
+		variable.arrayClass = arrayClass;
+		variable.dataType = dataType;
+		variable.flags = flags;
+		variable.elementSize = elementSize;
+		variable.sliceDims.push_back(rows);
+		if (cols != 1) { variable.sliceDims.push_back(cols); }
+		variable.sliceSize = uint64_t(rows)*cols;
+
+		uint64_t dimsBytes = (variable.sliceDims.size() + 1)*sizeof(uint32_t);
+		variable.headerBytes = matv5::TAG_SIZE + (matv5::TAG_SIZE + 8)
+				+ (matv5::TAG_SIZE + matv5::padded(dimsBytes))
+				+ (matv5::TAG_SIZE + matv5::padded(name.size()))
+				+ matv5::TAG_SIZE;
+
+		// an empty variable behind everything that was written so far, also the pending compressed elements
+		if (!_compressor.flush() || fseeko(_file, 0, SEEK_END) != 0) { return NULL; }
+		variable.offset = ftello(_file);
+		if (!writeAppendedHeader(name, variable)) { return NULL; }
+		it = _appended.insert(std::make_pair(name, variable)).first;
+	}
+	AppendedVariable& variable = it->second;
+
+	// all slices need the size and class of the first one
+	uint32_t sliceCols = variable.sliceDims.size() > 1 ? variable.sliceDims[1] : 1;
+	if (rows != variable.sliceDims[0] || cols != sliceCols) { return NULL; }
+	if (arrayClass != variable.arrayClass || flags != variable.flags) { return NULL; }
+
+	// stay within the 32 bit size limit of Level 5 files
+	uint64_t dataBytes = (variable.nSlices + 1)*variable.sliceSize*variable.elementSize;
+	if (variable.headerBytes - matv5::TAG_SIZE + matv5::padded(dataBytes) > std::numeric_limits<uint32_t>::max()) { return NULL; }
+
+	variable.nSlices++;
+	return &variable;
+}
+
+bool MatV5Writer::endAppend(const std::string& name, AppendedVariable& variable)
+{
+	return variable.buffer.size() < APPEND_BUFFER_SIZE || writeAppended(name, variable);
+}
+
+bool MatV5Writer::writeAppended(const std::string& name, AppendedVariable& variable)
+{
+	if (variable.buffer.empty()) { return true; }
+
+	uint64_t sliceBytes = variable.sliceSize*variable.elementSize;
+	uint64_t writtenBytes = variable.nWritten*sliceBytes;
+	uint64_t dataBytes = writtenBytes + variable.buffer.size();
+	if (matv5::padded(dataBytes) > variable.capacity && !growAppended(variable, dataBytes)) { return false; }
+
+	// the padding is only needed by the last element of the file, the others already have the room
+	uint64_t dataStart = variable.offset + variable.headerBytes;
+	bool success = fseeko(_file, dataStart + writtenBytes, SEEK_SET) == 0
+			&& writeBytes(_file, variable.buffer.data(), variable.buffer.size()) && writePadding(dataBytes);
+	if (!success)
+	{
+		fseeko(_file, 0, SEEK_END);
+		return false;
+	}
+
+	variable.nWritten += variable.buffer.size() / sliceBytes;
+	variable.buffer.clear();
+	return writeAppendedHeader(name, variable);
+}
+
+bool MatV5Writer::writeAppendedHeader(const std::string& name, const AppendedVariable& variable)
+{
+	std::vector<uint32_t> dims = variable.sliceDims;
+	dims.push_back(static_cast<uint32_t>(variable.nWritten));
+	uint64_t dimsBytes = dims.size()*sizeof(uint32_t);
+	uint64_t dataBytes = variable.nWritten*variable.sliceSize*variable.elementSize;
+	uint32_t arrayFlags[2] = { static_cast<uint32_t>(variable.arrayClass) | (static_cast<uint32_t>(variable.flags) << 8), 0 };
+
+	// all following writes go to the end of the file again
+	return fseeko(_file, variable.offset, SEEK_SET) == 0
+		&& writeTag(matv5::miMATRIX, static_cast<uint32_t>(variable.headerBytes - matv5::TAG_SIZE + variable.capacity))
+		&& writeTag(matv5::miUINT32, sizeof(arrayFlags)) && writeBytes(arrayFlags, sizeof(arrayFlags))
+		&& writeTag(matv5::miINT32, static_cast<uint32_t>(dimsBytes)) && writeBytes(dims.data(), dimsBytes) && writePadding(dimsBytes)
+		&& writeTag(matv5::miINT8, static_cast<uint32_t>(name.size())) && writeBytes(name.c_str(), name.size()) && writePadding(name.size())
+		&& writeTag(variable.dataType, static_cast<uint32_t>(dataBytes))
+		&& fseeko(_file, 0, SEEK_END) == 0;
+}
+
+bool MatV5Writer::growAppended(AppendedVariable& variable, uint64_t dataBytes)
+{
+	// Level 5 files store sizes in 32 bit
+	uint64_t maxCapacity = (std::numeric_limits<uint32_t>::max() - (variable.headerBytes - matv5::TAG_SIZE)) & ~uint64_t(7);
+	uint64_t capacity = matv5::padded(dataBytes);
+	if (capacity > maxCapacity) { return false; }
+
+	// compressed elements are completed first, they cannot be moved while they are written
+	if (!_compressor.flush() || fseeko(_file, 0, SEEK_END) != 0) { return false; }
+	uint64_t fileEnd = ftello(_file);
+	uint64_t dataStart = variable.offset + variable.headerBytes;
+	uint64_t begin = dataStart + variable.capacity;
+
+	// the last element grows with the file
+	if (begin >= fileEnd)
+	{
+		variable.capacity = capacity;
+		return true;
+	}
+
+	// otherwise room for as many slices again, the elements in the way go to the end of the file
+	capacity = std::min(std::max(capacity, 2*variable.capacity), maxCapacity);
+	uint64_t end = begin;
+	while (end < dataStart + capacity && end < fileEnd)
+	{
+		uint64_t bytes = elementBytes(end);
+		if (bytes == 0) { return false; }
+		end += bytes;
+	}
+	if (end - dataStart > maxCapacity) { return false; }
+
+	uint64_t destination = std::max(fileEnd, dataStart + capacity);
+	if (!moveBytes(begin, end, destination)) { return false; }
+	for (std::map<std::string, AppendedVariable>::iterator it = _appended.begin(); it != _appended.end(); ++it)
+	{
+		if (it->second.offset >= begin && it->second.offset < end) { it->second.offset += destination - begin; }
+	}
+
+	// until the header is patched the moved elements are still in place as well
+	variable.capacity = std::max(capacity, end - dataStart);
+	return true;
+}
+
+uint64_t MatV5Writer::elementBytes(uint64_t offset)
+{
+	uint32_t tag[2];
+	if (fseeko(_file, offset, SEEK_SET) != 0 || fread(tag, 1, sizeof(tag), _file) != sizeof(tag)) { return 0; }
+
+	// compressed elements are not padded
+	return matv5::TAG_SIZE + ((tag[0] == matv5::miCOMPRESSED) ? tag[1] : matv5::padded(tag[1]));
+}
+
+bool MatV5Writer::moveBytes(uint64_t begin, uint64_t end, uint64_t destination)
+{
+	std::vector<char> chunk(std::min<uint64_t>(MOVE_CHUNK_SIZE, end - begin));
+	for (uint64_t offset = begin; offset < end; offset += chunk.size())
+	{
+		size_t n = std::min<uint64_t>(chunk.size(), end - offset);
+		if (fseeko(_file, offset, SEEK_SET) != 0 || fread(chunk.data(), 1, n, _file) != n) { return false; }
+		if (fseeko(_file, destination + (offset - begin), SEEK_SET) != 0 || !writeBytes(_file, chunk.data(), n)) { return false; }
+	}
+	return fseeko(_file, 0, SEEK_END) == 0;
+}
+
+bool MatV5Writer::writeHeader()
+{
+	char header[matv5::HEADER_SIZE];
+	memset(header, ' ', 116);
+	memset(&header[116], 0, 8);
+
+	time_t now = time(NULL);
+	char date[64];
+	strftime(date, sizeof(date), "%a %b %d %H:%M:%S %Y", localtime(&now));
+	std::string text = std::string("MATLAB 5.0 MAT-file, Platform: GLNXA64, Created on: ") + date;
+	memcpy(header, text.c_str(), std::min<size_t>(text.size(), 116));
+
+	// version and endian indicator, written in native byte order
+	uint16_t version = 0x0100;
+	uint16_t endian = ('M' << 8) | 'I';
+	memcpy(&header[124], &version, sizeof(version));
+	memcpy(&header[126], &endian, sizeof(endian));
+
+	return writeBytes(header, sizeof(header));
+}
+
+bool MatV5Writer::beginArray(const std::string& name, uint8_t arrayClass, uint8_t flags,
+		const std::vector<uint32_t>& dims, uint32_t dataType, uint64_t dataBytes)
+{
+	if (!_file) { return false; }
+
+	uint64_t dimsBytes = dims.size()*sizeof(uint32_t);
+	uint64_t arrayBytes = (matv5::TAG_SIZE + 8)
+			+ (matv5::TAG_SIZE + matv5::padded(dimsBytes))
+			+ (matv5::TAG_SIZE + matv5::padded(name.size()))
+			+ (matv5::TAG_SIZE + matv5::padded(dataBytes));
+
+	// Level 5 files store sizes in 32 bit, larger variables need WRITE_HDF5
+	if (arrayBytes > std::numeric_limits<uint32_t>::max() || !addName(name)) { return false; }
+
+	uint32_t arrayFlags[2] = { static_cast<uint32_t>(arrayClass) | (static_cast<uint32_t>(flags) << 8), 0 };
+
+	// the whole miMATRIX element goes into the compressed element
+	if (_compressor.level() > 0) { _compressor.begin(_file); }
+
+	bool success = writeTag(matv5::miMATRIX, static_cast<uint32_t>(arrayBytes))
+		&& writeTag(matv5::miUINT32, sizeof(arrayFlags)) && writeBytes(arrayFlags, sizeof(arrayFlags))
+		&& writeTag(matv5::miINT32, static_cast<uint32_t>(dimsBytes)) && writeBytes(dims.data(), dimsBytes) && writePadding(dimsBytes)
+		&& writeTag(matv5::miINT8, static_cast<uint32_t>(name.size())) && writeBytes(name.c_str(), name.size()) && writePadding(name.size())
+		&& writeTag(dataType, static_cast<uint32_t>(dataBytes));
+	return success || abortArray();
+}
+
+bool MatV5Writer::endArray(uint64_t dataBytes)
+{
+	if (!writePadding(dataBytes)) { return abortArray(); }
+	return !_compressor.isStaging() || _compressor.end();
+}
+
+bool MatV5Writer::abortArray()
+{
+	// the element stays truncated like an uncompressed one
+	if (_compressor.isStaging()) { _compressor.end(); }
+	return false;
+}
+
+uint64_t MatV5Writer::arrayBytes(const mxArray* array, size_t nameLength)
+{
+	// unset fields and cells are written as empty double matrices
+	size_t nDims = (array == NULL) ? 2 : mxGetNumberOfDimensions(array);
+	uint64_t dimsBytes = nDims*sizeof(uint32_t);
+	uint64_t bytes = (matv5::TAG_SIZE + 8)
+			+ (matv5::TAG_SIZE + matv5::padded(dimsBytes))
+			+ (matv5::TAG_SIZE + matv5::padded(nameLength));
+	if (array == NULL) { return bytes + matv5::TAG_SIZE; }
+
+	uint8_t arrayClass, flags;
+	uint32_t dataType;
+	if (!arrayStorage(array, arrayClass, dataType, flags)) { return 0; }
+	for (size_t i=0; i<nDims; i++)
+	{
+		if (mxGetDimensions(array)[i] > std::numeric_limits<uint32_t>::max()) { return 0; }
+	}
+
+	if (arrayClass == matv5::mxSPARSE)
+	{
+		uint64_t nCols = mxGetN(array);
+		uint64_t nonZeros = mxGetJc(array)[nCols];
+		return bytes + (matv5::TAG_SIZE + matv5::padded(nonZeros*sizeof(int32_t)))
+				+ (matv5::TAG_SIZE + matv5::padded((nCols + 1)*sizeof(int32_t)))
+				+ (matv5::TAG_SIZE + matv5::padded(nonZeros*sizeof(double)));
+	}
+
+	size_t n = mxGetNumberOfElements(array);
+	if (arrayClass == matv5::mxCELL)
+	{
+		for (size_t i=0; i<n; i++)
+		{
+			uint64_t cellBytes = arrayBytes(mxGetCell(array, i), 0);
+			if (cellBytes == 0) { return 0; }
+			bytes += matv5::TAG_SIZE + cellBytes;
+		}
+		return bytes;
+	}
+
+	if (arrayClass == matv5::mxSTRUCT)
+	{
+		// the field name length is a small data element
+		int nFields = mxGetNumberOfFields(array);
+		bytes += matv5::TAG_SIZE + (matv5::TAG_SIZE + matv5::padded(nFields*fieldNameLength(array)));
+		for (size_t i=0; i<n; i++)
+		{
+			for (int field=0; field<nFields; field++)
+			{
+				uint64_t fieldBytes = arrayBytes(mxGetFieldByNumber(array, i, field), 0);
+				if (fieldBytes == 0) { return 0; }
+				bytes += matv5::TAG_SIZE + fieldBytes;
+			}
+		}
+		return bytes;
+	}
+
+	uint64_t partBytes = matv5::TAG_SIZE + matv5::padded(uint64_t(n)*partSize(array));
+	return bytes + (mxIsComplex(array) ? 2*partBytes : partBytes);
+}
+
+bool MatV5Writer::writeArray(const std::string& name, const mxArray* array, uint8_t flags)
+{
+	uint8_t arrayClass = matv5::mxDOUBLE, arrayFlags = 0;
+	uint32_t dataType = matv5::miDOUBLE;
+	std::vector<uint32_t> dims(2, 0);
+	if (array != NULL)
+	{
+		arrayStorage(array, arrayClass, dataType, arrayFlags);
+		dims.assign(mxGetDimensions(array), mxGetDimensions(array) + mxGetNumberOfDimensions(array));
+	}
+
+	// the second word holds the number of non-zeros of sparse matrices
+	uint32_t flagsData[2] = { static_cast<uint32_t>(arrayClass) | (static_cast<uint32_t>(arrayFlags | flags) << 8), 0 };
+	if (arrayClass == matv5::mxSPARSE) { flagsData[1] = static_cast<uint32_t>(mxGetJc(array)[mxGetN(array)]); }
+	uint64_t dimsBytes = dims.size()*sizeof(uint32_t);
+	bool success = writeTag(matv5::miMATRIX, static_cast<uint32_t>(arrayBytes(array, name.size())))
+		&& writeTag(matv5::miUINT32, sizeof(flagsData)) && writeBytes(flagsData, sizeof(flagsData))
+		&& writeTag(matv5::miINT32, static_cast<uint32_t>(dimsBytes)) && writeBytes(dims.data(), dimsBytes) && writePadding(dimsBytes)
+		&& writeTag(matv5::miINT8, static_cast<uint32_t>(name.size())) && writeBytes(name.c_str(), name.size()) && writePadding(name.size());
+	if (!success) { return false; }
+	if (array == NULL) { return writeTag(matv5::miDOUBLE, 0); }
+
+	if (arrayClass == matv5::mxSPARSE)
+	{
+		size_t nCols = mxGetN(array);
+		const mwIndex* columns = mxGetJc(array);
+		uint64_t nonZeros = columns[nCols];
+		return writeTag(matv5::miINT32, static_cast<uint32_t>(nonZeros*sizeof(int32_t)))
+			&& writeAs<int32_t>(_file, mxGetIr(array), nonZeros) && writePadding(nonZeros*sizeof(int32_t))
+			&& writeTag(matv5::miINT32, static_cast<uint32_t>((nCols + 1)*sizeof(int32_t)))
+			&& writeAs<int32_t>(_file, columns, nCols + 1) && writePadding((nCols + 1)*sizeof(int32_t))
+			&& writeTag(matv5::miDOUBLE, static_cast<uint32_t>(nonZeros*sizeof(double)))
+			&& writeBytes(mxGetPr(array), nonZeros*sizeof(double)) && writePadding(nonZeros*sizeof(double));
+	}
+
+	size_t n = mxGetNumberOfElements(array);
+	if (arrayClass == matv5::mxCELL)
+	{
+		for (size_t i=0; i<n && success; i++) { success = writeArray("", mxGetCell(array, i), 0); }
+		return success;
+	}
+
+	if (arrayClass == matv5::mxSTRUCT)
+	{
+		int nFields = mxGetNumberOfFields(array);
+		uint32_t length = static_cast<uint32_t>(fieldNameLength(array));
+		uint32_t lengthElement[2] = { matv5::miINT32 | (sizeof(uint32_t) << 16), length };
+
+		std::vector<char> names(nFields*length, 0);
+		for (int field=0; field<nFields; field++)
+		{
+			const char* fieldName = mxGetFieldNameByNumber(array, field);
+			memcpy(&names[field*length], fieldName, strlen(fieldName));
+		}
+
+		success = writeBytes(lengthElement, sizeof(lengthElement))
+			&& writeTag(matv5::miINT8, static_cast<uint32_t>(names.size())) && writeBytes(names.data(), names.size()) && writePadding(names.size());
+		for (size_t i=0; i<n && success; i++)
+		{
+			for (int field=0; field<nFields && success; field++) { success = writeArray("", mxGetFieldByNumber(array, i, field), 0); }
+		}
+		return success;
+	}
+
+	uint64_t dataBytes = uint64_t(n)*partSize(array);
+	if (!mxIsComplex(array))
+	{
+		return writeTag(dataType, static_cast<uint32_t>(dataBytes)) && writeBytes(mxGetData(array), dataBytes) && writePadding(dataBytes);
+	}
+	return writeTag(dataType, static_cast<uint32_t>(dataBytes)) && writeComplexPart(array, false) && writePadding(dataBytes)
+		&& writeTag(dataType, static_cast<uint32_t>(dataBytes)) && writeComplexPart(array, true) && writePadding(dataBytes);
+}
+
+bool MatV5Writer::writeComplexPart(const mxArray* array, bool imaginary)
+{
+	size_t n = mxGetNumberOfElements(array);
+	size_t size = partSize(array);
+#if MX_HAS_INTERLEAVED_COMPLEX
+	// the parts alternate, each one is gathered in chunks
+	const char* data = static_cast<const char*>(mxGetData(array)) + (imaginary ? size : 0);
+	char buffer[CONVERSION_CHUNK_SIZE*sizeof(double)];
+	for (size_t i=0; i<n; i+=CONVERSION_CHUNK_SIZE)
+	{
+		size_t chunk = std::min<size_t>(CONVERSION_CHUNK_SIZE, n-i);
+		for (size_t j=0; j<chunk; j++) { memcpy(&buffer[j*size], &data[(i+j)*2*size], size); }
+		if (!writeBytes(buffer, chunk*size)) { return false; }
+	}
+	return true;
+#else
+	return writeBytes(imaginary ? mxGetImagData(array) : mxGetData(array), n*size);
+#endif
+}
+
+bool MatV5Writer::writeTag(uint32_t dataType, uint32_t nBytes)
+{
+	uint32_t tag[2] = { dataType, nBytes };
+	return writeBytes(tag, sizeof(tag));
+}
+
+bool MatV5Writer::writeBytes(const void* data, size_t nBytes)
+{
+	return writeBytes(_file, data, nBytes);
+}
+
+bool MatV5Writer::writeBytes(FILE* file, const void* data, size_t nBytes)
+{
+	if (nBytes == 0) { return true; }
+	if (file == _file && _compressor.isStaging()) { return _compressor.stage(data, nBytes); }
+	size_t written = fwrite(data, 1, nBytes, file);
+	_bytesWritten += written;
+	return written == nBytes;
+}
+
+bool MatV5Writer::writeBytes(std::vector<char>* buffer, const void* data, size_t nBytes)
+{
+	const char* bytes = static_cast<const char*>(data);
+	buffer->insert(buffer->end(), bytes, bytes + nBytes);
+	return true;
+}
+
+bool MatV5Writer::writePadding(uint64_t nBytes)
+{
+	static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	return writeBytes(zeros, matv5::padded(nBytes) - nBytes);
+}
+
+} // namespace matlab
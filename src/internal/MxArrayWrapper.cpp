@@ -10,15 +10,10 @@
 namespace matlab {
 
 
-void convertFromScalar(const double& value, mxArray* &mxArray)
-{
-	mxArray = mxCreateDoubleScalar(value);
-}
-
-template<> void MxArrayWrapper<double>::convertFrom(const double& content) { convertFromScalar(static_cast<double>(content), _mxArray); }
-template<> void MxArrayWrapper<float>::convertFrom(const float& content) { convertFromScalar(static_cast<double>(content), _mxArray); }
-template<> void MxArrayWrapper<int>::convertFrom(const int& content) { convertFromScalar(static_cast<double>(content), _mxArray); }
-template<> void MxArrayWrapper<size_t>::convertFrom(const size_t& content) { convertFromScalar(static_cast<double>(content), _mxArray); }
+template<> void MxArrayWrapper<double>::convertFrom(const double& content) { convertFromScalar(content, _numericStorage, _mxArray); }
+template<> void MxArrayWrapper<float>::convertFrom(const float& content) { convertFromScalar(content, _numericStorage, _mxArray); }
+template<> void MxArrayWrapper<int>::convertFrom(const int& content) { convertFromScalar(content, _numericStorage, _mxArray); }
+template<> void MxArrayWrapper<size_t>::convertFrom(const size_t& content) { convertFromScalar(content, _numericStorage, _mxArray); }
 
 template<> void MxArrayWrapper<bool>::convertFrom(const bool& content)
 {
@@ -27,7 +22,7 @@ template<> void MxArrayWrapper<bool>::convertFrom(const bool& content)
 
 template<> void MxArrayWrapper<std::string>::convertFrom(const std::string& content)
 {
-	_mxArray = mxCreateString(content.c_str());
+	_mxArray = createCharRow(content);
 }
 
 template<> void MxArrayWrapper<Eigen::MatrixXd>::convertTo(Eigen::MatrixXd& content)
@@ -41,10 +36,8 @@ template<> void MxArrayWrapper<Eigen::MatrixXd>::convertTo(Eigen::MatrixXd& cont
 
 	content.resize(rows, cols);
 
-	void* _mxArrayData = mxGetData(_mxArray);
-
-	if(sizeof(content(0,0)) != mxGetElementSize(_mxArray)) throw std::runtime_error("Datatype does not match");
-	std::memcpy(content.data(), _mxArrayData, mxGetElementSize(_mxArray)*mxGetNumberOfElements(_mxArray));
+	// converts if the variable is not stored as double
+	copyFromMxArray(_mxArray, 0, content.size(), content.data());
 }
 
 template<> void MxArrayWrapper<Eigen::VectorXd>::convertTo(Eigen::VectorXd& content)
@@ -60,29 +53,16 @@ template<> void MxArrayWrapper<Eigen::VectorXd>::convertTo(Eigen::VectorXd& cont
 
 	content.resize(std::max(rows, cols));
 
-	void* _mxArrayData = mxGetData(_mxArray);
-
-	if(sizeof(content(0)) != mxGetElementSize(_mxArray)) throw std::runtime_error("Datatype does not match");
-	std::memcpy(content.data(), _mxArrayData, mxGetElementSize(_mxArray)*mxGetNumberOfElements(_mxArray));
+	// converts if the variable is not stored as double
+	copyFromMxArray(_mxArray, 0, content.size(), content.data());
 }
 
 
-// General template for scalars
-double convertToScalar(const mxArray* mxArray)
-{
-	// Check type
-	if(!mxIsNumeric(mxArray)) throw std::runtime_error("Variable is not numeric (normally scalars are stored as doubles in Matlab)");
-	if(mxIsEmpty(mxArray)) throw std::runtime_error("Variable is empty!");
-	if(mxGetNumberOfElements(mxArray) != 1) throw std::runtime_error("Variable is not a scalar (has more than 1 element)");
-
-	// read data
-	return mxGetScalar(mxArray);
-}
 // explicit template deduction
-template<> void MxArrayWrapper<double>::convertTo(double& content) { content = convertToScalar(_mxArray); }
-template<> void MxArrayWrapper<float>::convertTo(float& content) { content = static_cast<float>(convertToScalar(_mxArray)); }
-template<> void MxArrayWrapper<int>::convertTo(int& content) { content = static_cast<int>(convertToScalar(_mxArray)); }
-template<> void MxArrayWrapper<size_t>::convertTo(size_t& content) { content = static_cast<size_t>(convertToScalar(_mxArray)); }
+template<> void MxArrayWrapper<double>::convertTo(double& content) { content = convertToScalar<double>(_mxArray); }
+template<> void MxArrayWrapper<float>::convertTo(float& content) { content = convertToScalar<float>(_mxArray); }
+template<> void MxArrayWrapper<int>::convertTo(int& content) { content = convertToScalar<int>(_mxArray); }
+template<> void MxArrayWrapper<size_t>::convertTo(size_t& content) { content = convertToScalar<size_t>(_mxArray); }
 
 template<> void MxArrayWrapper<bool>::convertTo(bool& content)
 {
@@ -97,17 +77,8 @@ template<> void MxArrayWrapper<bool>::convertTo(bool& content)
 
 template<> void MxArrayWrapper<std::string>::convertTo(std::string& content)
 {
-	// Check type
-	if(mxIsEmpty(_mxArray)) throw std::runtime_error("Variable is empty!");
-	if(!mxIsChar(_mxArray)) throw std::runtime_error("Variable is not a character/string");
-
-	// read data
-	// lenght + 1 because of 0 terminated string
-	size_t lenght = mxGetNumberOfElements(_mxArray)+1;
-	char* buffer = new char[lenght];
-	buffer[lenght-1] = '\0';
-	mxGetString(_mxArray, buffer, lenght);
-	content = buffer;
+	// decoded straight into the storage of content
+	convertToString(_mxArray, content);
 }
 
 
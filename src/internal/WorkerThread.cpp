@@ -0,0 +1,67 @@
+/*
+ * WorkerThread.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <matlabCppInterface/internal/WorkerThread.hpp>
+
+namespace matlab {
+
+WorkerThread::WorkerThread() :
+	_busy(false),
+	_stopping(false)
+{}
+
+WorkerThread::~WorkerThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_taskAvailable.notify_one();
+
+	if (_thread.joinable()) { _thread.join(); }
+}
+
+void WorkerThread::waitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle.wait(lock, [this]() { return _tasks.empty() && !_busy; });
+}
+
+bool WorkerThread::isIdle()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _tasks.empty() && !_busy;
+}
+
+void WorkerThread::start()
+{
+	_thread = std::thread(&WorkerThread::run, this);
+}
+
+void WorkerThread::run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true)
+	{
+		_taskAvailable.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+		// the queue is drained before stopping
+		if (_tasks.empty()) { return; }
+
+		std::function<void()> task = _tasks.front();
+		_tasks.pop_front();
+		_busy = true;
+
+		lock.unlock();
+		task();
+		lock.lock();
+
+		_busy = false;
+		if (_tasks.empty()) { _idle.notify_all(); }
+	}
+}
+
+} // namespace matlab
@@ -0,0 +1,84 @@
+/*
+ * BenchmarkReport.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef BENCHMARKREPORT_HPP_
+#define BENCHMARKREPORT_HPP_
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// one measured operation, all per call values are averages
+struct BenchmarkResult
+{
+	BenchmarkResult() :
+		elements(0), bytes(0), repetitions(0), microseconds(0.0), arrays(-1.0), allocations(-1.0), bytesAllocated(-1.0)
+	{}
+
+	std::string suite;
+	std::string name;
+	std::string operation;
+	size_t elements;
+	size_t bytes; // payload moved by one call
+	size_t repetitions;
+	double microseconds; // per call
+	double arrays; // mxArrays created per call, negative if not counted
+	double allocations; // data buffers allocated per call, negative if not counted
+	double bytesAllocated; // per call, negative if not counted
+
+	double megabytesPerSecond() const { return (microseconds > 0.0) ? bytes / microseconds : 0.0; }
+};
+
+///
+/// @class BenchmarkReport
+/// @brief collects benchmark results, prints them and writes them as csv for scripts
+///
+class BenchmarkReport
+{
+public:
+	// suites that print their own summary only record the result
+	void add(const BenchmarkResult& result, bool print = true)
+	{
+		if (print) { printResult(result); }
+		_results.push_back(result);
+	}
+
+	static void printResult(const BenchmarkResult& result)
+	{
+		std::cout<<result.suite<<" "<<result.name<<" "<<result.operation<<": "<<result.microseconds<<"us";
+		if (result.bytes > 0) { std::cout<<", "<<result.megabytesPerSecond()<<"MB/s"; }
+		if (result.arrays >= 0.0) { std::cout<<", "<<result.arrays<<" arrays, "<<result.allocations<<" allocations, "<<result.bytesAllocated<<" bytes"; }
+		std::cout<<std::endl;
+	}
+
+	const std::vector<BenchmarkResult>& results() const { return _results; }
+
+	bool writeCsv(const std::string& fileName) const
+	{
+		std::ofstream file(fileName.c_str());
+		if (!file.good())
+		{
+			std::cout<<"Could not open "<<fileName<<" to write the benchmark results"<<std::endl;
+			return false;
+		}
+
+		file<<"suite,name,operation,elements,bytes,repetitions,us_per_call,mb_per_s,arrays_per_call,allocations_per_call,bytes_allocated_per_call"<<std::endl;
+		for (size_t i=0; i<_results.size(); i++)
+		{
+			const BenchmarkResult& result = _results[i];
+			file<<result.suite<<","<<result.name<<","<<result.operation<<","<<result.elements<<","<<result.bytes<<","
+					<<result.repetitions<<","<<result.microseconds<<","<<result.megabytesPerSecond()<<","
+					<<result.arrays<<","<<result.allocations<<","<<result.bytesAllocated<<std::endl;
+		}
+		return file.good();
+	}
+
+private:
+	std::vector<BenchmarkResult> _results;
+};
+
+#endif /* BENCHMARKREPORT_HPP_ */
@@ -0,0 +1,226 @@
+/*
+ * ConversionBenchmarks.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef CONVERSIONBENCHMARKS_HPP_
+#define CONVERSIONBENCHMARKS_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include <matlabCppInterface/internal/MxArrayWrapper.hpp>
+#include <matlabCppInterface/internal/MxArrayNDimWrapper.hpp>
+
+#include <BenchmarkReport.hpp>
+
+// returns the average time of a call to function in microseconds
+template <typename Function>
+double measure(size_t repetitions, Function function)
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (size_t i=0; i<repetitions; i++)
+	{
+		function();
+	}
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+}
+
+// measures function and, when built against the libmx stand-in, the mxArrays and buffers it allocates
+template <typename Function>
+void measureConversion(BenchmarkReport& report, const std::string& suite, const std::string& name, const std::string& operation,
+		size_t elements, size_t bytes, size_t repetitions, Function function)
+{
+	BenchmarkResult result;
+	result.suite = suite;
+	result.name = name;
+	result.operation = operation;
+	result.elements = elements;
+	result.bytes = bytes;
+	result.repetitions = repetitions;
+
+	// warm up caches and the allocator
+	function();
+
+#ifdef MX_STANDIN
+	mxStandInResetStatistics();
+#endif
+	result.microseconds = measure(repetitions, function);
+#ifdef MX_STANDIN
+	mxStandInStatistics statistics = mxStandInGetStatistics();
+	result.arrays = static_cast<double>(statistics.arraysCreated) / repetitions;
+	result.allocations = static_cast<double>(statistics.allocations) / repetitions;
+	result.bytesAllocated = static_cast<double>(statistics.bytesAllocated) / repetitions;
+#endif
+
+	report.add(result);
+}
+
+// enough repetitions to move about 10M elements per measurement
+size_t repetitionsFor(size_t elements)
+{
+	return std::max<size_t>(10, std::min<size_t>(100000, 10000000 / std::max<size_t>(elements, 1)));
+}
+
+template <typename Scalar>
+void benchmarkScalarConversion(BenchmarkReport& report, const std::string& name)
+{
+	Scalar value = static_cast<Scalar>(42);
+	Scalar result = 0;
+	size_t repetitions = 1000000;
+
+	measureConversion(report, "scalar", name, "put", 1, sizeof(Scalar), repetitions, [&]() { matlab::MxArrayWrapper<Scalar> wrapper(value); });
+	measureConversion(report, "scalar", name, "put_native", 1, sizeof(Scalar), repetitions, [&]() { matlab::MxArrayWrapper<Scalar> wrapper(value, matlab::STORE_NATIVE); });
+
+	matlab::MxArrayWrapper<Scalar> wrapper(value);
+	measureConversion(report, "scalar", name, "get", 1, sizeof(Scalar), repetitions, [&]() { wrapper.get(result); });
+
+	assert(result == value);
+}
+
+void benchmarkScalarConversions(BenchmarkReport& report)
+{
+	std::cout<<"Benchmarking conversion of scalars"<<std::endl;
+	benchmarkScalarConversion<double>(report, "double");
+	benchmarkScalarConversion<float>(report, "float");
+	benchmarkScalarConversion<int>(report, "int");
+	benchmarkScalarConversion<size_t>(report, "size_t");
+	benchmarkScalarConversion<bool>(report, "bool");
+}
+
+template <typename ContentType>
+void benchmarkEigenConversion(BenchmarkReport& report, const std::string& name, size_t rows, size_t cols)
+{
+	ContentType content = ContentType::Random(rows, cols);
+	ContentType result;
+	size_t elements = rows*cols;
+	size_t bytes = elements*sizeof(typename ContentType::Scalar);
+	size_t repetitions = repetitionsFor(elements);
+
+	std::ostringstream label;
+	label<<name<<"_"<<rows<<"x"<<cols;
+
+	measureConversion(report, "eigen", label.str(), "put", elements, bytes, repetitions, [&]() { matlab::MxArrayWrapper<ContentType> wrapper(content); });
+
+	matlab::MxArrayWrapper<ContentType> wrapper(content);
+	measureConversion(report, "eigen", label.str(), "get", elements, bytes, repetitions, [&]() { wrapper.get(result); });
+
+	assert(result == content);
+}
+
+void benchmarkEigenConversions(BenchmarkReport& report)
+{
+	std::cout<<"Benchmarking conversion of Eigen matrices and vectors"<<std::endl;
+	for (size_t n=1; n<=1000; n*=10)
+	{
+		benchmarkEigenConversion<Eigen::MatrixXd>(report, "MatrixXd", n, n);
+	}
+	for (size_t n=1; n<=1000000; n*=10)
+	{
+		benchmarkEigenConversion<Eigen::VectorXd>(report, "VectorXd", n, 1);
+	}
+}
+
+template <typename Scalar>
+void benchmarkScalarVectorConversion(BenchmarkReport& report, const std::string& name, size_t n)
+{
+	std::vector<Scalar> content(n);
+	for (size_t i=0; i<n; i++) { content[i] = static_cast<Scalar>(i % 100); }
+	std::vector<Scalar> result;
+	size_t repetitions = repetitionsFor(n);
+
+	std::ostringstream label;
+	label<<name<<"_"<<n;
+
+	measureConversion(report, "std_vector", label.str(), "put", n, n*sizeof(Scalar), repetitions, [&]() { matlab::MxArrayNDimWrapper<Scalar, std::allocator<Scalar> > wrapper(content); });
+	measureConversion(report, "std_vector", label.str(), "put_native", n, n*sizeof(Scalar), repetitions, [&]() { matlab::MxArrayNDimWrapper<Scalar, std::allocator<Scalar> > wrapper(content, matlab::STORE_NATIVE); });
+
+	matlab::MxArrayNDimWrapper<Scalar, std::allocator<Scalar> > wrapper(content);
+	measureConversion(report, "std_vector", label.str(), "get", n, n*sizeof(Scalar), repetitions, [&]() { result.clear(); wrapper.get(result); });
+
+	assert(result == content);
+}
+
+void benchmarkScalarVectorConversions(BenchmarkReport& report)
+{
+	std::cout<<"Benchmarking conversion of std::vector of scalars"<<std::endl;
+	for (size_t n=10; n<=1000000; n*=100)
+	{
+		benchmarkScalarVectorConversion<double>(report, "double", n);
+		benchmarkScalarVectorConversion<float>(report, "float", n);
+		benchmarkScalarVectorConversion<int>(report, "int", n);
+	}
+}
+
+// the conversion as it was done before slices were cast in place, used as reference
+template <typename ContentType, typename AllocatorType>
+mxArray* referenceConvertFrom(const std::vector<ContentType, AllocatorType>& content)
+{
+	size_t dims[3] = { static_cast<size_t>(content[0].rows()), static_cast<size_t>(content[0].cols()), content.size() };
+	mxArray* array = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+	for (size_t i=0; i<content.size(); i++)
+	{
+		Eigen::MatrixXd matrix = content[i].template cast<double>();
+		double* mxArrayData = mxGetPr(array);
+		memcpy(&mxArrayData[i*matrix.size()], matrix.data(), matrix.size()*sizeof(double));
+	}
+	return array;
+}
+
+template <typename ContentType, typename AllocatorType>
+void referenceConvertTo(mxArray* array, std::vector<ContentType, AllocatorType>& content)
+{
+	const size_t* dims = mxGetDimensions(array);
+	content.resize(dims[2]);
+	Eigen::MatrixXd matrix(dims[0], dims[1]);
+	for (size_t i=0; i<content.size(); i++)
+	{
+		double* mxArrayData = mxGetPr(array);
+		memcpy(matrix.data(), &mxArrayData[i*matrix.size()], matrix.size()*sizeof(double));
+		content[i] = matrix.cast<typename ContentType::Scalar>();
+	}
+}
+
+template <typename ContentType, typename AllocatorType>
+void benchmarkNDimConversion(BenchmarkReport& report, const std::string& name, size_t nSlices, size_t repetitions)
+{
+	std::vector<ContentType, AllocatorType> content(nSlices, ContentType::Random());
+	std::vector<ContentType, AllocatorType> result;
+	size_t elements = nSlices*ContentType::SizeAtCompileTime;
+	size_t bytes = elements*sizeof(typename ContentType::Scalar);
+
+	std::ostringstream label;
+	label<<name<<"_x"<<nSlices;
+
+	measureConversion(report, "std_vector_eigen", label.str(), "put_reference", elements, bytes, repetitions, [&]() { mxDestroyArray(referenceConvertFrom(content)); });
+	measureConversion(report, "std_vector_eigen", label.str(), "put", elements, bytes, repetitions, [&]() { matlab::MxArrayNDimWrapper<ContentType, AllocatorType> wrapper(content); });
+
+	matlab::MxArrayNDimWrapper<ContentType, AllocatorType> wrapper(content);
+	measureConversion(report, "std_vector_eigen", label.str(), "get_reference", elements, bytes, repetitions, [&]() { result.clear(); referenceConvertTo(wrapper.mxArrayPtr(), result); });
+	measureConversion(report, "std_vector_eigen", label.str(), "get", elements, bytes, repetitions, [&]() { result.clear(); wrapper.get(result); });
+
+	assert(result == content);
+}
+
+void benchmarkNDimConversions(BenchmarkReport& report)
+{
+	std::cout<<"Benchmarking conversion of std::vector<Eigen> (reference and current)"<<std::endl;
+	benchmarkNDimConversion<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d> >(report, "Matrix3d", 100000, 10);
+	benchmarkNDimConversion<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >(report, "Matrix4d", 100000, 10);
+	benchmarkNDimConversion<Eigen::Vector3f, Eigen::aligned_allocator<Eigen::Vector3f> >(report, "Vector3f", 100000, 10);
+	benchmarkNDimConversion<Eigen::Matrix<double, 100, 100>, Eigen::aligned_allocator<Eigen::Matrix<double, 100, 100> > >(report, "Matrix100d", 1000, 5);
+}
+
+void benchmarkConversions(BenchmarkReport& report)
+{
+	benchmarkScalarConversions(report);
+	benchmarkEigenConversions(report);
+	benchmarkScalarVectorConversions(report);
+	benchmarkNDimConversions(report);
+}
+
+#endif /* CONVERSIONBENCHMARKS_HPP_ */
@@ -0,0 +1,93 @@
+/*
+ * EngineBenchmarks.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef ENGINEBENCHMARKS_HPP_
+#define ENGINEBENCHMARKS_HPP_
+
+#include <sstream>
+
+#include <matlabCppInterface/Engine.hpp>
+#include <matlabCppInterface/LoopbackBackend.hpp>
+
+#include <ConversionBenchmarks.hpp>
+#include <TestStructs.hpp>
+
+// the full put -> evaluate -> get path, on the in-process loopback backend
+void benchmarkLoopbackEngine(BenchmarkReport& report)
+{
+	std::cout<<"Benchmarking put, evaluate and get on a loopback engine"<<std::endl;
+
+	matlab::Engine engine(std::unique_ptr<matlab::EngineBackend>(new matlab::LoopbackBackend()));
+	engine.initialize();
+
+	std::string output;
+	for (size_t n=1; n<=1000000; n*=100)
+	{
+		Eigen::VectorXd x = Eigen::VectorXd::Random(n);
+		Eigen::VectorXd y;
+		size_t bytes = n*sizeof(double);
+		size_t repetitions = repetitionsFor(n);
+
+		std::ostringstream label;
+		label<<"VectorXd_"<<n;
+
+		measureConversion(report, "engine_loopback", label.str(), "put", n, bytes, repetitions, [&]() { engine.put("x", x); });
+		measureConversion(report, "engine_loopback", label.str(), "evaluate_copy", n, bytes, repetitions, [&]() { engine.executeCommand("y = x;", output); });
+		measureConversion(report, "engine_loopback", label.str(), "get", n, bytes, repetitions, [&]() { engine.get("y", y); });
+		measureConversion(report, "engine_loopback", label.str(), "put_evaluate_get", n, bytes, repetitions, [&]()
+		{
+			engine.put("x", x);
+			engine.executeCommand("y = 2*x + 1;", output);
+			engine.get("y", y);
+		});
+	}
+
+	// the cost of the statistics on the smallest calls
+	double value = 1.0;
+	for (int enabled=0; enabled<2; enabled++)
+	{
+		engine.statistics().setEnabled(enabled != 0);
+		measureConversion(report, "engine_loopback", "double", enabled ? "put_get_statistics_on" : "put_get_statistics_off", 1, sizeof(double), repetitionsFor(1), [&]()
+		{
+			engine.put("v", value);
+			engine.get("v", value);
+		});
+	}
+	engine.statistics().setEnabled(false);
+
+	// a reflected struct in one transfer against a transfer per field
+	TestConfig config = createTestConfig(1);
+	size_t fields = matlab::StructLayout<TestConfig>::get().names().size();
+	measureConversion(report, "engine_loopback", "TestConfig", "put_struct", fields, 0, repetitionsFor(fields), [&]()
+	{
+		engine.put("config", config);
+	});
+	measureConversion(report, "engine_loopback", "TestConfig", "put_fields", fields, 0, repetitionsFor(fields), [&]()
+	{
+		engine.put("name", config.name);
+		engine.put("gain", config.gain);
+		engine.put("iterations", config.iterations);
+		engine.put("enabled", config.enabled);
+		engine.put("weights", config.weights);
+		engine.put("samples", config.samples);
+		engine.put("limits", config.limits);
+		engine.put("ranges", config.ranges);
+	});
+
+	// repeated puts of the same shape with and without recycling the mxArray
+	Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(500, 500);
+	size_t elements = matrix.size();
+	for (int pooled=0; pooled<2; pooled++)
+	{
+		engine.arrayPool().setCapacity(pooled ? matlab::MxArrayPool::DEFAULT_CAPACITY : 0);
+		measureConversion(report, "engine_loopback", "MatrixXd_500x500", pooled ? "put_pooled" : "put_unpooled", elements, elements*sizeof(double), repetitionsFor(elements), [&]()
+		{
+			engine.put("matrix", matrix);
+		});
+	}
+}
+
+#endif /* ENGINEBENCHMARKS_HPP_ */
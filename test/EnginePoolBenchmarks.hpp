@@ -0,0 +1,68 @@
+/*
+ * EnginePoolBenchmarks.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef ENGINEPOOLBENCHMARKS_HPP_
+#define ENGINEPOOLBENCHMARKS_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include <matlabCppInterface/EnginePool.hpp>
+
+#include <BenchmarkReport.hpp>
+#include <StandInEngine.hpp>
+
+// throughput of CPU bound stand-in jobs for growing pool sizes
+void benchmarkEnginePool(BenchmarkReport& report, size_t nJobs = 400, size_t jobMicroseconds = 2000)
+{
+	std::cout<<"Benchmarking engine pool scaling ("<<nJobs<<" jobs of "<<jobMicroseconds<<"us)"<<std::endl;
+
+	std::ostringstream command;
+	command<<"spin("<<jobMicroseconds<<")";
+
+	double singleEngineSeconds = 0.0;
+	size_t maxEngines = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	for (size_t nEngines=1; nEngines<=maxEngines; nEngines*=2)
+	{
+		matlab::EnginePool<StandInEngine> pool(nEngines);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i=0; i<nJobs; i++)
+		{
+			pool.executeCommand(command.str());
+		}
+		pool.waitUntilIdle();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (nEngines == 1) { singleEngineSeconds = seconds; }
+
+		std::vector<matlab::EnginePool<StandInEngine>::Utilization> utilization = pool.utilization();
+		double meanUtilization = 0.0;
+		size_t jobsStolen = 0;
+		for (size_t i=0; i<utilization.size(); i++)
+		{
+			meanUtilization += utilization[i].utilization / utilization.size();
+			jobsStolen += utilization[i].jobsStolen;
+		}
+
+		std::cout<<nEngines<<" engines: "<<nJobs/seconds<<" jobs/s ("<<singleEngineSeconds/seconds<<"x), "
+				<<"utilization "<<100.0*meanUtilization<<"%, "<<jobsStolen<<" jobs stolen"<<std::endl;
+
+		std::ostringstream label;
+		label<<nEngines<<"_engines";
+
+		BenchmarkResult result;
+		result.suite = "engine_pool";
+		result.name = label.str();
+		result.operation = "spin";
+		result.elements = nJobs;
+		result.repetitions = nJobs;
+		result.microseconds = 1e6 * seconds / nJobs;
+		report.add(result, false);
+	}
+}
+
+#endif /* ENGINEPOOLBENCHMARKS_HPP_ */
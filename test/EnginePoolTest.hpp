@@ -0,0 +1,84 @@
+/*
+ * EnginePoolTest.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef ENGINEPOOLTEST_HPP_
+#define ENGINEPOOLTEST_HPP_
+
+#include <matlabCppInterface/Engine.hpp>
+#include <matlabCppInterface/EnginePool.hpp>
+
+#include <StandInEngine.hpp>
+
+void testEnginePoolStandIn()
+{
+	std::cout<<"Testing engine pool with stand-in engines"<<std::endl;
+
+	matlab::EnginePool<StandInEngine> pool(4);
+	assert(pool.size() == 4);
+
+	// workspace state lives in one session
+	assert(pool.put(2, "x", 3.0).get());
+	assert(pool.get<double>(2, "x").get() == 3.0);
+	bool thrown = false;
+	try { pool.get<double>(1, "x").get(); } catch (const std::runtime_error&) { thrown = true; }
+	assert(thrown);
+
+	// while session 0 is blocked, its share of the jobs is stolen by the others
+	std::future<std::string> blocker = pool.executeCommand(0, "pause(200000)");
+	std::vector<std::future<std::string> > results;
+	for (size_t i=0; i<16; i++)
+	{
+		results.push_back(pool.executeCommand("job"));
+	}
+	for (size_t i=0; i<results.size(); i++)
+	{
+		assert(results[i].get() == "job");
+	}
+	blocker.get();
+	pool.waitUntilIdle();
+
+	std::vector<matlab::EnginePool<StandInEngine>::Utilization> utilization = pool.utilization();
+	size_t jobsExecuted = 0;
+	size_t jobsStolen = 0;
+	for (size_t i=0; i<utilization.size(); i++)
+	{
+		jobsExecuted += utilization[i].jobsExecuted;
+		jobsStolen += utilization[i].jobsStolen;
+	}
+	assert(jobsExecuted == 20);
+	assert(jobsStolen > 0);
+	assert(utilization[0].busySeconds >= 0.2 && utilization[0].utilization > 0.0);
+
+	std::cout<<"Finished engine pool with stand-in engines"<<std::endl;
+}
+
+void testEnginePool()
+{
+	std::cout<<"Testing engine pool"<<std::endl;
+
+	matlab::EnginePool<> pool(2);
+
+	assert(pool.put(0, "a", 1.0).get());
+	assert(pool.put(1, "a", 2.0).get());
+	pool.executeCommand(0, "b = a + 1;");
+	pool.executeCommand(1, "b = a + 1;");
+	assert(pool.get<double>(0, "b").get() == 2.0);
+	assert(pool.get<double>(1, "b").get() == 3.0);
+
+	// any session can execute stateless jobs
+	std::future<double> result = pool.submit([](matlab::Engine& engine)
+	{
+		engine.executeCommand("c = sum(1:10);");
+		double c = 0;
+		engine.get("c", c);
+		return c;
+	});
+	assert(result.get() == 55.0);
+
+	std::cout<<"Finished engine pool"<<std::endl;
+}
+
+#endif /* ENGINEPOOLTEST_HPP_ */
@@ -0,0 +1,806 @@
+/*
+ * LoopbackEngineTest.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef LOOPBACKENGINETEST_HPP_
+#define LOOPBACKENGINETEST_HPP_
+
+#include <cmath>
+#include <unistd.h>
+
+#include <matlabCppInterface/Engine.hpp>
+#include <matlabCppInterface/LoopbackBackend.hpp>
+
+#include <TestStructs.hpp>
+
+matlab::Engine* createLoopbackEngine()
+{
+  return new matlab::Engine(std::unique_ptr<matlab::EngineBackend>(new matlab::LoopbackBackend()));
+}
+
+void testLoopbackEvaluator()
+{
+  std::cout<<"Testing the loopback evaluator"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  assert(!engine->isInitialized());
+  assert(engine->initialize());
+  assert(engine->good());
+
+  double value = 0;
+  engine->executeCommand("a = 1 + 2*3 - 4/2;");
+  assert(engine->get("a", value) && value == 5.0);
+  engine->executeCommand("a = -2^2, b = 2^-1; c = (1 + 2)*3");
+  assert(engine->get("a", value) && value == -4.0);
+  assert(engine->get("b", value) && value == 0.5);
+  assert(engine->get("c", value) && value == 9.0);
+
+  Eigen::MatrixXd matrix;
+  Eigen::MatrixXd expected(2, 3);
+  expected << 1, -2, 3, 4, 5, 6;
+  engine->executeCommand("M = [1 -2, 3\n4 5 6];");
+  assert(engine->get("M", matrix) && matrix == expected);
+  engine->executeCommand("M = [1 - 2, 3]; N = [M' M'];");
+  assert(engine->get("M", matrix) && matrix.rows() == 1 && matrix.cols() == 2 && matrix(0) == -1.0);
+  assert(engine->get("N", matrix) && matrix.rows() == 2 && matrix.cols() == 2);
+
+  engine->executeCommand("A = [1 2; 3 4]; B = A*A; C = A.*A + 1; D = A(2, 1) + A(4); E = 2*eye(2) ./ ones(2);");
+  assert(engine->get("B", matrix) && matrix(0, 0) == 7.0 && matrix(1, 1) == 22.0);
+  assert(engine->get("C", matrix) && matrix(1, 0) == 10.0);
+  assert(engine->get("D", value) && value == 7.0);
+  assert(engine->get("E", matrix) && matrix == 2.0*Eigen::MatrixXd::Identity(2, 2));
+
+  engine->executeCommand("s = size(zeros(3, 4)); n = numel(A); p = pi;");
+  assert(engine->get("s", matrix) && matrix(0) == 3.0 && matrix(1) == 4.0);
+  assert(engine->get("n", value) && value == 4.0);
+  assert(engine->get("p", value) && std::abs(value - M_PI) < 1e-15);
+
+  // strings and display
+  std::string text;
+  engine->executeCommand("t = 'it''s';");
+  assert(engine->get("t", text) && text == "it's");
+  assert(engine->executeCommand("disp(t)") == "it's");
+  assert(engine->executeCommand("x = 2;").empty());
+  assert(engine->executeCommand("x = 2").find("x =") == 0);
+  engine->executeCommand("3 + 4;");
+  assert(engine->get("ans", value) && value == 7.0);
+
+  // errors are reported in the output, the statements before are executed
+  assert(engine->executeCommand("y = 1; z = undefinedName + 1; w = 2;").find("Error: Undefined function or variable 'undefinedName'.") == 0);
+  assert(engine->exists("y") && !engine->exists("z") && !engine->exists("w"));
+  assert(engine->executeCommand("[1 2] + [1 2 3]").find("Error:") == 0);
+
+  engine->executeCommand("clear y t");
+  assert(!engine->exists("y") && !engine->exists("t") && engine->exists("x"));
+  engine->executeCommand("clear");
+  assert(!engine->exists("x"));
+
+  assert(engine->stop());
+  assert(!engine->isInitialized());
+
+  std::cout<<"Finished testing the loopback evaluator"<<std::endl;
+}
+
+void testLoopbackEngine()
+{
+  std::cout<<"Testing put, evaluate and get on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(5, 3);
+  std::vector<float> b(7, 1.5f);
+  assert(engine->put("A", A));
+  assert(engine->put("b", b));
+
+  engine->executeCommand("C = 2*A' + 1; d = b*2;");
+  Eigen::MatrixXd C;
+  std::vector<float> d;
+  Eigen::MatrixXd CExpected = (2.0*A.transpose()).array() + 1.0;
+  assert(engine->get("C", C) && C.isApprox(CExpected));
+  assert(engine->get("d", d) && d == std::vector<float>(7, 3.0f));
+
+  // native classes stay as they are until arithmetic is done on them
+  engine->setNumericStorage(matlab::STORE_NATIVE);
+  engine->put("f", 2.5f);
+  engine->executeCommand("g = f;");
+  float f = 0;
+  assert(engine->get("g", f) && f == 2.5f);
+  engine->setNumericStorage(matlab::STORE_AS_DOUBLE);
+
+  // asynchronous operations
+  std::future<bool> put = engine->putAsync("x", 3.0);
+  engine->executeCommandAsync("y = x*x;");
+  std::future<double> y = engine->getAsync<double>("y");
+  assert(put.get() && y.get() == 9.0);
+
+  // batches
+  matlab::VariableBatch batch;
+  batch.put("p", 1.0);
+  batch.put("q", A);
+  batch.put("p", 2.0); // a later put wins
+  engine->putMany(batch);
+  engine->executeCommand("r = p + q(1);");
+
+  double p = 0, r = 0, missing = 0;
+  batch.get("p", p);
+  batch.get("r", r);
+  batch.get("missing", missing);
+  std::vector<bool> status = engine->getMany(batch);
+  assert(status[0] && status[1] && !status[2]);
+  assert(p == 2.0 && r == 2.0 + A(0));
+
+  std::cout<<"Finished put, evaluate and get on a loopback engine"<<std::endl;
+}
+
+void testLoopbackDescribe()
+{
+  std::cout<<"Testing metadata queries on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  Eigen::MatrixXd big = Eigen::MatrixXd::Zero(500, 400);
+  engine->put("big", big);
+  engine->put("s", 2.0);
+  engine->put("text", std::string("abc"));
+  engine->executeCommand("e = zeros(0, 3);");
+
+  // no array is created, in particular the data of big is not copied
+#ifdef MX_STANDIN
+  mxStandInResetStatistics();
+#endif
+  assert(engine->exists("big") && !engine->exists("missing"));
+  assert(!engine->isScalar("big") && engine->isScalar("s"));
+  assert(engine->isEmpty("e") && !engine->isEmpty("s"));
+  assert(engine->isCharOrString("text") && !engine->isCharOrString("big"));
+  size_t rows = 0, cols = 0;
+  assert(engine->getDimensions("big", rows, cols) && rows == 500 && cols == 400);
+  assert(!engine->getDimensions("missing", rows, cols));
+
+  std::vector<std::string> names;
+  names.push_back("big");
+  names.push_back("missing");
+  names.push_back("text");
+  std::vector<matlab::VariableInfo> infos = engine->describe(names);
+#ifdef MX_STANDIN
+  assert(mxStandInGetStatistics().arraysCreated == 0);
+#endif
+
+  assert(infos.size() == 3 && infos[0].name == "big" && infos[1].name == "missing");
+  assert(infos[0].exists && infos[0].className == "double" && infos[0].bytes == 500*400*sizeof(double));
+  assert(infos[0].dims.size() == 2 && infos[0].dims[0] == 500 && infos[0].dims[1] == 400);
+  assert(!infos[1].exists);
+  assert(infos[2].className == "char" && infos[2].numberOfElements() == 3);
+
+  bool threw = false;
+  try { engine->isScalar("missing"); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+
+  std::cout<<"Finished metadata queries on a loopback engine"<<std::endl;
+}
+
+void testLoopbackStatistics()
+{
+  std::cout<<"Testing the statistics of a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(4, 5);
+  Eigen::MatrixXd B;
+
+  // nothing is recorded while disabled
+  engine->initialize();
+  engine->put("A", A);
+  engine->executeCommand("B = A;");
+  assert(engine->stats()[matlab::Statistics::PUT].calls == 0);
+  assert(engine->stats()[matlab::Statistics::EXECUTE_COMMAND].calls == 0);
+
+  size_t dumps = 0;
+  engine->statistics().setEnabled(true);
+  engine->statistics().setDumpCallback([&dumps](const matlab::Statistics::Snapshot&) { dumps++; }, std::chrono::milliseconds(0));
+
+  assert(engine->put("A", A));
+  assert(engine->get("B", B) && B == A);
+  assert(!engine->get("missing", B));
+  // a conversion that throws is a failed call
+  std::string text;
+  bool thrown = false;
+  try { engine->get("A", text); } catch (const std::runtime_error&) { thrown = true; }
+  assert(thrown);
+  assert(engine->executeCommand("C = A + 1;").empty());
+  std::future<bool> put = engine->putAsync("x", 2.0);
+  std::future<double> x = engine->getAsync<double>("x");
+  assert(put.get() && x.get() == 2.0);
+  engine->waitForAsync();
+  assert(engine->stop());
+
+  matlab::Statistics::Snapshot stats = engine->stats();
+  const matlab::OperationStatistics& puts = stats[matlab::Statistics::PUT];
+  const matlab::OperationStatistics& gets = stats[matlab::Statistics::GET];
+  assert(puts.calls == 2 && puts.failures == 0 && puts.arrays == 2);
+  assert(puts.bytes == (A.size() + 1)*sizeof(double));
+  assert(gets.calls == 4 && gets.failures == 2 && gets.arrays == 3);
+  assert(gets.latency.count() == 4 && gets.latency.maximum() >= gets.latency.minimum());
+  assert(gets.latency.percentile(0.5) <= gets.latency.percentile(1.0));
+  assert(stats[matlab::Statistics::EXECUTE_COMMAND].calls == 1);
+  assert(stats[matlab::Statistics::EXECUTE_COMMAND].bytes == std::string("C = A + 1;").size());
+  assert(stats[matlab::Statistics::CLOSE].calls == 1);
+  assert(dumps == 8);
+
+  engine->statistics().reset();
+  assert(engine->stats()[matlab::Statistics::PUT].calls == 0);
+
+  std::cout<<stats.toString();
+  std::cout<<"Finished the statistics of a loopback engine"<<std::endl;
+}
+
+// the same field as a vector of points and as a dense matrix
+struct TestPath
+{
+  std::vector<Eigen::Vector3d> points;
+};
+
+struct TestPathMatrix
+{
+  Eigen::MatrixXd points;
+};
+
+MATLAB_STRUCT_BEGIN(TestPath)
+  MATLAB_STRUCT_FIELD(points)
+MATLAB_STRUCT_END()
+
+MATLAB_STRUCT_BEGIN(TestPathMatrix)
+  MATLAB_STRUCT_FIELD(points)
+MATLAB_STRUCT_END()
+
+void testLoopbackStructs()
+{
+  std::cout<<"Testing reflected structs on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  // one transfer per struct, nested structs and struct arrays included
+  TestConfig config = createTestConfig(3);
+  assert(engine->put("config", config));
+  assert(engine->executeCommand("copy = config;").empty());
+  TestConfig copy;
+  assert(engine->get("copy", copy) && copy == config);
+
+  matlab::VariableInfo info = engine->describe("config");
+  assert(info.className == "struct" && info.isScalar());
+
+  std::vector<TestConfig> configs;
+  for (int i=0; i<4; i++) { configs.push_back(createTestConfig(i)); }
+  assert(engine->put("configs", configs));
+  std::vector<TestConfig> configsCopy;
+  assert(engine->get("configs", configsCopy) && configsCopy == configs);
+  info = engine->describe("configs");
+  assert(info.className == "struct" && info.dims.size() == 2 && info.dims[0] == 1 && info.dims[1] == 4);
+
+  // cell arrays of scalar structs are read like struct arrays
+  matlab::MxArrayNDimWrapper<TestLimits, std::allocator<TestLimits> > cells;
+  cells.mxArrayPtr() = mxCreateCellMatrix(1, 2);
+  TestLimits limits[2] = { { 1.0, 2.0 }, { 3.0, 4.0 } };
+  for (size_t i=0; i<2; i++)
+  {
+    matlab::MxArrayWrapper<TestLimits> cell(limits[i]);
+    mxSetCell(cells.mxArrayPtr(), i, cell.release());
+  }
+  std::vector<TestLimits> limitsCopy;
+  cells.get(limitsCopy);
+  assert(limitsCopy.size() == 2 && limitsCopy[0] == limits[0] && limitsCopy[1] == limits[1]);
+
+  // fields are matched by name, missing ones throw
+  bool threw = false;
+  try { engine->get("copy", limitsCopy); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+  threw = false;
+  try { engine->get("configs", copy); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+
+  // a field that does not fit the slices of a vector throws as well
+  TestPathMatrix routeMatrix;
+  routeMatrix.points = Eigen::MatrixXd::Random(2, 4);
+  assert(engine->put("route", routeMatrix));
+  TestPath route;
+  threw = false;
+  try { engine->get("route", route); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+  route.points.assign(4, Eigen::Vector3d::Random());
+  TestPath routeCopy;
+  assert(engine->put("route", route) && engine->get("route", routeCopy) && routeCopy.points == route.points);
+
+  std::cout<<"Finished reflected structs on a loopback engine"<<std::endl;
+}
+
+void testLoopbackSparse()
+{
+  std::cout<<"Testing sparse matrices on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  // a tridiagonal matrix, only the non-zeros are transferred
+  const int n = 1000;
+  Eigen::SparseMatrix<double> tridiagonal(n, n);
+  std::vector<Eigen::Triplet<double> > triplets;
+  for (int i=0; i<n; i++)
+  {
+    triplets.push_back(Eigen::Triplet<double>(i, i, 2.0));
+    if (i > 0) { triplets.push_back(Eigen::Triplet<double>(i, i-1, -1.0)); }
+    if (i+1 < n) { triplets.push_back(Eigen::Triplet<double>(i, i+1, -1.0)); }
+  }
+  tridiagonal.setFromTriplets(triplets.begin(), triplets.end());
+
+  assert(engine->put("A", tridiagonal));
+  assert(engine->executeCommand("B = A;").empty());
+  Eigen::SparseMatrix<double> copy;
+  assert(engine->get("B", copy));
+  assert(copy.nonZeros() == tridiagonal.nonZeros() && copy.isApprox(tridiagonal));
+
+  matlab::VariableInfo info = engine->describe("A");
+  assert(info.className == "double" && info.dims[0] == n && info.dims[1] == n);
+  assert(info.bytes < 4*tridiagonal.nonZeros()*(sizeof(double) + sizeof(mwIndex)));
+
+  // row major and uncompressed matrices, other scalar types
+  Eigen::SparseMatrix<float, Eigen::RowMajor> rowMajor = tridiagonal.cast<float>();
+  assert(engine->put("rowMajor", rowMajor));
+  Eigen::SparseMatrix<float, Eigen::RowMajor> rowMajorCopy;
+  assert(engine->get("rowMajor", rowMajorCopy) && rowMajorCopy.isApprox(rowMajor));
+
+  Eigen::SparseMatrix<double> uncompressed(5, 4);
+  uncompressed.reserve(Eigen::VectorXi::Constant(4, 3));
+  uncompressed.insert(3, 0) = 1.0;
+  uncompressed.insert(0, 2) = 2.0;
+  uncompressed.insert(4, 2) = 3.0;
+  assert(!uncompressed.isCompressed());
+  assert(engine->put("uncompressed", uncompressed));
+  assert(engine->get("uncompressed", copy) && copy.nonZeros() == 3 && copy.isApprox(uncompressed));
+
+  Eigen::SparseMatrix<double> empty(3, 2);
+  assert(engine->put("empty", empty));
+  assert(engine->get("empty", copy) && copy.rows() == 3 && copy.cols() == 2 && copy.nonZeros() == 0);
+
+  // a view on the buffers of the array, without any copy
+  matlab::MxArrayWrapper<Eigen::SparseMatrix<double> > wrapped(tridiagonal);
+  matlab::MxSparseMap map = matlab::mapSparse(wrapped.mxArrayPtr());
+  assert(map.nonZeros() == tridiagonal.nonZeros() && map.valuePtr() == mxGetPr(wrapped.mxArrayPtr()));
+  assert(map.coeff(5, 4) == -1.0 && map.coeff(5, 5) == 2.0 && map.coeff(5, 7) == 0.0);
+
+  // sparse and dense arrays are not mixed up
+  bool threw = false;
+  Eigen::MatrixXd dense;
+  try { engine->get("A", dense); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+  threw = false;
+  engine->put("dense", Eigen::MatrixXd::Identity(3, 3));
+  try { engine->get("dense", copy); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+
+  std::cout<<"Finished sparse matrices on a loopback engine"<<std::endl;
+}
+
+void testLoopbackComplex()
+{
+  std::cout<<"Testing complex matrices on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  // one put for both parts
+  Eigen::MatrixXcd spectrum = Eigen::MatrixXcd::Random(64, 3);
+  engine->statistics().setEnabled(true);
+  assert(engine->put("spectrum", spectrum));
+  assert(engine->stats()[matlab::Statistics::PUT].calls == 1);
+  assert(engine->stats()[matlab::Statistics::PUT].bytes == spectrum.size()*sizeof(std::complex<double>));
+  engine->statistics().setEnabled(false);
+
+  assert(engine->executeCommand("copy = spectrum;").empty());
+  Eigen::MatrixXcd copy;
+  assert(engine->get("copy", copy) && copy == spectrum);
+  matlab::VariableInfo info = engine->describe("spectrum");
+  assert(info.isComplex && info.className == "double" && info.bytes == spectrum.size()*sizeof(std::complex<double>));
+
+  // expressions, row major matrices, vectors and scalars
+  assert(engine->put("scaled", (spectrum * std::complex<double>(0.0, 2.0)).topRows(10)));
+  assert(engine->get("scaled", copy) && copy.isApprox(spectrum.topRows(10) * std::complex<double>(0.0, 2.0)));
+  Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rowMajor;
+  assert(engine->get("spectrum", rowMajor) && rowMajor == spectrum);
+  std::complex<double> scalar(1.5, -2.5), scalarCopy;
+  assert(engine->put("scalar", scalar));
+  assert(engine->get("scalar", scalarCopy) && scalarCopy == scalar);
+
+  std::vector<std::complex<double> > samples;
+  for (int i=0; i<100; i++) { samples.push_back(std::polar(1.0, 0.1*i)); }
+  assert(engine->put("samples", samples));
+  std::vector<std::complex<double> > samplesCopy;
+  assert(engine->get("samples", samplesCopy) && samplesCopy == samples);
+  Eigen::VectorXcd samplesVector;
+  assert(engine->get("samples", samplesVector) && samplesVector.size() == 100 && samplesVector(7) == samples[7]);
+  Eigen::RowVectorXcd samplesRow;
+  assert(engine->get("samples", samplesRow) && samplesRow.cols() == 100 && samplesRow(99) == samples[99]);
+  info = engine->describe("samples");
+  assert(info.isComplex && info.dims[0] == 1 && info.dims[1] == 100);
+
+  // slices of single precision in native storage
+  std::vector<Eigen::MatrixXcf> slices(4, Eigen::MatrixXcf::Random(5, 2));
+  engine->setNumericStorage(matlab::STORE_NATIVE);
+  assert(engine->put("slices", slices));
+  engine->setNumericStorage(matlab::STORE_AS_DOUBLE);
+  std::vector<Eigen::MatrixXcf> slicesCopy;
+  assert(engine->get("slices", slicesCopy) && slicesCopy.size() == 4 && slicesCopy[3] == slices[3]);
+  info = engine->describe("slices");
+  assert(info.isComplex && info.className == "single" && info.dims.size() == 3);
+
+  // real arrays are read with zero imaginary parts
+  Eigen::MatrixXd real = Eigen::MatrixXd::Random(3, 3);
+  assert(engine->put("real", real));
+  assert(engine->get("real", copy) && copy.real() == real && copy.imag().isZero(0.0));
+
+  std::cout<<"Finished complex matrices on a loopback engine"<<std::endl;
+}
+
+void testLoopbackFixedSize()
+{
+  std::cout<<"Testing fixed size matrices on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  Eigen::Matrix3d rotation = Eigen::Matrix3d::Random();
+  Eigen::Matrix<double, 6, 1> twist = Eigen::Matrix<double, 6, 1>::Random();
+  assert(engine->put("rotation", rotation));
+  assert(engine->put("twist", twist));
+  assert(engine->put("twistRow", twist.transpose()));
+
+  Eigen::Matrix3d rotationCopy;
+  Eigen::Matrix<double, 6, 1> twistCopy;
+  assert(engine->get("rotation", rotationCopy) && rotationCopy == rotation);
+  assert(engine->get("twist", twistCopy) && twistCopy == twist);
+  assert(engine->get("twistRow", twistCopy) && twistCopy == twist);
+
+  // other scalar types, row major storage and arrays
+  Eigen::Matrix<float, 3, 3, Eigen::RowMajor> rotationFloat;
+  assert(engine->get("rotation", rotationFloat) && rotationFloat == rotation.cast<float>());
+  Eigen::Array33d rotationArray;
+  assert(engine->get("rotation", rotationArray) && rotationArray.matrix() == rotation);
+  Eigen::Matrix<int, 2, 2> counts;
+  Eigen::Matrix<int, 2, 2> countsData;
+  countsData << 1, 2, 3, 4;
+  engine->setNumericStorage(matlab::STORE_NATIVE);
+  assert(engine->put("counts", countsData));
+  engine->setNumericStorage(matlab::STORE_AS_DOUBLE);
+  assert(engine->get("counts", counts) && counts == countsData);
+  Eigen::MatrixXf dynamicFloat;
+  assert(engine->get("rotation", dynamicFloat) && dynamicFloat == rotation.cast<float>());
+
+  // the conversion fills the fixed size matrix in place
+  matlab::MxArrayWrapper<Eigen::Matrix3d> wrapped(rotation);
+  matlab::MxArrayWrapper<Eigen::Matrix<float, 3, 3, Eigen::RowMajor> > wrappedRowMajor(rotationFloat);
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+  Eigen::internal::set_is_malloc_allowed(false);
+#endif
+  wrapped.get(rotationCopy);
+  wrappedRowMajor.get(rotationFloat);
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+  Eigen::internal::set_is_malloc_allowed(true);
+#endif
+  assert(rotationCopy == rotation && rotationFloat == rotation.cast<float>());
+
+  // the dimensions have to match the fixed size
+  bool threw = false;
+  try { engine->get("twist", rotationCopy); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+  threw = false;
+  Eigen::Vector3d vector;
+  try { engine->get("rotation", vector); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+
+  // vectors of slices fail instead, also in release builds
+  std::vector<Eigen::Matrix3d> rotations;
+  std::vector<Eigen::Vector3d> vectors;
+  assert(engine->put("text", std::string("abc")));
+  assert(!engine->get("twist", rotations));
+  assert(!engine->get("rotation", vectors));
+  assert(!engine->get("text", rotations));
+  assert(engine->get("rotation", rotations) && rotations.size() == 1 && rotations[0] == rotation);
+
+  std::cout<<"Finished fixed size matrices on a loopback engine"<<std::endl;
+}
+
+void testLoopbackArrayPool()
+{
+  std::cout<<"Testing the mxArray pool on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+  matlab::MxArrayPool& pool = engine->arrayPool();
+
+  // the array of the first put is reused by all following puts of the same shape
+  Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(500, 500);
+  Eigen::MatrixXd copy;
+  for (int i=0; i<10; i++)
+  {
+    matrix(0, 0) = i;
+    assert(engine->put("matrix", matrix));
+    assert(engine->get("matrix", copy) && copy == matrix);
+  }
+  assert(pool.counters().misses == 1 && pool.counters().hits == 9);
+  assert(pool.counters().recycled == 10 && pool.pooledBytes() == 500*500*sizeof(double));
+
+  // other classes and shapes have their own arrays
+  engine->setNumericStorage(matlab::STORE_NATIVE);
+  assert(engine->put("single", Eigen::MatrixXf::Ones(500, 500)));
+  engine->setNumericStorage(matlab::STORE_AS_DOUBLE);
+  assert(engine->put("column", std::vector<double>(500, 2.0)));
+  assert(engine->put("column", std::vector<double>(500, 3.0)));
+  assert(engine->put("complex", Eigen::MatrixXcd::Ones(4, 4)));
+  assert(engine->put("complex", Eigen::MatrixXcd::Ones(4, 4)));
+  assert(pool.counters().misses == 4 && pool.counters().hits == 11);
+
+  // asynchronous puts release their arrays on the worker thread
+  pool.resetCounters();
+  for (int i=0; i<5; i++) { engine->putAsync("matrix", matrix); }
+  engine->waitForAsync();
+  assert(pool.counters().hits >= 1 && pool.counters().hits + pool.counters().misses == 5);
+  assert(engine->get("matrix", copy) && copy == matrix);
+
+  // no capacity disables the pool
+  pool.setCapacity(0);
+  assert(pool.pooledBytes() == 0);
+  pool.resetCounters();
+  assert(engine->put("matrix", matrix) && engine->put("matrix", matrix));
+  assert(pool.counters().hits == 0 && pool.counters().discarded == 2);
+  pool.setCapacity(matlab::MxArrayPool::DEFAULT_CAPACITY);
+
+  // the wrappers are move only, the array is released once
+  pool.resetCounters();
+  matlab::MxArrayWrapper<Eigen::MatrixXd> wrapped(matrix, matlab::STORE_AS_DOUBLE, &pool);
+  matlab::MxArrayWrapper<Eigen::MatrixXd> moved(std::move(wrapped));
+  assert(wrapped.mxArrayPtr() == NULL && moved.mxArrayPtr() != NULL);
+  wrapped = std::move(moved);
+  wrapped.get(copy);
+  assert(copy == matrix);
+  wrapped.erase();
+  assert(pool.counters().recycled == 1 && pool.counters().discarded == 0);
+
+  std::cout<<"Finished the mxArray pool on a loopback engine"<<std::endl;
+}
+
+// counts the shared memory transfers and checks the file exists while it is mapped
+class SharedMemoryCountingBackend : public matlab::LoopbackBackend
+{
+public:
+  SharedMemoryCountingBackend() : puts(0), gets(0), refusePuts(false) {}
+
+  virtual bool putVariableShared(const std::string& name, const matlab::SharedArrayDescriptor& array)
+  {
+    puts++;
+    lastFile = array.file;
+    assert(access(array.file.c_str(), R_OK) == 0);
+    return !refusePuts && matlab::LoopbackBackend::putVariableShared(name, array);
+  }
+
+  virtual bool getVariableShared(const std::string& name, const matlab::SharedArrayDescriptor& array)
+  {
+    gets++;
+    lastFile = array.file;
+    assert(access(array.file.c_str(), W_OK) == 0);
+    return matlab::LoopbackBackend::getVariableShared(name, array);
+  }
+
+  size_t puts;
+  size_t gets;
+  std::string lastFile;
+  bool refusePuts; // as if Matlab could not map the file
+};
+
+void testLoopbackSharedMemory()
+{
+  std::cout<<"Testing shared memory transfers on a loopback engine"<<std::endl;
+
+  SharedMemoryCountingBackend* backend = new SharedMemoryCountingBackend();
+  matlab::Engine engine((std::unique_ptr<matlab::EngineBackend>(backend)));
+  engine.initialize();
+  assert(engine.getSharedMemoryThreshold() == 0);
+  engine.setSharedMemoryThreshold(1 << 20);
+
+  // above the threshold the data goes through a file, which is removed afterwards
+  Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(500, 500);
+  Eigen::MatrixXd copy;
+  assert(engine.put("matrix", matrix));
+  assert(backend->puts == 1 && access(backend->lastFile.c_str(), F_OK) != 0);
+  assert(engine.get("matrix", copy) && copy == matrix);
+  assert(backend->gets == 1 && access(backend->lastFile.c_str(), F_OK) != 0);
+  engine.executeCommand("doubled = 2*matrix;");
+  assert(engine.get("doubled", copy) && copy == 2*matrix);
+  assert(backend->gets == 2);
+
+  // below the threshold, or not mappable, it goes through the engine
+  Eigen::MatrixXd small = Eigen::MatrixXd::Random(10, 10);
+  assert(engine.put("small", small) && engine.get("small", copy) && copy == small);
+  Eigen::MatrixXcd complex = Eigen::MatrixXcd::Random(300, 300);
+  Eigen::MatrixXcd complexCopy;
+  assert(engine.put("complex", complex) && engine.get("complex", complexCopy) && complexCopy == complex);
+  assert(backend->puts == 1 && backend->gets == 2);
+
+  // other classes and N-dimensional arrays keep their class and dimensions
+  engine.setNumericStorage(matlab::STORE_NATIVE);
+  Eigen::MatrixXf single = Eigen::MatrixXf::Random(600, 600);
+  Eigen::MatrixXf singleCopy;
+  assert(engine.put("single", single) && engine.get("single", singleCopy) && singleCopy == single);
+  std::vector<Eigen::MatrixXd> slices(4, Eigen::MatrixXd::Random(200, 200));
+  std::vector<Eigen::MatrixXd> slicesCopy;
+  assert(engine.put("slices", slices) && engine.get("slices", slicesCopy) && slicesCopy == slices);
+  assert(engine.describe("slices").dims.size() == 3);
+  engine.setNumericStorage(matlab::STORE_AS_DOUBLE);
+  assert(backend->puts == 3 && backend->gets == 4);
+
+  // asynchronous transfers take the same path
+  std::future<bool> put = engine.putAsync("async", matrix);
+  std::future<Eigen::MatrixXd> got = engine.getAsync<Eigen::MatrixXd>("async");
+  assert(put.get() && got.get() == matrix);
+  assert(backend->puts == 4 && backend->gets == 5);
+
+  // expressions are evaluated straight into the file
+  assert(engine.put("transposed", matrix.transpose()) && engine.get("transposed", copy) && copy == matrix.transpose());
+  assert(backend->puts == 5 && backend->gets == 6);
+
+  // if the file cannot be mapped on the other side, its content goes through the engine
+  backend->refusePuts = true;
+  assert(engine.put("refused", matrix) && engine.get("refused", copy) && copy == matrix);
+  assert(backend->puts == 6 && access(backend->lastFile.c_str(), F_OK) != 0);
+  backend->refusePuts = false;
+
+  // without a usable directory the engine is used
+  engine.setSharedMemoryDirectory("/nonexistent/matlabCppInterface");
+  assert(engine.put("fallback", matrix) && engine.get("fallback", copy) && copy == matrix);
+  assert(backend->puts == 6 && backend->gets == 7);
+  engine.setSharedMemoryDirectory(matlab::SharedMemorySegment::DEFAULT_DIRECTORY);
+
+  // a missing variable is only described
+  assert(!engine.get("missing", copy));
+
+  std::cout<<"Finished shared memory transfers on a loopback engine"<<std::endl;
+}
+
+void testLoopbackStrings()
+{
+  std::cout<<"Testing strings and string lists on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  // thousands of labels in one transfer, as a cellstr
+  std::vector<std::string> labels(5000);
+  for (size_t i=0; i<labels.size(); i++) { labels[i] = "channel_" + std::to_string(i); }
+  labels[7] = "";
+  labels[8] = "trailing blank ";
+  assert(engine->put("labels", labels));
+  matlab::VariableInfo info = engine->describe("labels");
+  assert(info.className == "cell" && info.rows() == 1 && info.cols() == labels.size());
+
+  std::vector<std::string> labelsTest;
+  assert(engine->get("labels", labelsTest) && labelsTest == labels);
+
+  // a second get decodes into the existing strings
+  const char* storage = labelsTest[100].data();
+  assert(engine->get("labels", labelsTest) && labelsTest == labels);
+  assert(labelsTest[100].data() == storage);
+
+  // text that is not ASCII goes through the locale's encoding
+  std::vector<std::string> units(2);
+  units[0] = "m/s";
+  units[1] = "\xc2\xb0" "C";
+  assert(engine->put("units", units) && engine->get("units", labelsTest) && labelsTest == units);
+
+  // char matrices are read row by row without the padding
+  const char* rows[3] = { "x", "y axis", "z" };
+  mxArray* charMatrix = mxCreateCharMatrixFromStrings(3, rows);
+  assert(engine->backend().putVariable("axes", charMatrix));
+  mxDestroyArray(charMatrix);
+  assert(engine->get("axes", labelsTest) && labelsTest.size() == 3);
+  assert(labelsTest[0] == "x" && labelsTest[1] == "y axis" && labelsTest[2] == "z");
+
+  // single strings, also empty ones
+  std::string text;
+  assert(engine->put("text", std::string("some text")) && engine->get("text", text) && text == "some text");
+  assert(engine->put("text", std::string()) && engine->get("text", text) && text.empty());
+  engine->executeCommand("quoted = 'it''s';");
+  assert(engine->get("quoted", text) && text == "it's");
+
+  // numbers are neither cells nor char matrices
+  assert(engine->put("number", 1.0));
+  bool threw = false;
+  try { engine->get("number", labelsTest); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+
+  std::cout<<"Finished strings and string lists on a loopback engine"<<std::endl;
+}
+
+void testLoopbackSlices()
+{
+  std::cout<<"Testing contiguous 3-D blocks on a loopback engine"<<std::endl;
+
+  std::unique_ptr<matlab::Engine> engine(createLoopbackEngine());
+  engine->initialize();
+
+  // a trajectory of 200 poses in one buffer
+  matlab::MatrixSlicesXd poses(4, 4, 200);
+  poses.matrix().setRandom();
+  assert(poses.slices() == 200 && poses.matrix().cols() == 4*200);
+  assert(poses.slice(3) == poses.matrix().middleCols(3*4, 4));
+
+  assert(engine->put("poses", poses));
+  matlab::VariableInfo info = engine->describe("poses");
+  assert(info.className == "double" && info.dims.size() == 3 && info.dims[2] == 200);
+
+  matlab::MatrixSlicesXd posesTest;
+  assert(engine->get("poses", posesTest) && posesTest == poses);
+
+  // a second get of the same shape copies into the existing buffer
+  const double* storage = posesTest.data();
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+  Eigen::internal::set_is_malloc_allowed(false);
+#endif
+  assert(engine->get("poses", posesTest));
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+  Eigen::internal::set_is_malloc_allowed(true);
+#endif
+  assert(posesTest.data() == storage && posesTest == poses);
+
+  // the same layout as a std::vector of matrices
+  std::vector<Eigen::MatrixXd> posesVector;
+  assert(engine->get("poses", posesVector) && posesVector.size() == 200);
+  for (size_t i=0; i<posesVector.size(); i++) { assert(posesVector[i] == poses.slice(i)); }
+  posesVector[5].setZero();
+  assert(engine->put("posesVector", posesVector) && engine->get("posesVector", posesTest));
+  assert(posesTest.slice(5).isZero() && posesTest.slice(6) == poses.slice(6));
+
+  // slices of a fixed size that does not fit are an error, queued gets throw it
+  std::vector<Eigen::Matrix3d> wrongSize;
+  assert(!engine->get("poses", wrongSize));
+  std::future<std::vector<Eigen::Matrix3d> > wrongSizeAsync = engine->getAsync<std::vector<Eigen::Matrix3d> >("poses");
+  bool thrown = false;
+  try { wrongSizeAsync.get(); } catch (const std::runtime_error&) { thrown = true; }
+  assert(thrown);
+  matlab::VariableBatch batch;
+  batch.get("poses", wrongSize);
+  batch.get("poses", posesVector);
+  std::vector<bool> status = engine->getMany(batch);
+  assert(!status[0] && status[1] && posesVector.size() == 200);
+
+  // native single precision and further dimensions
+  std::vector<size_t> dims(4);
+  dims[0] = 2; dims[1] = 3; dims[2] = 4; dims[3] = 5;
+  matlab::MatrixSlicesXf block(dims);
+  block.matrix().setRandom();
+  assert(block.slices() == 20);
+  engine->setNumericStorage(matlab::STORE_NATIVE);
+  assert(engine->put("block", block));
+  assert(engine->describe("block").className == "single");
+  matlab::MatrixSlicesXf blockTest;
+  assert(engine->get("block", blockTest) && blockTest == block);
+  matlab::MatrixSlicesXd blockDouble;
+  assert(engine->get("block", blockDouble) && blockDouble.dims() == dims);
+  assert(blockDouble.matrix() == block.matrix().cast<double>());
+  engine->setNumericStorage(matlab::STORE_AS_DOUBLE);
+
+  // matrices are a single slice
+  Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(3, 5);
+  assert(engine->put("matrix", matrix) && engine->get("matrix", posesTest));
+  assert(posesTest.slices() == 1 && posesTest.slice(0) == matrix);
+
+  // strings are not numeric
+  assert(engine->put("text", std::string("text")));
+  bool threw = false;
+  try { engine->get("text", posesTest); } catch (std::runtime_error&) { threw = true; }
+  assert(threw);
+
+  std::cout<<"Finished contiguous 3-D blocks on a loopback engine"<<std::endl;
+}
+
+#endif /* LOOPBACKENGINETEST_HPP_ */
@@ -10,6 +10,8 @@
 
 #include <matlabCppInterface/MatFile.hpp>
 
+#include <TestStructs.hpp>
+
 void testOpenClose()
 {
 	matlab::MatFile file;
@@ -237,4 +239,587 @@ void testWriteScalarVectors()
 	assert(file.close());
 }
 
+void testWriteNative(matlab::MatFile::OPEN_MODE mode = matlab::MatFile::WRITE_NATIVE)
+{
+	matlab::MatFile file;
+	file.setCompressionLevel(1);
+	file.setCompressionThreads(4);
+
+	// written by the built-in writer, read back through libmat
+	assert(file.open("test.mat", mode));
+	assert(file.isOpen());
+	assert(file.isWritable());
+
+	double a = 12312.1;
+	bool b = true;
+	int c = 1322;
+	std::string d = "test";
+	Eigen::MatrixXd A(2, 3);
+	A << 1.0, 2.23, -3.13, 4, 5, 6;
+	Eigen::Matrix<double, 3, 2, Eigen::RowMajor> B = A.transpose();
+	std::vector<float> e(7);
+	for (size_t i=0; i<e.size(); i++) { e[i] = i; }
+	std::vector<Eigen::MatrixXd> A_vec;
+	A_vec.push_back(A);
+	A_vec.push_back(2.0*A);
+
+	assert(file.put("a", a));
+	// the following variables are compressed with the new level, uncompressed files stay uncompressed
+	file.setCompressionLevel(9);
+	assert(file.put("b", b));
+	assert(file.put("c", c, true));
+	assert(file.put("d", d));
+	assert(file.put("A", A));
+	assert(file.put("B", B));
+	assert(file.put("A_block", A.block(0, 1, 2, 2)));
+	assert(file.put("e", e));
+	assert(file.put("A_vec", A_vec));
+	assert(!file.get("a", a));
+	assert(file.close());
+
+	assert(file.open("test.mat", matlab::MatFile::READ));
+
+	double aTest = 0;
+	bool bTest = !b;
+	int cTest = 0;
+	std::string dTest;
+	Eigen::MatrixXd ATest, BTest, A_blockTest;
+	std::vector<float> eTest;
+	std::vector<Eigen::MatrixXd> A_vecTest;
+
+	assert(file.get("a", aTest));
+	assert(file.get("b", bTest));
+	assert(file.get("c", cTest));
+	assert(file.get("d", dTest));
+	assert(file.get("A", ATest));
+	assert(file.get("B", BTest));
+	assert(file.get("A_block", A_blockTest));
+	assert(file.get("e", eTest));
+	assert(file.get("A_vec", A_vecTest));
+
+	int dimensions = 0;
+	bool isGlobal = false;
+	assert(file.getVariableInfo("c", dimensions, isGlobal));
+	assert(isGlobal);
+	std::vector<size_t> dims;
+	assert(file.getVariableDims("A_vec", dims));
+	assert(dims.size() == 3 && dims[0] == 2 && dims[1] == 3 && dims[2] == 2);
+	assert(!file.getVariableDims("missing", dims));
+	std::vector<std::string> variableList;
+	assert(file.getVariableList(variableList) && variableList.size() == 9 && variableList[0] == "a");
+
+	assert(file.close());
+
+	assert(a == aTest);
+	assert(b == bTest);
+	assert(c == cTest);
+	assert(d == dTest);
+	assert(A == ATest);
+	assert(B == BTest);
+	assert(A.block(0, 1, 2, 2) == A_blockTest);
+	assert(e == eTest);
+	assert(A_vec.size() == A_vecTest.size());
+	for (size_t i=0; i<A_vec.size(); i++)
+	{
+		assert(A_vec[i] == A_vecTest[i]);
+	}
+}
+
+void testReadMapped()
+{
+	matlab::MatFile file;
+
+	Eigen::MatrixXd A = Eigen::MatrixXd::Random(4, 3);
+	Eigen::Matrix3d B = Eigen::Matrix3d::Random();
+	std::vector<Eigen::MatrixXd> A_vec;
+	A_vec.push_back(A);
+	A_vec.push_back(2.0*A);
+	double a = 12312.1;
+	std::string d = "test";
+
+	// uncompressed files written by libmat and by the built-in writer can both be mapped
+	matlab::MatFile::OPEN_MODE writeModes[2] = { matlab::MatFile::WRITE, matlab::MatFile::WRITE_NATIVE };
+	for (size_t i=0; i<2; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("A", A));
+		assert(file.put("B", B));
+		assert(file.put("A_vec", A_vec));
+		assert(file.put("a", a, true));
+		assert(file.put("d", d));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+		assert(file.isOpen());
+		assert(!file.isWritable());
+		assert(!file.put("a", a));
+
+		Eigen::Map<const Eigen::MatrixXd> AMap(NULL, 0, 0);
+		assert(file.getMap("A", AMap));
+		assert(AMap == A);
+
+		// 3-D arrays are mapped as rows x (cols*N)
+		Eigen::Map<const Eigen::MatrixXd> A_vecMap(NULL, 0, 0);
+		assert(file.getMap("A_vec", A_vecMap));
+		assert(A_vecMap.rows() == A.rows() && A_vecMap.cols() == 2*A.cols());
+		assert(A_vecMap.rightCols(A.cols()) == 2.0*A);
+
+		Eigen::MatrixXd BTest;
+		std::vector<Eigen::MatrixXd> A_vecTest;
+		double aTest = 0;
+		std::string dTest;
+		assert(file.get("B", BTest));
+		assert(file.get("A_vec", A_vecTest));
+		assert(file.get("a", aTest));
+		assert(file.get("d", dTest));
+		assert(!file.get("x", aTest));
+		assert(!file.getMap("d", AMap));
+
+		assert(B == BTest);
+		assert(A_vecTest.size() == 2 && A_vecTest[1] == 2.0*A);
+		assert(a == aTest);
+		assert(d == dTest);
+
+		int dimensions = 0;
+		bool isGlobal = false;
+		assert(file.getVariableInfo("A_vec", dimensions, isGlobal));
+		assert(dimensions == 3 && !isGlobal);
+		assert(file.getVariableInfo("a", dimensions, isGlobal));
+		assert(isGlobal);
+
+		std::vector<std::string> variableList;
+		assert(file.getVariableList(variableList));
+		assert(variableList.size() == 5);
+
+		assert(file.close());
+	}
+
+	// compressed variables are read through libmat, they cannot be mapped
+	assert(file.open("test.mat", matlab::MatFile::WRITE_COMPRESSED));
+	assert(file.put("A", A));
+	assert(file.put("A_vec", A_vec));
+	assert(file.close());
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	assert(!file.put("A", A));
+	assert(!file.put("A_vec", A_vec));
+	Eigen::MatrixXd ATest;
+	std::vector<Eigen::MatrixXd> A_vecTest;
+	Eigen::Map<const Eigen::MatrixXd> AMap(NULL, 0, 0);
+	assert(file.get("A", ATest) && ATest == A);
+	assert(file.get("A_vec", A_vecTest) && A_vecTest.size() == 2 && A_vecTest[1] == 2.0*A);
+	assert(!file.getMap("A", AMap));
+	assert(file.close());
+
+	// puts of vectors fail in the read modes as well
+	assert(file.open("test.mat", matlab::MatFile::READ));
+	assert(!file.put("A_vec", A_vec));
+	assert(file.close());
+
+	// the arrays of vector puts are recycled by the pool of the file
+	assert(file.open("test.mat", matlab::MatFile::WRITE));
+	file.arrayPool().resetCounters();
+	assert(file.put("A_vec", A_vec) && file.put("A_vec", A_vec));
+	assert(file.arrayPool().counters().misses == 1 && file.arrayPool().counters().hits == 1);
+	assert(file.close());
+}
+
+void testAppend()
+{
+	matlab::MatFile file;
+
+	// appending is only supported by the built-in writer
+	assert(file.open("test.mat", matlab::MatFile::WRITE));
+	assert(!file.append("t", 1.0));
+	assert(file.close());
+
+	assert(file.open("test.mat", matlab::MatFile::WRITE_NATIVE));
+
+	// enough samples to overflow the buffers, the interleaved variables grow past each other
+	const size_t nSamples = 5000;
+	Eigen::Matrix2d R = Eigen::Matrix2d::Random();
+	Eigen::MatrixXd A = Eigen::MatrixXd::Random(30, 40);
+	for (size_t i=0; i<nSamples; i++)
+	{
+		Eigen::Vector3d x(i, 2.0*i, 3.0*i);
+		assert(file.append("t", 0.001*i));
+		assert(file.append("x", x));
+		assert(file.append("x_row", x.transpose()));
+		assert(file.append("R", i*R));
+		if (i == nSamples/2) { assert(file.put("A", A)); }
+	}
+	// slices have to keep their size
+	assert(!file.append("x", Eigen::Vector2d::Zero()));
+	// variables that were put cannot grow, appended ones cannot be replaced
+	assert(!file.append("A", 1.0) && !file.put("t", 1.0));
+	assert(file.close());
+
+	assert(file.open("test.mat", matlab::MatFile::READ));
+
+	std::vector<double> t;
+	Eigen::MatrixXd x, x_row;
+	std::vector<Eigen::MatrixXd> R_vec;
+	Eigen::MatrixXd ATest;
+	assert(file.get("A", ATest) && ATest == A);
+	assert(file.get("t", t));
+	assert(file.get("x", x));
+	assert(file.get("x_row", x_row));
+	assert(file.get("R", R_vec));
+	assert(file.close());
+
+	assert(t.size() == nSamples);
+	assert(x.rows() == 3 && x.cols() == nSamples);
+	assert(x == x_row);
+	assert(R_vec.size() == nSamples);
+	for (size_t i=0; i<nSamples; i++)
+	{
+		assert(t[i] == 0.001*i);
+		assert(x(1, i) == 2.0*i);
+		assert(R_vec[i] == i*R);
+	}
+}
+
+void testNativeStorage()
+{
+	matlab::MatFile file;
+
+	std::vector<float> floats(10, 1.5f);
+	std::vector<int> ints(5, -3);
+	size_t count = 4000000000u;
+	Eigen::MatrixXf A = Eigen::MatrixXf::Random(3, 4);
+	std::vector<Eigen::Matrix3f> rotations(4, Eigen::Matrix3f::Identity());
+
+	// libmat and the built-in writer both keep the native classes
+	matlab::MatFile::OPEN_MODE writeModes[2] = { matlab::MatFile::WRITE, matlab::MatFile::WRITE_NATIVE };
+	for (size_t i=0; i<2; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		file.setNumericStorage(matlab::STORE_NATIVE);
+		assert(file.put("floats", floats));
+		assert(file.put("ints", ints));
+		assert(file.put("count", count));
+		assert(file.put("A", A));
+		assert(file.put("rotations", rotations));
+		assert(file.close());
+
+		matlab::MatFile::OPEN_MODE readModes[2] = { matlab::MatFile::READ, matlab::MatFile::READ_MAPPED };
+		for (size_t j=0; j<2; j++)
+		{
+			assert(file.open("test.mat", readModes[j]));
+
+			std::vector<float> floatsTest;
+			std::vector<int> intsTest;
+			size_t countTest = 0;
+			Eigen::MatrixXd ATest;
+			std::vector<Eigen::Matrix3f> rotationsTest;
+			assert(file.get("floats", floatsTest));
+			assert(file.get("ints", intsTest));
+			assert(file.get("count", countTest));
+			assert(file.get("A", ATest));
+			assert(file.get("rotations", rotationsTest));
+
+			assert(floatsTest == floats);
+			assert(intsTest == ints);
+			assert(countTest == count);
+			assert(ATest == A.cast<double>());
+			assert(rotationsTest.size() == rotations.size() && rotationsTest[3] == rotations[3]);
+
+			assert(file.close());
+		}
+
+		// single variables cannot be mapped as double
+		assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+		Eigen::Map<const Eigen::MatrixXd> AMap(NULL, 0, 0);
+		assert(!file.getMap("A", AMap));
+		assert(file.close());
+	}
+
+	// appended variables keep the class of their first slice
+	assert(file.open("test.mat", matlab::MatFile::WRITE_NATIVE));
+	file.setNumericStorage(matlab::STORE_NATIVE);
+	for (size_t i=0; i<3; i++)
+	{
+		assert(file.append("stream", Eigen::Vector3f(float(i), 1.0f, 2.0f)));
+	}
+	assert(file.close());
+
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	Eigen::MatrixXd stream;
+	assert(file.get("stream", stream));
+	assert(stream.rows() == 3 && stream.cols() == 3 && stream(0, 2) == 2.0);
+	assert(file.close());
+}
+
+void testStatistics()
+{
+	matlab::MatFile file;
+	Eigen::MatrixXd A = Eigen::MatrixXd::Random(10, 20);
+
+	// nothing is recorded while disabled
+	assert(file.open("test.mat", matlab::MatFile::WRITE));
+	assert(file.put("A", A));
+	assert(file.close());
+	assert(file.stats()[matlab::Statistics::PUT].calls == 0);
+
+	file.statistics().setEnabled(true);
+	matlab::MatFile::OPEN_MODE writeModes[2] = { matlab::MatFile::WRITE, matlab::MatFile::WRITE_NATIVE };
+	for (size_t i=0; i<2; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("A", A));
+		assert(file.close());
+	}
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	Eigen::MatrixXd ATest;
+	assert(file.get("A", ATest));
+	assert(!file.get("missing", ATest));
+	assert(file.close());
+
+	matlab::Statistics::Snapshot stats = file.stats();
+	assert(stats[matlab::Statistics::OPEN].calls == 3 && stats[matlab::Statistics::CLOSE].calls == 3);
+	assert(stats[matlab::Statistics::PUT].calls == 2 && stats[matlab::Statistics::PUT].failures == 0);
+	assert(stats[matlab::Statistics::PUT].arrays == 1); // libmat needs an mxArray, the built-in writer does not
+	assert(stats[matlab::Statistics::PUT].bytes >= 2*A.size()*sizeof(double));
+	assert(stats[matlab::Statistics::GET].calls == 2 && stats[matlab::Statistics::GET].failures == 1);
+	assert(stats[matlab::Statistics::GET].bytes == A.size()*sizeof(double));
+	assert(stats[matlab::Statistics::GET].latency.count() == 2);
+	std::cout<<stats.toString();
+}
+
+void testGetSlice()
+{
+	matlab::MatFile file;
+	Eigen::MatrixXd A = Eigen::MatrixXd::Random(1000, 20);
+
+	matlab::MatFile::OPEN_MODE writeModes[5] = { matlab::MatFile::WRITE, matlab::MatFile::WRITE_COMPRESSED,
+			matlab::MatFile::WRITE_HDF5, matlab::MatFile::WRITE_NATIVE, matlab::MatFile::WRITE_NATIVE_COMPRESSED };
+	for (size_t i=0; i<5; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("A", A));
+		assert(file.put("text", std::string("no numbers")));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ));
+		Eigen::MatrixXd column, block;
+		assert(file.getSlice("A", matlab::IndexRange::all(), matlab::IndexRange(5, 1), column));
+		assert(column == A.col(5));
+		assert(file.getSlice("A", matlab::IndexRange(100, 50), matlab::IndexRange(18), block));
+		assert(block == A.block(100, 18, 50, 2));
+		Eigen::Matrix<double, 2, 2, Eigen::RowMajor> fixed;
+		assert(file.getSlice("A", matlab::IndexRange(998), matlab::IndexRange(0, 2), fixed));
+		assert(fixed == A.block(998, 0, 2, 2));
+
+		assert(!file.getSlice("A", matlab::IndexRange(0, 1001), matlab::IndexRange(0, 1), block));
+		assert(!file.getSlice("missing", matlab::IndexRange(0, 1), matlab::IndexRange(0, 1), block));
+		assert(!file.getSlice("text", matlab::IndexRange(0, 1), matlab::IndexRange(0, 1), block));
+		assert(file.close());
+	}
+
+	// variables put since the file was opened are read through libmat, 3-D arrays as rows x (numel/rows)
+	std::vector<Eigen::Matrix3d> rotations(4, Eigen::Matrix3d::Identity());
+	rotations[2] = Eigen::Matrix3d::Random();
+	assert(file.open("test.mat", matlab::MatFile::UPDATE));
+	assert(file.put("rotations", rotations));
+	file.statistics().setEnabled(true);
+	Eigen::Matrix3d rotation;
+	assert(file.getSlice("rotations", matlab::IndexRange::all(), matlab::IndexRange(6, 3), rotation));
+	assert(rotation == rotations[2]);
+	assert(file.stats()[matlab::Statistics::GET].calls == 1);
+	file.statistics().setEnabled(false);
+	assert(file.close());
+}
+
+void testStructs()
+{
+	matlab::MatFile file;
+	TestConfig config = createTestConfig(1);
+	std::vector<TestConfig> configs(3, createTestConfig(2));
+
+	// structs written by libmat and by the built-in writer
+	matlab::MatFile::OPEN_MODE writeModes[3] = { matlab::MatFile::WRITE_COMPRESSED,
+			matlab::MatFile::WRITE_NATIVE, matlab::MatFile::WRITE_NATIVE_COMPRESSED };
+	for (size_t i=0; i<3; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("config", config));
+		assert(file.put("configs", configs, true));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ));
+		TestConfig configTest;
+		std::vector<TestConfig> configsTest;
+		assert(file.get("config", configTest) && configTest == config);
+		assert(file.get("configs", configsTest) && configsTest == configs);
+		std::vector<size_t> dims;
+		assert(file.getVariableDims("configs", dims) && dims.size() == 2 && dims[1] == 3);
+		assert(file.close());
+	}
+
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	TestConfig configTest;
+	assert(!file.get("config", configTest));
+	assert(file.close());
+}
+
+void testSparse()
+{
+	matlab::MatFile file;
+	Eigen::SparseMatrix<double> sparse(200, 100);
+	for (int i=0; i<100; i++) { sparse.insert(2*i, i) = i + 0.5; }
+	sparse.makeCompressed();
+
+	// sparse matrices written by libmat and by the built-in writer
+	matlab::MatFile::OPEN_MODE writeModes[3] = { matlab::MatFile::WRITE,
+			matlab::MatFile::WRITE_NATIVE, matlab::MatFile::WRITE_NATIVE_COMPRESSED };
+	for (size_t i=0; i<3; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("sparse", sparse));
+		assert(file.put("after", 3.0));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ));
+		Eigen::SparseMatrix<double> sparseTest;
+		double after = 0;
+		assert(file.get("sparse", sparseTest) && sparseTest.isApprox(sparse) && sparseTest.nonZeros() == 100);
+		assert(file.get("after", after) && after == 3.0);
+		assert(file.close());
+	}
+
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	Eigen::SparseMatrix<double> sparseTest;
+	assert(!file.get("sparse", sparseTest));
+	assert(file.close());
+}
+
+void testComplex()
+{
+	matlab::MatFile file;
+	Eigen::MatrixXcd spectrum = Eigen::MatrixXcd::Random(40, 30);
+	std::vector<std::complex<float> > samples(50, std::complex<float>(0.5f, -1.5f));
+
+	// both parts in one variable, written by libmat and by the built-in writer
+	matlab::MatFile::OPEN_MODE writeModes[3] = { matlab::MatFile::WRITE,
+			matlab::MatFile::WRITE_NATIVE, matlab::MatFile::WRITE_NATIVE_COMPRESSED };
+	for (size_t i=0; i<3; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("spectrum", spectrum));
+		assert(file.put("samples", samples));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ));
+		Eigen::MatrixXcd spectrumTest;
+		std::vector<std::complex<float> > samplesTest;
+		assert(file.get("spectrum", spectrumTest) && spectrumTest == spectrum);
+		assert(file.get("samples", samplesTest) && samplesTest == samples);
+		assert(file.close());
+	}
+}
+
+void testFixedSize()
+{
+	matlab::MatFile file;
+	Eigen::Matrix3d rotation = Eigen::Matrix3d::Random();
+	Eigen::Matrix<double, 6, 1> twist = Eigen::Matrix<double, 6, 1>::Random();
+
+	assert(file.open("test.mat", matlab::MatFile::WRITE_NATIVE));
+	assert(file.put("rotation", rotation));
+	assert(file.put("twist", twist.transpose()));
+	assert(file.close());
+
+	// read through libmat and from the mapping
+	matlab::MatFile::OPEN_MODE readModes[2] = { matlab::MatFile::READ, matlab::MatFile::READ_MAPPED };
+	for (size_t i=0; i<2; i++)
+	{
+		assert(file.open("test.mat", readModes[i]));
+		Eigen::Matrix3d rotationTest;
+		Eigen::Matrix<float, 3, 3, Eigen::RowMajor> rotationFloat;
+		Eigen::Matrix<double, 6, 1> twistTest;
+		assert(file.get("rotation", rotationTest) && rotationTest == rotation);
+		assert(file.get("rotation", rotationFloat) && rotationFloat == rotation.cast<float>());
+		assert(file.get("twist", twistTest) && twistTest == twist);
+		assert(file.close());
+	}
+}
+
+void testStrings()
+{
+	matlab::MatFile file;
+	std::vector<std::string> labels(1000);
+	for (size_t i=0; i<labels.size(); i++) { labels[i] = "label " + std::to_string(i); }
+
+	// a cell array, written by libmat and by the built-in writer
+	matlab::MatFile::OPEN_MODE writeModes[3] = { matlab::MatFile::WRITE,
+			matlab::MatFile::WRITE_NATIVE, matlab::MatFile::WRITE_NATIVE_COMPRESSED };
+	for (size_t i=0; i<3; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("labels", labels));
+		assert(file.put("name", std::string("trajectory")));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ));
+		std::vector<std::string> labelsTest;
+		std::string nameTest;
+		assert(file.get("labels", labelsTest) && labelsTest == labels);
+		assert(file.get("name", nameTest) && nameTest == "trajectory");
+		assert(file.close());
+	}
+
+	// uncompressed cells are read from the mapping
+	assert(file.open("test.mat", matlab::MatFile::WRITE_NATIVE));
+	assert(file.put("labels", labels));
+	assert(file.close());
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	std::vector<std::string> labelsTest;
+	assert(file.get("labels", labelsTest) && labelsTest == labels);
+	assert(file.close());
+
+	// UTF-8 strings survive the built-in writer and the mapped reader
+	std::string unit("\xc2\xb0" "C");
+	assert(file.open("test.mat", matlab::MatFile::WRITE_NATIVE));
+	assert(file.put("unit", unit));
+	assert(file.close());
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	std::string unitTest;
+	assert(file.get("unit", unitTest) && unitTest == unit);
+	assert(file.close());
+}
+
+void testSlices()
+{
+	matlab::MatFile file;
+	matlab::MatrixSlicesXd poses(4, 4, 100);
+	poses.matrix().setRandom();
+
+	matlab::MatFile::OPEN_MODE writeModes[3] = { matlab::MatFile::WRITE,
+			matlab::MatFile::WRITE_NATIVE, matlab::MatFile::WRITE_NATIVE_COMPRESSED };
+	for (size_t i=0; i<3; i++)
+	{
+		assert(file.open("test.mat", writeModes[i]));
+		assert(file.put("poses", poses));
+		assert(file.close());
+
+		assert(file.open("test.mat", matlab::MatFile::READ));
+		matlab::MatrixSlicesXd posesTest;
+		std::vector<Eigen::MatrixXd> posesVector;
+		assert(file.get("poses", posesTest) && posesTest == poses);
+		assert(file.get("poses", posesVector) && posesVector.size() == 100 && posesVector[9] == poses.slice(9));
+		assert(file.close());
+	}
+
+	// one copy from the mapping, or none through getMap
+	assert(file.open("test.mat", matlab::MatFile::WRITE_NATIVE));
+	assert(file.put("poses", poses));
+	assert(file.close());
+	assert(file.open("test.mat", matlab::MatFile::READ_MAPPED));
+	matlab::MatrixSlicesXd posesTest;
+	assert(file.get("poses", posesTest) && posesTest == poses);
+	Eigen::Map<const Eigen::MatrixXd> view(NULL, 0, 0);
+	assert(file.getMap("poses", view) && view == poses.matrix());
+	assert(view.middleCols(9*4, 4) == poses.slice(9));
+	assert(file.close());
+}
+
 #endif /* MATFILETEST_HPP_ */
@@ -0,0 +1,115 @@
+/*
+ * MatSliceReaderTest.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATSLICEREADERTEST_HPP_
+#define MATSLICEREADERTEST_HPP_
+
+#include <cassert>
+#include <iostream>
+
+#ifdef MATLAB_CPP_INTERFACE_HDF5
+#include <hdf5.h>
+#endif
+
+#include <matlabCppInterface/internal/MatSliceReader.hpp>
+
+#include <MatV5DirectoryTest.hpp>
+
+void testMatSliceReader()
+{
+	std::cout<<"Testing partial reads of MAT-file variables"<<std::endl;
+
+	Eigen::MatrixXd A = Eigen::MatrixXd::Random(3000, 20);
+	Eigen::MatrixXi B = Eigen::MatrixXi::Random(5, 7);
+	std::vector<Eigen::MatrixXd> C(4, Eigen::MatrixXd::Constant(2, 3, 1.0));
+	C[3](1, 2) = 5.0;
+
+	matlab::MatV5Writer writer;
+	writer.setNumericStorage(matlab::STORE_NATIVE);
+	assert(writer.open("test_slice.mat"));
+	assert(writer.write("A", A));
+	assert(writer.write("B", B));
+	assert(writer.write("C", C));
+	assert(writer.close());
+	compressMatV5File("test_slice.mat", "test_slice_compressed.mat");
+
+	const char* files[2] = { "test_slice.mat", "test_slice_compressed.mat" };
+	for (size_t i=0; i<2; i++)
+	{
+		matlab::MatV5Directory directory;
+		assert(directory.build(files[i]));
+
+		// one column, a block and everything
+		Eigen::MatrixXd column(3000, 1);
+		matlab::IndexRange rows = matlab::IndexRange::all();
+		assert(rows.resolve(3000));
+		assert(matlab::MatSliceReader::readV5(files[i], *directory.find("A"), rows, matlab::IndexRange(7, 1), column.data()));
+		assert(column == A.col(7));
+
+		Eigen::MatrixXf block(10, 3);
+		assert(matlab::MatSliceReader::readV5(files[i], *directory.find("A"), matlab::IndexRange(2990, 10), matlab::IndexRange(17, 3), block.data()));
+		assert(block == A.block(2990, 17, 10, 3).cast<float>());
+
+		Eigen::MatrixXi all(5, 7);
+		assert(matlab::MatSliceReader::readV5(files[i], *directory.find("B"), matlab::IndexRange(0, 5), matlab::IndexRange(0, 7), all.data()));
+		assert(all == B);
+
+		// N-dimensional arrays are rows x (numel/rows)
+		Eigen::MatrixXd last(2, 3);
+		assert(matlab::MatSliceReader::readV5(files[i], *directory.find("C"), matlab::IndexRange(0, 2), matlab::IndexRange(9, 3), last.data()));
+		assert(last == C[3]);
+
+		// out of range
+		assert(!matlab::MatSliceReader::readV5(files[i], *directory.find("B"), matlab::IndexRange(3, 3), matlab::IndexRange(0, 1), all.data()));
+		assert(!matlab::MatSliceReader::readV5(files[i], *directory.find("B"), matlab::IndexRange(0, 1), matlab::IndexRange(7, 1), all.data()));
+	}
+
+	// a variable that moved since the directory was built is not read at its old offset
+	matlab::MatV5Directory directory;
+	assert(directory.build("test_slice.mat"));
+	matlab::MatV5Directory::Entry moved = *directory.find("B");
+	assert(writer.open("test_slice.mat") && writer.write("A", A) && writer.write("X", B) && writer.close());
+	Eigen::MatrixXi all(5, 7);
+	assert(!matlab::MatSliceReader::readV5("test_slice.mat", moved, matlab::IndexRange(0, 5), matlab::IndexRange(0, 7), all.data()));
+	directory.invalidateOffsets();
+	assert(directory.find("A")->offset == 0 && directory.find("B")->offset == 0);
+
+	matlab::IndexRange range(5);
+	assert(range.resolve(8) && range.size == 3);
+	assert(!matlab::IndexRange(5, 4).resolve(8));
+
+#ifdef MATLAB_CPP_INTERFACE_HDF5
+	// v7.3 files store the transposed matrix
+	hid_t file = H5Fcreate("test_slice.h5", H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	hsize_t dims[2] = { 20, 3000 };
+	hsize_t chunk[2] = { 1, 1000 };
+	hid_t space = H5Screate_simple(2, dims, NULL);
+	hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+	H5Pset_chunk(properties, 2, chunk);
+	hid_t dataset = H5Dcreate2(file, "A", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+	H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, A.data());
+	H5Dclose(dataset);
+	H5Pclose(properties);
+	H5Sclose(space);
+	H5Fclose(file);
+
+	Eigen::MatrixXd block(100, 2);
+	assert(matlab::MatSliceReader::supportsHdf5());
+	assert(matlab::MatSliceReader::readHdf5("test_slice.h5", "A", matlab::IndexRange(1500, 100), matlab::IndexRange(3, 2), block.data()));
+	assert(block == A.block(1500, 3, 100, 2));
+	assert(!matlab::MatSliceReader::readHdf5("test_slice.h5", "missing", matlab::IndexRange(0, 1), matlab::IndexRange(0, 1), block.data()));
+	assert(!matlab::MatSliceReader::readHdf5("test_slice.h5", "A", matlab::IndexRange(2950, 100), matlab::IndexRange(3, 2), block.data()));
+	assert(!matlab::MatSliceReader::readHdf5("test_slice.mat", "A", matlab::IndexRange(0, 1), matlab::IndexRange(0, 1), block.data()));
+	remove("test_slice.h5");
+#endif
+
+	remove("test_slice.mat");
+	remove("test_slice_compressed.mat");
+
+	std::cout<<"Finished partial reads of MAT-file variables"<<std::endl;
+}
+
+#endif /* MATSLICEREADERTEST_HPP_ */
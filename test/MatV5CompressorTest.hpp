@@ -0,0 +1,127 @@
+/*
+ * MatV5CompressorTest.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5COMPRESSORTEST_HPP_
+#define MATV5COMPRESSORTEST_HPP_
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <zlib.h>
+
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+#include <matlabCppInterface/internal/MatV5Directory.hpp>
+#include <matlabCppInterface/internal/MatSliceReader.hpp>
+
+#include <MatV5DirectoryTest.hpp>
+
+void writeCompressorTestFile(matlab::MatV5Writer& writer, const std::string& filename, const Eigen::MatrixXd& large)
+{
+	writer.setNumericStorage(matlab::STORE_NATIVE);
+	assert(writer.open(filename));
+	assert(writer.write("a", 1.5));
+	assert(writer.write("text", std::string("some text")));
+	assert(writer.write("large", large));
+	assert(writer.write("samples", std::vector<int>(1000, 3)));
+	assert(writer.write("empty", Eigen::MatrixXd()));
+	for (int i=0; i<50; i++) { assert(writer.append("trace", Eigen::Vector3f::Constant(i))); }
+	assert(writer.close());
+}
+
+void testMatV5Compressor()
+{
+	std::cout<<"Testing the multithreaded MAT-file compression"<<std::endl;
+
+	// several chunks of one variable and many small variables
+	Eigen::MatrixXd large = Eigen::MatrixXd::Random(500, 700);
+	large.leftCols(300).setZero();
+
+	matlab::MatV5Writer writer;
+	writeCompressorTestFile(writer, "test_uncompressed.mat", large);
+	std::vector<char> uncompressed = readMatV5File("test_uncompressed.mat");
+
+	int levels[3] = { 1, 6, 9 };
+	size_t threads[3] = { 3, 1, 8 };
+	for (size_t i=0; i<3; i++)
+	{
+		writer.setCompressionLevel(levels[i]);
+		writer.setCompressionThreads(threads[i]);
+		uint64_t bytesWritten = writer.bytesWritten();
+		writeCompressorTestFile(writer, "test_compressed.mat", large);
+		std::vector<char> compressed = readMatV5File("test_compressed.mat");
+		assert(compressed.size() < uncompressed.size());
+		assert(writer.bytesWritten() - bytesWritten >= compressed.size());
+
+		// every element inflates to the uncompressed element, uncompress checks the zlib header and checksum
+		matlab::MatV5Directory directory;
+		assert(directory.build("test_compressed.mat"));
+		assert(directory.entries().size() == 6);
+		size_t offset = matlab::matv5::HEADER_SIZE;
+		for (size_t j=0; j<directory.entries().size(); j++)
+		{
+			const matlab::MatV5Directory::Entry& entry = directory.entries()[j];
+			uint32_t tag[2];
+			memcpy(tag, &uncompressed[offset], sizeof(tag));
+			uLongf elementBytes = matlab::matv5::TAG_SIZE + matlab::matv5::padded(tag[1]);
+
+			// appended variables grow in place, they are not compressed
+			assert(entry.compressed == (entry.name != "trace"));
+			if (!entry.compressed)
+			{
+				assert(entry.bytes == elementBytes);
+				assert(memcmp(&compressed[entry.offset], &uncompressed[offset], elementBytes) == 0);
+				offset += elementBytes;
+				continue;
+			}
+
+			std::vector<char> element(elementBytes);
+			assert(uncompress(reinterpret_cast<Bytef*>(element.data()), &elementBytes,
+					reinterpret_cast<const Bytef*>(&compressed[entry.offset + matlab::matv5::TAG_SIZE]), entry.bytes - matlab::matv5::TAG_SIZE) == Z_OK);
+			assert(elementBytes == element.size());
+			assert(memcmp(element.data(), &uncompressed[offset], element.size()) == 0);
+			offset += element.size();
+		}
+		assert(offset == uncompressed.size());
+
+		Eigen::MatrixXd column(500, 1);
+		assert(matlab::MatSliceReader::readV5("test_compressed.mat", *directory.find("large"),
+				matlab::IndexRange(0, 500), matlab::IndexRange(650, 1), column.data()));
+		assert(column == large.col(650));
+
+		// the mapped reader cannot read compressed variables, but it tells that they are there
+		matlab::MatV5Reader reader;
+		assert(reader.open("test_compressed.mat"));
+		assert(reader.hasCompressedVariables() && reader.variables().size() == 1 && reader.find("trace") != NULL);
+		assert(reader.close());
+	}
+
+	// the chunks do not depend on the number of threads, so neither do the elements after the dated header
+	writer.setCompressionLevel(6);
+	size_t sweep[3] = { 1, 2, std::max(1u, std::thread::hardware_concurrency()) };
+	std::vector<char> reference;
+	for (size_t i=0; i<3; i++)
+	{
+		writer.setCompressionThreads(sweep[i]);
+		writeCompressorTestFile(writer, "test_compressed.mat", large);
+		std::vector<char> compressed = readMatV5File("test_compressed.mat");
+		compressed.erase(compressed.begin(), compressed.begin() + matlab::matv5::HEADER_SIZE);
+		if (i == 0) { reference = compressed; }
+		assert(compressed == reference);
+	}
+
+	matlab::MatV5Reader reader;
+	assert(reader.open("test_uncompressed.mat"));
+	assert(!reader.hasCompressedVariables() && reader.find("large") != NULL);
+	assert(reader.close());
+
+	remove("test_uncompressed.mat");
+	remove("test_compressed.mat");
+
+	std::cout<<"Finished the multithreaded MAT-file compression"<<std::endl;
+}
+
+#endif /* MATV5COMPRESSORTEST_HPP_ */
@@ -0,0 +1,385 @@
+/*
+ * MatV5DirectoryTest.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5DIRECTORYTEST_HPP_
+#define MATV5DIRECTORYTEST_HPP_
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <zlib.h>
+
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+#include <matlabCppInterface/internal/MatV5Directory.hpp>
+#include <matlabCppInterface/internal/MatSliceReader.hpp>
+#include <matlabCppInterface/internal/MatV5Reader.hpp>
+#include <matlabCppInterface/internal/MxArrayWrapper.hpp>
+#include <matlabCppInterface/internal/MxArrayNDimWrapper.hpp>
+
+#include <TestStructs.hpp>
+
+std::vector<char> readMatV5File(const std::string& filename)
+{
+	FILE* file = fopen(filename.c_str(), "rb");
+	assert(file);
+	std::vector<char> content;
+	char buffer[4096];
+	size_t n;
+	while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) { content.insert(content.end(), buffer, buffer + n); }
+	fclose(file);
+	return content;
+}
+
+// rewrites an uncompressed file with every variable in its own miCOMPRESSED element
+void compressMatV5File(const std::string& source, const std::string& destination)
+{
+	std::vector<char> content = readMatV5File(source);
+
+	FILE* out = fopen(destination.c_str(), "wb");
+	assert(out);
+	fwrite(&content[0], 1, matlab::matv5::HEADER_SIZE, out);
+
+	size_t offset = matlab::matv5::HEADER_SIZE;
+	while (offset < content.size())
+	{
+		uint32_t tag[2];
+		memcpy(tag, &content[offset], sizeof(tag));
+		size_t elementBytes = matlab::matv5::TAG_SIZE + matlab::matv5::padded(tag[1]);
+
+		std::vector<Bytef> compressed(compressBound(elementBytes));
+		uLongf compressedBytes = compressed.size();
+		assert(compress(&compressed[0], &compressedBytes, reinterpret_cast<const Bytef*>(&content[offset]), elementBytes) == Z_OK);
+
+		uint32_t compressedTag[2] = { matlab::matv5::miCOMPRESSED, static_cast<uint32_t>(compressedBytes) };
+		fwrite(compressedTag, 1, sizeof(compressedTag), out);
+		fwrite(&compressed[0], 1, compressedBytes, out);
+		offset += elementBytes;
+	}
+	fclose(out);
+}
+
+void testMatV5Directory()
+{
+	std::cout<<"Testing the MAT-file directory"<<std::endl;
+
+	matlab::MatV5Writer writer;
+	assert(writer.open("test_directory.mat"));
+	assert(writer.write("a", 1.5));
+	assert(writer.write("flag", true, true));
+	assert(writer.write("text", std::string("some text")));
+	assert(writer.write("matrix", Eigen::MatrixXd::Random(300, 20)));
+	assert(writer.write("samples", std::vector<int>(1000, 3)));
+	assert(writer.close());
+	compressMatV5File("test_directory.mat", "test_directory_compressed.mat");
+
+	const char* files[2] = { "test_directory.mat", "test_directory_compressed.mat" };
+	for (size_t i=0; i<2; i++)
+	{
+		matlab::MatV5Directory directory;
+		assert(directory.build(files[i]));
+		assert(directory.entries().size() == 5);
+		assert(directory.entries()[0].name == "a" && directory.entries()[4].name == "samples");
+
+		const matlab::MatV5Directory::Entry* matrix = directory.find("matrix");
+		assert(matrix && matrix->arrayClass == matlab::matv5::mxDOUBLE);
+		assert(matrix->dims.size() == 2 && matrix->dims[0] == 300 && matrix->dims[1] == 20);
+		assert(matrix->compressed == (i == 1));
+		assert(i == 1 || matrix->bytes > 300*20*sizeof(double));
+		assert(i == 0 || matrix->bytes < 300*20*sizeof(double));
+
+		const matlab::MatV5Directory::Entry* flag = directory.find("flag");
+		assert(flag && flag->isGlobal() && flag->isLogical() && flag->numberOfElements() == 1);
+		assert(directory.find("text")->arrayClass == matlab::matv5::mxCHAR && directory.find("text")->dims[1] == 9);
+		assert(directory.find("samples")->numberOfElements() == 1000);
+
+		// the entries follow each other
+		for (size_t j=1; j<directory.entries().size(); j++)
+		{
+			assert(directory.entries()[j].offset == directory.entries()[j-1].offset + directory.entries()[j-1].bytes);
+		}
+
+		assert(directory.erase("a") && !directory.find("a") && directory.find("flag") == &directory.entries()[0]);
+	}
+
+	// not a MAT-file
+	FILE* file = fopen("test_directory.txt", "w");
+	fputs("no header", file);
+	fclose(file);
+	matlab::MatV5Directory directory;
+	assert(!directory.build("test_directory.txt"));
+	assert(!directory.build("does_not_exist.mat"));
+
+	// a variable without dimensions, the length of the dimensions element follows the tags of the array and the flags
+	assert(writer.open("test_directory.mat") && writer.write("a", 1.5) && writer.close());
+	file = fopen("test_directory.mat", "r+b");
+	uint32_t noDims = 0;
+	assert(fseek(file, matlab::matv5::HEADER_SIZE + 3*matlab::matv5::TAG_SIZE + sizeof(uint32_t), SEEK_SET) == 0);
+	assert(fwrite(&noDims, sizeof(noDims), 1, file) == 1);
+	fclose(file);
+	assert(!directory.build("test_directory.mat"));
+	matlab::MatV5Reader reader;
+	assert(!reader.open("test_directory.mat"));
+
+	remove("test_directory.mat");
+	remove("test_directory_compressed.mat");
+	remove("test_directory.txt");
+
+	std::cout<<"Finished the MAT-file directory"<<std::endl;
+}
+
+void testMatV5WriterStructs()
+{
+	std::cout<<"Testing structs, cells and sparse arrays in the MAT-file writer"<<std::endl;
+
+	TestLimits limits = { -1.0, 1.0 };
+	std::vector<TestConfig> configs(3, createTestConfig(2));
+	Eigen::MatrixXd after = Eigen::MatrixXd::Random(30, 4);
+
+	matlab::MxArrayWrapper<TestLimits> limitsArray(limits);
+	matlab::MxArrayNDimWrapper<TestConfig, std::allocator<TestConfig> > configsArray(configs);
+	matlab::MxArrayWrapper<double> number(2.0);
+	matlab::MxArrayWrapper<std::string> text(std::string("cell"));
+	mxArray* cells = mxCreateCellMatrix(1, 3);
+	mxSetCell(cells, 0, number.release());
+	mxSetCell(cells, 1, text.release());
+
+	for (int level=0; level<2; level++)
+	{
+		matlab::MatV5Writer writer;
+		writer.setCompressionLevel(level);
+		assert(writer.open("test_structs.mat"));
+		assert(writer.write("limits", limitsArray.mxArrayPtr()));
+		assert(writer.write("configs", configsArray.mxArrayPtr(), true));
+		assert(writer.write("cells", cells));
+		assert(writer.write("after", after));
+		assert(writer.close());
+
+		matlab::MatV5Directory directory;
+		assert(directory.build("test_structs.mat"));
+		assert(directory.entries().size() == 4);
+		assert(directory.find("limits")->arrayClass == matlab::matv5::mxSTRUCT && directory.find("limits")->numberOfElements() == 1);
+		assert(directory.find("configs")->isGlobal() && directory.find("configs")->dims[1] == 3);
+		assert(directory.find("cells")->arrayClass == matlab::matv5::mxCELL);
+
+		// the sizes of the nested elements add up, the following variable is found
+		Eigen::MatrixXd afterRead(30, 4);
+		assert(matlab::MatSliceReader::readV5("test_structs.mat", *directory.find("after"),
+				matlab::IndexRange(0, 30), matlab::IndexRange(0, 4), afterRead.data()));
+		assert(afterRead == after);
+
+		if (level == 0)
+		{
+			// field name length as a small data element, followed by the padded names
+			std::vector<char> content = readMatV5File("test_structs.mat");
+			size_t offset = directory.find("limits")->offset + 56;
+			uint32_t lengthElement[2];
+			memcpy(lengthElement, &content[offset], sizeof(lengthElement));
+			assert(lengthElement[0] == (matlab::matv5::miINT32 | (4 << 16)) && lengthElement[1] == 6);
+			assert(memcmp(&content[offset + 16], "lower\0upper\0", 12) == 0);
+		}
+	}
+
+	// double sparse arrays store the non-zeros in the header flags, complex sparse arrays are not supported
+	Eigen::SparseMatrix<double> identity(40, 40);
+	identity.setIdentity();
+	matlab::MxArrayWrapper<Eigen::SparseMatrix<double> > sparse(identity);
+	mxArray* complex = mxCreateSparse(3, 3, 1, mxCOMPLEX);
+	matlab::MatV5Writer writer;
+	assert(writer.open("test_structs.mat"));
+	assert(writer.write("sparse", sparse.mxArrayPtr()));
+	assert(!writer.write("complex", complex));
+	assert(writer.write("after", after));
+	assert(writer.close());
+	mxDestroyArray(complex);
+
+	matlab::MatV5Directory directory;
+	assert(directory.build("test_structs.mat"));
+	assert(directory.find("sparse")->arrayClass == matlab::matv5::mxSPARSE);
+	assert(directory.find("sparse")->dims[0] == 40 && directory.find("sparse")->dims[1] == 40);
+	std::vector<char> content = readMatV5File("test_structs.mat");
+	uint32_t flags[2];
+	memcpy(flags, &content[directory.find("sparse")->offset + 16], sizeof(flags));
+	assert((flags[0] & 0xff) == matlab::matv5::mxSPARSE && flags[1] == 40);
+
+	// the sparse element has the size of its 40 non-zeros
+	Eigen::MatrixXd afterRead(30, 4);
+	assert(matlab::MatSliceReader::readV5("test_structs.mat", *directory.find("after"),
+			matlab::IndexRange(0, 30), matlab::IndexRange(0, 4), afterRead.data()));
+	assert(afterRead == after);
+
+	mxDestroyArray(cells);
+	remove("test_structs.mat");
+
+	std::cout<<"Finished structs, cells and sparse arrays in the MAT-file writer"<<std::endl;
+}
+
+void testMatV5WriterComplex()
+{
+	std::cout<<"Testing complex arrays in the MAT-file writer"<<std::endl;
+
+	Eigen::Matrix2cd z;
+	z << std::complex<double>(1, 2), std::complex<double>(3, 4), std::complex<double>(5, 6), std::complex<double>(7, 8);
+	matlab::MxArrayWrapper<Eigen::Matrix2cd> zArray(z);
+
+	matlab::MatV5Writer writer;
+	assert(writer.open("test_complex.mat"));
+	assert(writer.write("z", zArray.mxArrayPtr()));
+	assert(writer.write("after", 2.0));
+	assert(writer.close());
+
+	matlab::MatV5Directory directory;
+	assert(directory.build("test_complex.mat"));
+	const matlab::MatV5Directory::Entry& entry = *directory.find("z");
+	assert(entry.arrayClass == matlab::matv5::mxDOUBLE && entry.isComplex());
+	// tag, flags, dimensions and name take 56 bytes
+	assert(entry.bytes == 56 + 2*(8 + 4*sizeof(double)));
+	assert(directory.find("after") != NULL);
+
+	// all real parts in column major order, then all imaginary parts
+	std::vector<char> content = readMatV5File("test_complex.mat");
+	double real[4], imag[4];
+	memcpy(real, &content[entry.offset + 64], sizeof(real));
+	memcpy(imag, &content[entry.offset + 104], sizeof(imag));
+	assert(real[0] == 1 && real[1] == 5 && real[2] == 3 && real[3] == 7);
+	assert(imag[0] == 2 && imag[1] == 6 && imag[2] == 4 && imag[3] == 8);
+
+	remove("test_complex.mat");
+
+	std::cout<<"Finished complex arrays in the MAT-file writer"<<std::endl;
+}
+
+void testMatV5Strings()
+{
+	std::cout<<"Testing string lists in the MAT-file writer and the mapped reader"<<std::endl;
+
+	std::vector<std::string> labels;
+	labels.push_back("x");
+	labels.push_back("");
+	labels.push_back("joint velocity ");
+	matlab::MxArrayNDimWrapper<std::string, std::allocator<std::string> > cellArray(labels);
+	const char* rows[2] = { "left", "right arm" };
+	mxArray* charMatrix = mxCreateCharMatrixFromStrings(2, rows);
+
+	matlab::MatV5Writer writer;
+	assert(writer.open("test_strings.mat"));
+	assert(writer.write("labels", cellArray.mxArrayPtr()));
+	assert(writer.write("rows", charMatrix));
+	assert(writer.write("text", std::string("some text")));
+	// UTF-8 is stored as UTF-16, characters beyond 0xffff as surrogate pairs
+	std::string unit("\xc2\xb0" "C \xe2\x82\xac \xf0\x9f\x98\x80");
+	assert(writer.write("unit", unit));
+	assert(writer.close());
+	mxDestroyArray(charMatrix);
+
+	matlab::MatV5Reader reader;
+	assert(reader.open("test_strings.mat"));
+	assert(reader.find("labels")->arrayClass == matlab::matv5::mxCELL);
+
+	// the strings of the cell array keep their blanks, the rows of a char matrix do not
+	std::vector<std::string> labelsTest;
+	assert(reader.read("labels", labelsTest) && labelsTest == labels);
+	assert(reader.read("rows", labelsTest) && labelsTest.size() == 2 && labelsTest[0] == "left" && labelsTest[1] == "right arm");
+	std::string text;
+	assert(reader.read("text", text) && text == "some text");
+	assert(reader.find("unit")->dims[1] == 7);
+	assert(reader.read("unit", text) && text == unit);
+	assert(reader.read("unit", labelsTest) && labelsTest.size() == 1 && labelsTest[0] == unit);
+	assert(reader.read("text", labelsTest) && labelsTest.size() == 1 && labelsTest[0] == "some text");
+	assert(!reader.read("labels", text));
+	assert(reader.close());
+
+	remove("test_strings.mat");
+
+	std::cout<<"Finished string lists in the MAT-file writer and the mapped reader"<<std::endl;
+}
+
+void testMatV5Slices()
+{
+	std::cout<<"Testing 3-D blocks in the MAT-file writer and the mapped reader"<<std::endl;
+
+	matlab::MatrixSlicesXd poses(4, 4, 50);
+	poses.matrix().setRandom();
+	matlab::MatrixSlicesXf block(2, 3, 6);
+	block.matrix().setRandom();
+
+	matlab::MatV5Writer writer;
+	assert(writer.open("test_slices.mat"));
+	assert(writer.write("poses", poses));
+	writer.setNumericStorage(matlab::STORE_NATIVE);
+	assert(writer.write("block", block));
+	assert(writer.close());
+
+	matlab::MatV5Reader reader;
+	assert(reader.open("test_slices.mat"));
+	assert(reader.find("poses")->dims.size() == 3 && reader.find("block")->arrayClass == matlab::matv5::mxSINGLE);
+
+	matlab::MatrixSlicesXd posesTest;
+	matlab::MatrixSlicesXf blockTest;
+	assert(reader.read("poses", posesTest) && posesTest == poses);
+	assert(reader.read("block", blockTest) && blockTest == block);
+
+	// the mapping already has the layout of the slices, no copy is needed
+	Eigen::Map<const Eigen::MatrixXd> view(NULL, 0, 0);
+	assert(reader.map("poses", view) && view.rows() == 4 && view.cols() == 4*50);
+	assert(view.middleCols(7*4, 4) == poses.slice(7));
+	assert(reader.close());
+
+	remove("test_slices.mat");
+
+	std::cout<<"Finished 3-D blocks in the MAT-file writer and the mapped reader"<<std::endl;
+}
+
+void testMatV5Append()
+{
+	std::cout<<"Testing appends in place in the MAT-file writer"<<std::endl;
+
+	// several 64 KB buffers per variable, the interleaved variables grow past each other
+	const size_t nSamples = 6000;
+	Eigen::MatrixXd A = Eigen::MatrixXd::Random(30, 40);
+	Eigen::Matrix2f R = Eigen::Matrix2f::Random();
+
+	matlab::MatV5Writer writer;
+	assert(writer.open("test_append.mat"));
+	for (size_t i=0; i<nSamples; i++)
+	{
+		assert(writer.append("t", 0.001*i));
+		assert(writer.append("x", Eigen::Vector3d(i, 2.0*i, 3.0*i)));
+		if (i == nSamples/3) { assert(writer.write("A", A)); }
+		if (i >= nSamples/2) { assert(writer.append("R", float(i)*R)); }
+	}
+	assert(writer.write("b", true));
+
+	// names are only written once, like variables that libmat replaces
+	assert(!writer.write("A", A) && !writer.write("t", 1.0) && !writer.write("b", false));
+	assert(!writer.append("A", 1.0) && !writer.append("b", 1.0));
+	assert(writer.close());
+
+	matlab::MatV5Reader reader;
+	assert(reader.open("test_append.mat"));
+	assert(reader.variables().size() == 5);
+
+	Eigen::MatrixXd t, x, ATest;
+	matlab::MatrixSlicesXf RTest;
+	bool b = false;
+	assert(reader.read("t", t) && t.rows() == 1 && t.cols() == Eigen::Index(nSamples));
+	assert(reader.read("x", x) && x.rows() == 3 && x.cols() == Eigen::Index(nSamples));
+	assert(reader.read("A", ATest) && ATest == A);
+	assert(reader.read("R", RTest) && RTest.slices() == Eigen::Index(nSamples - nSamples/2));
+	assert(reader.read("b", b) && b);
+	for (size_t i=0; i<nSamples; i++)
+	{
+		assert(t(0, i) == 0.001*i);
+		assert(x(2, i) == 3.0*i);
+	}
+	assert(RTest.slice(7) == float(nSamples/2 + 7)*R);
+	assert(reader.close());
+
+	remove("test_append.mat");
+
+	std::cout<<"Finished appends in place in the MAT-file writer"<<std::endl;
+}
+
+#endif /* MATV5DIRECTORYTEST_HPP_ */
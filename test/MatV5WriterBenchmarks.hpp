@@ -0,0 +1,125 @@
+/*
+ * MatV5WriterBenchmarks.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef MATV5WRITERBENCHMARKS_HPP_
+#define MATV5WRITERBENCHMARKS_HPP_
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+
+#include <matlabCppInterface/internal/MatV5Writer.hpp>
+
+#include <BenchmarkReport.hpp>
+#include <ConversionBenchmarks.hpp>
+
+#ifndef MX_STANDIN
+#include "mat.h"
+#endif
+
+// a logged trajectory, smooth enough to compress like real data
+Eigen::MatrixXd benchmarkTrajectory(size_t rows, size_t cols)
+{
+	Eigen::MatrixXd trajectory(rows, cols);
+	for (size_t j=0; j<cols; j++)
+	{
+		for (size_t i=0; i<rows; i++) { trajectory(i, j) = std::sin(0.001*j*(i+1)) + 0.01*i; }
+	}
+	return trajectory;
+}
+
+void printFileSize(const char* fileName, size_t bytes)
+{
+	struct stat fileStat;
+	if (stat(fileName, &fileStat) == 0)
+	{
+		std::cout<<"  file size "<<fileStat.st_size<<" bytes, "<<100.0*fileStat.st_size/bytes<<"% of the data"<<std::endl;
+	}
+}
+
+// opens, writes and closes a file per call, so compressed variables are complete when measured
+// the variables of a file are compressed in parallel, by as many threads as the hardware runs unless threads is given
+void benchmarkMatV5WriterLevel(BenchmarkReport& report, const Eigen::MatrixXd& trajectory, int level, size_t threads = 0, size_t nVariables = 8)
+{
+	const char* fileName = "benchmark_writer.mat";
+	size_t elements = nVariables*trajectory.size();
+	size_t bytes = elements*sizeof(double);
+
+	std::ostringstream label;
+	label<<nVariables<<"_trajectories_"<<trajectory.rows()<<"x"<<trajectory.cols();
+	std::ostringstream operation;
+	operation<<"write_level_"<<level;
+	if (threads > 0) { operation<<"_threads_"<<threads; }
+
+	matlab::MatV5Writer writer;
+	writer.setCompressionLevel(level);
+	if (threads > 0) { writer.setCompressionThreads(threads); }
+	measureConversion(report, "mat_v5_writer", label.str(), operation.str(), elements, bytes, std::max<size_t>(3, repetitionsFor(elements)/10), [&]() {
+		bool success = writer.open(fileName);
+		for (size_t i=0; i<nVariables; i++) { success = writer.write("trajectory" + std::to_string(i), trajectory) && success; }
+		success = writer.close() && success;
+		assert(success);
+	});
+
+	printFileSize(fileName, bytes);
+	remove(fileName);
+}
+
+#ifndef MX_STANDIN
+// the same files through libmat, each variable is converted by MxArrayWrapper and put with matPutVariable
+void benchmarkLibmatWriter(BenchmarkReport& report, const Eigen::MatrixXd& trajectory, bool compressed, size_t nVariables = 8)
+{
+	const char* fileName = "benchmark_libmat.mat";
+	size_t elements = nVariables*trajectory.size();
+	size_t bytes = elements*sizeof(double);
+
+	std::ostringstream label;
+	label<<nVariables<<"_trajectories_"<<trajectory.rows()<<"x"<<trajectory.cols();
+
+	measureConversion(report, "libmat", label.str(), compressed ? "write_compressed" : "write", elements, bytes, std::max<size_t>(3, repetitionsFor(elements)/10), [&]() {
+		MATFile* file = matOpen(fileName, compressed ? "wz" : "w");
+		assert(file != NULL);
+		bool success = true;
+		for (size_t i=0; i<nVariables; i++)
+		{
+			matlab::MxArrayWrapper<Eigen::MatrixXd> array(trajectory);
+			success = matPutVariable(file, ("trajectory" + std::to_string(i)).c_str(), array.mxArrayPtr()) == 0 && success;
+		}
+		success = matClose(file) == 0 && success;
+		assert(success);
+	});
+
+	printFileSize(fileName, bytes);
+	remove(fileName);
+}
+#endif
+
+// throughput of the built-in writer, uncompressed and compressed, compared to libmat when built against Matlab
+void benchmarkMatV5Writer(BenchmarkReport& report)
+{
+	std::cout<<"Benchmarking the built-in MAT-file writer"<<std::endl;
+	for (size_t cols=1000; cols<=1000000; cols*=100)
+	{
+		Eigen::MatrixXd trajectory = benchmarkTrajectory(7, cols);
+		benchmarkMatV5WriterLevel(report, trajectory, 0);
+		benchmarkMatV5WriterLevel(report, trajectory, 1);
+		benchmarkMatV5WriterLevel(report, trajectory, 6);
+
+		// the scaling of the compression with the number of threads at a fixed level
+		size_t threads[3] = { 1, 2, std::max(1u, std::thread::hardware_concurrency()) };
+		for (size_t i=0; i<3; i++) { benchmarkMatV5WriterLevel(report, trajectory, 6, threads[i]); }
+#ifndef MX_STANDIN
+		// libmat compresses with the default level of zlib, i.e. 6
+		benchmarkLibmatWriter(report, trajectory, false);
+		benchmarkLibmatWriter(report, trajectory, true);
+#endif
+	}
+}
+
+#endif /* MATV5WRITERBENCHMARKS_HPP_ */
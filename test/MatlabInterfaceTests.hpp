@@ -20,10 +20,52 @@ void testCommand()
   engine.initialize();
   std::string ret = engine.executeCommand("disp('test')");
   std::cout<<"Should return 'test', is returning: "<<ret<<std::endl;
-  assert(engine.executeCommand("disp('test')")==">> test");
+  assert(engine.executeCommand("disp('test')")=="test");
   std::cout<<"Finished testing commands"<<std::endl;
 }
 
+void testOutputCapture()
+{
+  std::cout<<"Testing output capture"<<std::endl;
+  matlab::Engine engine;
+  engine.initialize();
+
+  // by default the output goes to a buffer, which grows after an output did not fit
+  std::string output = engine.executeCommand("disp(repmat('a', 1, 100000))");
+  assert(output.size() < 100000);
+  output = engine.executeCommand("disp(repmat('a', 1, 100000))");
+  assert(output == std::string(100000, 'a'));
+
+  // logged output is never truncated
+  engine.setOutputCapture(matlab::CAPTURE_ALL);
+  output = engine.executeCommand("disp(repmat('a', 1, 300000))");
+  assert(output == std::string(300000, 'a'));
+
+  // the storage of the output string is reused
+  engine.executeCommand("disp('test')", output);
+  assert(output == "test");
+
+  // errors show up in the output
+  output = engine.executeCommand("error('expected failure')");
+  assert(output.find("expected failure") != std::string::npos);
+
+  // output is streamed while the command runs
+  std::string streamed;
+  size_t nPieces = 0;
+  engine.setOutputCallback([&](const std::string& piece) { streamed += piece; nPieces++; });
+  output = engine.executeCommand("for k=1:3, disp(k), pause(0.2), end");
+  assert(nPieces >= 1 && streamed.compare(0, output.size(), output) == 0);
+  engine.setOutputCallback(std::function<void(const std::string&)>());
+
+  // no output is captured at all
+  engine.setOutputCapture(matlab::CAPTURE_NONE);
+  assert(engine.executeCommand("disp('test')").empty());
+  engine.setOutputCapture(matlab::CAPTURE_BUFFERED);
+  assert(engine.executeCommand("disp('test')") == "test");
+
+  std::cout<<"Finished output capture"<<std::endl;
+}
+
 void testPut()
 {
 	std::cout<<"Testing standard type putting"<<std::endl;
@@ -125,6 +167,178 @@ void testGetEigen()
   std::cout<<"Finished eigen type putting/getting"<<std::endl;
 }
 
+void testPutEigenExpressions()
+{
+  std::cout<<"Testing eigen expression putting/getting"<<std::endl;
+
+  matlab::Engine engine;
+  engine.initialize();
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(5, 4);
+  Eigen::MatrixXd B = Eigen::MatrixXd::Random(4, 3);
+  Eigen::Matrix<double, 3, 4, Eigen::RowMajor> C = Eigen::Matrix<double, 3, 4, Eigen::RowMajor>::Random();
+  Eigen::Ref<const Eigen::MatrixXd> ARef(A);
+
+  engine.put("AB", A*B);
+  engine.put("A_block", A.block(1, 1, 3, 2));
+  engine.put("A_row", A.row(2));
+  engine.put("C", C);
+  engine.put("A_ref", ARef);
+  engine.put("A_array", A.array().square());
+  engine.put("A_map", Eigen::Map<Eigen::MatrixXd, 0, Eigen::OuterStride<> >(A.data(), 2, 4, Eigen::OuterStride<>(5)));
+
+  Eigen::MatrixXd test;
+  engine.get("AB", test);
+  assert(test.isApprox(A*B));
+  engine.get("A_block", test);
+  assert(test == A.block(1, 1, 3, 2));
+  engine.get("A_row", test);
+  assert(test == A.row(2));
+  engine.get("C", test);
+  assert(test == C);
+  engine.get("A_ref", test);
+  assert(test == A);
+  engine.get("A_array", test);
+  assert(test == A.array().square().matrix());
+  engine.get("A_map", test);
+  assert(test == A.topRows(2));
+
+  std::cout<<"Finished eigen expression putting/getting"<<std::endl;
+}
+
+void testPutNative()
+{
+  std::cout<<"Testing native class putting/getting"<<std::endl;
+
+  matlab::Engine engine;
+  engine.initialize();
+  engine.setNumericStorage(matlab::STORE_NATIVE);
+
+  std::vector<float> floats(10, 1.5f);
+  std::vector<int> ints(5, -3);
+  size_t count = 4000000000u;
+  Eigen::MatrixXf A = Eigen::MatrixXf::Random(3, 4);
+  std::vector<Eigen::Vector3f> points(6, Eigen::Vector3f(1.0f, 2.0f, 3.0f));
+
+  assert(engine.put("floats", floats));
+  assert(engine.put("ints", ints));
+  assert(engine.put("count", count));
+  assert(engine.put("A", A));
+  assert(engine.put("points", points));
+
+  // Matlab sees the native classes
+  engine.executeCommand("classes = [isa(floats, 'single'), isa(ints, 'int32'), isa(count, 'uint64'), isa(A, 'single'), isa(points, 'single')];");
+  Eigen::MatrixXd classes;
+  engine.get("classes", classes);
+  assert(classes.size() == 5 && classes.minCoeff() == 1.0);
+
+  // and they are read back without going through double
+  std::vector<float> floatsTest;
+  std::vector<int> intsTest;
+  size_t countTest = 0;
+  Eigen::MatrixXd ATest;
+  std::vector<Eigen::Vector3f> pointsTest;
+  engine.get("floats", floatsTest);
+  engine.get("ints", intsTest);
+  engine.get("count", countTest);
+  engine.get("A", ATest);
+  engine.get("points", pointsTest);
+  assert(floatsTest == floats);
+  assert(intsTest == ints);
+  assert(countTest == count);
+  assert(ATest == A.cast<double>());
+  assert(pointsTest.size() == points.size() && pointsTest[5] == points[5]);
+
+  std::cout<<"Finished native class putting/getting"<<std::endl;
+}
+
+void testAsync()
+{
+  std::cout<<"Testing asynchronous operations"<<std::endl;
+
+  matlab::Engine engine;
+  engine.initialize();
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(50, 50);
+  std::vector<double> b(20, 3.0);
+
+  // queued operations are executed in order
+  std::future<bool> putA = engine.putAsync("A", A);
+  std::future<bool> putB = engine.putAsync("b", b);
+  A.setZero(); // the value was already converted
+  std::future<std::string> command = engine.executeCommandAsync("C = A*A; b = 2*b;");
+  std::future<Eigen::MatrixXd> C = engine.getAsync<Eigen::MatrixXd>("C");
+  std::future<std::vector<double> > bTest = engine.getAsync<std::vector<double> >("b");
+  std::future<double> missing = engine.getAsync<double>("doesNotExist");
+
+  assert(putA.get() && putB.get());
+  command.get();
+  assert(C.get().rows() == 50);
+  assert(bTest.get() == std::vector<double>(20, 6.0));
+
+  bool thrown = false;
+  try { missing.get(); } catch (const std::runtime_error&) { thrown = true; }
+  assert(thrown);
+
+  // synchronous calls see the results of all queued operations
+  engine.putAsync("x", 1.0);
+  engine.executeCommandAsync("x = x + 1;");
+  double x = 0;
+  engine.get("x", x);
+  assert(x == 2.0);
+
+  std::cout<<"Finished asynchronous operations"<<std::endl;
+}
+
+void testBatch()
+{
+  std::cout<<"Testing batched putting/getting"<<std::endl;
+
+  matlab::Engine engine;
+  engine.initialize();
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(4, 3);
+  std::vector<double> b(10, 2.0);
+  double c = 3.0;
+
+  matlab::VariableBatch batch;
+  batch.put("A", A);
+  batch.put("b", b);
+  batch.put("c", c);
+  batch.put("empty", std::vector<double>()); // cannot be converted
+
+  std::vector<bool> putStatus = engine.putMany(batch);
+  assert(putStatus.size() == 4 && putStatus[0] && putStatus[1] && putStatus[2] && !putStatus[3]);
+  assert(batch.numberOfPuts() == 0);
+  assert(engine.exists("A") && engine.exists("b") && engine.exists("c"));
+  assert(!engine.exists("matlabCppInterfaceBatch"));
+
+  engine.executeCommand("A = 2*A; c = c + 1;");
+
+  Eigen::MatrixXd ATest;
+  std::vector<double> bTest;
+  double cTest = 0;
+  double missing = 0;
+  batch.get("A", ATest);
+  batch.get("b", bTest);
+  batch.get("c", cTest);
+  batch.get("doesNotExist", missing);
+
+  std::vector<bool> getStatus = engine.getMany(batch);
+  assert(getStatus.size() == 4 && getStatus[0] && getStatus[1] && getStatus[2] && !getStatus[3]);
+  assert(ATest == 2.0*A);
+  assert(bTest == b);
+  assert(cTest == 4.0);
+  assert(!engine.exists("matlabCppInterfaceBatch"));
+
+  // gets stay registered
+  engine.executeCommand("c = 10;");
+  engine.getMany(batch);
+  assert(cTest == 10.0);
+
+  std::cout<<"Finished batched putting/getting"<<std::endl;
+}
+
 void testMixedPut()
 {
   std::cout<<"Testing mixed type putting/getting"<<std::endl;
@@ -0,0 +1,233 @@
+/*
+ * StandInEngine.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef STANDINENGINE_HPP_
+#define STANDINENGINE_HPP_
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+///
+/// @class StandInEngine
+/// @brief a local replacement for matlab::Engine to exercise EnginePool without Matlab.
+///
+/// Like engOpen, initialize() starts a separate process per session, which executes the
+/// commands sent over a pipe. The commands "spin(us)" and "pause(us)" keep that process
+/// busy (on the CPU or sleeping) for the given number of microseconds, everything else
+/// is echoed. The workspace keeps put values as they are, on the side of the caller.
+///
+class StandInEngine
+{
+public:
+	StandInEngine() :
+		_process(-1),
+		_commands(-1),
+		_replies(-1)
+	{}
+
+	~StandInEngine()
+	{
+		// the process exits when its command pipe is closed
+		if (_commands >= 0) { close(_commands); }
+		if (_replies >= 0) { close(_replies); }
+		if (_process > 0) { waitpid(_process, NULL, 0); }
+	}
+
+	bool initialize()
+	{
+		if (_process > 0) { return true; }
+
+		int commands[2], replies[2];
+		if (pipe(commands) != 0) { return false; }
+		if (pipe(replies) != 0)
+		{
+			close(commands[0]);
+			close(commands[1]);
+			return false;
+		}
+
+		// a closed process shows up as failed writes rather than a signal
+		signal(SIGPIPE, SIG_IGN);
+
+		_process = fork();
+		if (_process == 0)
+		{
+			// the pipes of the other sessions are closed, they would never see the end of their commands
+			if (dup2(commands[0], STDIN_FILENO) < 0 || dup2(replies[1], STDOUT_FILENO) < 0) { _exit(1); }
+			for (long fd=STDERR_FILENO+1; fd<sysconf(_SC_OPEN_MAX); fd++) { close(fd); }
+			serve(STDIN_FILENO, STDOUT_FILENO);
+		}
+
+		close(commands[0]);
+		close(replies[1]);
+		if (_process < 0)
+		{
+			close(commands[1]);
+			close(replies[0]);
+			return false;
+		}
+		_commands = commands[1];
+		_replies = replies[0];
+		return true;
+	}
+
+	bool isInitialized() { return _process > 0; }
+
+	std::string executeCommand(const std::string& command)
+	{
+		if (_process <= 0 || command.size() >= MAX_COMMAND_SIZE || command.find('\n') != std::string::npos)
+		{
+			throw std::runtime_error("Command cannot be executed by the stand-in engine");
+		}
+
+		std::string line = command + '\n';
+		std::string reply;
+		if (!writeAll(_commands, line.data(), line.size()) || !readLine(_replies, reply))
+		{
+			throw std::runtime_error("Stand-in engine process is not running");
+		}
+		return reply;
+	}
+
+	template <typename ValueType>
+	bool put(const std::string& name, const ValueType& value)
+	{
+		_workspace[name] = std::shared_ptr<Variable>(new TypedVariable<ValueType>(value));
+		return true;
+	}
+
+	template <typename ValueType>
+	bool get(const std::string& name, ValueType& rValue)
+	{
+		std::map<std::string, std::shared_ptr<Variable> >::iterator it = _workspace.find(name);
+		if (it == _workspace.end()) { return false; }
+
+		TypedVariable<ValueType>* variable = dynamic_cast<TypedVariable<ValueType>*>(it->second.get());
+		if (!variable) { return false; }
+
+		rValue = variable->value;
+		return true;
+	}
+
+private:
+	enum { MAX_COMMAND_SIZE = 4096 };
+
+	struct Variable
+	{
+		virtual ~Variable() {}
+	};
+
+	template <typename ValueType>
+	struct TypedVariable : public Variable
+	{
+		TypedVariable(const ValueType& value) : value(value) {}
+		ValueType value;
+	};
+
+	// the loop of the engine process, it does not allocate since it is forked from a threaded process
+	static void serve(int commands, int replies)
+	{
+		char line[MAX_COMMAND_SIZE + 1];
+		size_t size = 0;
+		while (true)
+		{
+			ssize_t n = read(commands, line + size, MAX_COMMAND_SIZE - size);
+			if (n <= 0) { _exit(0); }
+			size += n;
+
+			char* end = static_cast<char*>(memchr(line, '\n', size));
+			while (end)
+			{
+				*end = '\0';
+				const char* reply = execute(line);
+				if (!writeAll(replies, reply, strlen(reply)) || !writeAll(replies, "\n", 1)) { _exit(1); }
+
+				size -= (end + 1) - line;
+				memmove(line, end + 1, size);
+				end = static_cast<char*>(memchr(line, '\n', size));
+			}
+			if (size == MAX_COMMAND_SIZE) { _exit(1); }
+		}
+	}
+
+	static const char* execute(const char* command)
+	{
+		if (strncmp(command, "spin(", 5) == 0)
+		{
+			timespec end = now();
+			addMicroseconds(end, atol(command + 5));
+			timespec current = now();
+			while (current.tv_sec < end.tv_sec || (current.tv_sec == end.tv_sec && current.tv_nsec < end.tv_nsec)) { current = now(); }
+			return "";
+		}
+		if (strncmp(command, "pause(", 6) == 0)
+		{
+			timespec duration = { 0, 0 };
+			addMicroseconds(duration, atol(command + 6));
+			while (nanosleep(&duration, &duration) != 0) {}
+			return "";
+		}
+		return command;
+	}
+
+	static timespec now()
+	{
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return time;
+	}
+
+	static void addMicroseconds(timespec& time, long microseconds)
+	{
+		time.tv_sec += microseconds / 1000000;
+		time.tv_nsec += (microseconds % 1000000) * 1000;
+		if (time.tv_nsec >= 1000000000)
+		{
+			time.tv_sec++;
+			time.tv_nsec -= 1000000000;
+		}
+	}
+
+	static bool writeAll(int fd, const char* data, size_t nBytes)
+	{
+		while (nBytes > 0)
+		{
+			ssize_t n = write(fd, data, nBytes);
+			if (n <= 0) { return false; }
+			data += n;
+			nBytes -= n;
+		}
+		return true;
+	}
+
+	static bool readLine(int fd, std::string& line)
+	{
+		char c;
+		while (read(fd, &c, 1) == 1)
+		{
+			if (c == '\n') { return true; }
+			line += c;
+		}
+		return false;
+	}
+
+	pid_t _process;
+	int _commands;
+	int _replies;
+	std::map<std::string, std::shared_ptr<Variable> > _workspace;
+};
+
+#endif /* STANDINENGINE_HPP_ */
@@ -0,0 +1,75 @@
+/*
+ * TestStructs.hpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef TESTSTRUCTS_HPP_
+#define TESTSTRUCTS_HPP_
+
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <matlabCppInterface/StructTraits.hpp>
+
+// reflected structs shared by the engine and MAT-file tests
+struct TestLimits
+{
+	double lower;
+	double upper;
+
+	bool operator==(const TestLimits& other) const { return lower == other.lower && upper == other.upper; }
+};
+
+struct TestConfig
+{
+	std::string name;
+	double gain;
+	int iterations;
+	bool enabled;
+	Eigen::MatrixXd weights;
+	std::vector<double> samples;
+	TestLimits limits;
+	std::vector<TestLimits> ranges;
+
+	bool operator==(const TestConfig& other) const
+	{
+		return name == other.name && gain == other.gain && iterations == other.iterations && enabled == other.enabled
+				&& weights == other.weights && samples == other.samples && limits == other.limits && ranges == other.ranges;
+	}
+};
+
+MATLAB_STRUCT_BEGIN(TestLimits)
+	MATLAB_STRUCT_FIELD(lower)
+	MATLAB_STRUCT_FIELD(upper)
+MATLAB_STRUCT_END()
+
+MATLAB_STRUCT_BEGIN(TestConfig)
+	MATLAB_STRUCT_FIELD(name)
+	MATLAB_STRUCT_FIELD(gain)
+	MATLAB_STRUCT_FIELD(iterations)
+	MATLAB_STRUCT_FIELD(enabled)
+	MATLAB_STRUCT_FIELD(weights)
+	MATLAB_STRUCT_FIELD(samples)
+	MATLAB_STRUCT_FIELD(limits)
+	MATLAB_STRUCT_FIELD(ranges)
+MATLAB_STRUCT_END()
+
+TestConfig createTestConfig(int i)
+{
+	TestConfig config;
+	config.name = "config";
+	config.gain = 0.5 + i;
+	config.iterations = 10*i;
+	config.enabled = (i % 2) == 0;
+	config.weights = Eigen::MatrixXd::Random(3, 2);
+	config.samples = std::vector<double>(5, i);
+	config.limits.lower = -i;
+	config.limits.upper = i;
+	config.ranges.resize(2, config.limits);
+	return config;
+}
+
+#endif /* TESTSTRUCTS_HPP_ */
@@ -0,0 +1,34 @@
+#define DEBUG
+#undef NDEBUG
+
+#include <ConversionBenchmarks.hpp>
+#include <EngineBenchmarks.hpp>
+#include <EnginePoolBenchmarks.hpp>
+#include <MatV5WriterBenchmarks.hpp>
+
+// usage: matlabBenchmark [results.csv]
+int main(int argc, char **argv){
+
+	BenchmarkReport report;
+
+	std::cout<<"Starting conversion benchmarks"<<std::endl;
+	benchmarkConversions(report);
+	std::cout<<"Completed conversion benchmarks"<<std::endl;
+
+	std::cout<<"Starting engine benchmarks"<<std::endl;
+	benchmarkLoopbackEngine(report);
+	std::cout<<"Completed engine benchmarks"<<std::endl;
+
+	std::cout<<"Starting engine pool benchmarks"<<std::endl;
+	benchmarkEnginePool(report);
+	std::cout<<"Completed engine pool benchmarks"<<std::endl;
+
+	std::cout<<"Starting MAT-file writer benchmarks"<<std::endl;
+	benchmarkMatV5Writer(report);
+	std::cout<<"Completed MAT-file writer benchmarks"<<std::endl;
+
+	if (argc > 1 && !report.writeCsv(argv[1]))
+	{
+		return 1;
+	}
+}
@@ -0,0 +1,44 @@
+#define DEBUG
+#undef NDEBUG
+// lets the tests check that conversions do not allocate
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include <LoopbackEngineTest.hpp>
+#include <EnginePoolTest.hpp>
+#include <MatV5DirectoryTest.hpp>
+#include <MatSliceReaderTest.hpp>
+#include <MatV5CompressorTest.hpp>
+
+/// The tests that run without Matlab, on the loopback backend and the mx stand-in
+int main(int argc, char **argv){
+
+	std::cout<<"Starting loopback engine test"<<std::endl;
+	testLoopbackEvaluator();
+	testLoopbackEngine();
+	testLoopbackDescribe();
+	testLoopbackStatistics();
+	testLoopbackStructs();
+	testLoopbackSparse();
+	testLoopbackComplex();
+	testLoopbackFixedSize();
+	testLoopbackArrayPool();
+	testLoopbackSharedMemory();
+	testLoopbackStrings();
+	testLoopbackSlices();
+	std::cout<<"Completed loopback engine test"<<std::endl;
+
+	std::cout<<"Starting mat-file directory test"<<std::endl;
+	testMatV5Directory();
+	testMatV5WriterStructs();
+	testMatV5WriterComplex();
+	testMatV5Strings();
+	testMatV5Slices();
+	testMatV5Append();
+	testMatSliceReader();
+	testMatV5Compressor();
+	std::cout<<"Completed mat-file directory test"<<std::endl;
+
+	std::cout<<"Starting engine pool test"<<std::endl;
+	testEnginePoolStandIn();
+	std::cout<<"Completed engine pool test"<<std::endl;
+}
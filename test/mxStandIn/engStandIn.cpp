@@ -0,0 +1,23 @@
+/*
+ * engStandIn.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+// The libeng subset declared in engine.h, without a Matlab to connect to.
+
+#include "engine.h"
+
+#include <cstddef>
+
+Engine* engOpen(const char* startcmd) { return NULL; }
+
+int engClose(Engine* ep) { return 1; }
+
+int engEvalString(Engine* ep, const char* string) { return 1; }
+
+int engOutputBuffer(Engine* ep, char* buffer, int buflen) { return 1; }
+
+int engPutVariable(Engine* ep, const char* name, const mxArray* pm) { return 1; }
+
+mxArray* engGetVariable(Engine* ep, const char* name) { return NULL; }
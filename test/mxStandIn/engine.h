@@ -0,0 +1,24 @@
+/*
+ * engine.h
+ *
+ *  Created on: 17.10.2026
+ */
+
+// Stand-in for Matlab's C engine library (libeng) that goes with the libmx stand-in.
+// No Matlab session can be opened, engOpen always fails; use a LoopbackBackend instead.
+
+#ifndef ENG_STANDIN_ENGINE_H_
+#define ENG_STANDIN_ENGINE_H_
+
+#include "matrix.h"
+
+typedef struct engine Engine;
+
+Engine* engOpen(const char* startcmd);
+int engClose(Engine* ep);
+int engEvalString(Engine* ep, const char* string);
+int engOutputBuffer(Engine* ep, char* buffer, int buflen);
+int engPutVariable(Engine* ep, const char* name, const mxArray* pm);
+mxArray* engGetVariable(Engine* ep, const char* name);
+
+#endif /* ENG_STANDIN_ENGINE_H_ */
@@ -0,0 +1,140 @@
+/*
+ * matrix.h
+ *
+ *  Created on: 17.10.2026
+ */
+
+// In-process stand-in for the subset of Matlab's libmx API used by the conversion
+// layer, so the wrappers can be built and benchmarked without a Matlab installation.
+// Only put this directory on the include path of targets that do not link libmx.
+
+#ifndef MX_STANDIN_MATRIX_H_
+#define MX_STANDIN_MATRIX_H_
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#define MX_STANDIN 1
+
+// Matlab defines it to 1 for the interleaved complex API (mex -R2018a), the stand-in
+// stores the real and imaginary parts separately unless it is defined to 1 for the build
+#ifndef MX_HAS_INTERLEAVED_COMPLEX
+#define MX_HAS_INTERLEAVED_COMPLEX 0
+#endif
+
+typedef size_t mwSize;
+typedef size_t mwIndex;
+typedef ptrdiff_t mwSignedIndex;
+typedef char16_t mxChar;
+typedef bool mxLogical;
+
+typedef enum {
+	mxUNKNOWN_CLASS = 0,
+	mxCELL_CLASS,
+	mxSTRUCT_CLASS,
+	mxLOGICAL_CLASS,
+	mxCHAR_CLASS,
+	mxVOID_CLASS,
+	mxDOUBLE_CLASS,
+	mxSINGLE_CLASS,
+	mxINT8_CLASS,
+	mxUINT8_CLASS,
+	mxINT16_CLASS,
+	mxUINT16_CLASS,
+	mxINT32_CLASS,
+	mxUINT32_CLASS,
+	mxINT64_CLASS,
+	mxUINT64_CLASS,
+	mxFUNCTION_CLASS
+} mxClassID;
+
+typedef enum {
+	mxREAL = 0,
+	mxCOMPLEX
+} mxComplexity;
+
+struct mxArray_tag;
+typedef struct mxArray_tag mxArray;
+
+// statistics of the stand-in, not part of the Matlab API
+struct mxStandInStatistics
+{
+	size_t arraysCreated;
+	size_t arraysDestroyed;
+	size_t allocations; // data buffers, i.e. calls of mxMalloc and mxCalloc
+	size_t bytesAllocated;
+};
+mxStandInStatistics mxStandInGetStatistics();
+void mxStandInResetStatistics();
+
+void* mxMalloc(size_t n);
+void* mxCalloc(size_t n, size_t size);
+void mxFree(void* ptr);
+
+mxArray* mxCreateDoubleMatrix(mwSize m, mwSize n, mxComplexity complexity);
+mxArray* mxCreateDoubleScalar(double value);
+mxArray* mxCreateLogicalScalar(mxLogical value);
+mxArray* mxCreateLogicalMatrix(mwSize m, mwSize n);
+mxArray* mxCreateNumericMatrix(mwSize m, mwSize n, mxClassID classid, mxComplexity complexity);
+mxArray* mxCreateUninitNumericMatrix(mwSize m, mwSize n, mxClassID classid, mxComplexity complexity);
+mxArray* mxCreateUninitNumericArray(mwSize ndim, const mwSize* dims, mxClassID classid, mxComplexity complexity);
+mxArray* mxCreateNumericArray(mwSize ndim, const mwSize* dims, mxClassID classid, mxComplexity complexity);
+mxArray* mxCreateString(const char* str);
+mxArray* mxCreateCharArray(mwSize ndim, const mwSize* dims);
+mxArray* mxCreateCharMatrixFromStrings(mwSize m, const char** str);
+mxArray* mxCreateCellMatrix(mwSize m, mwSize n);
+mxArray* mxCreateStructMatrix(mwSize m, mwSize n, int nfields, const char** fieldnames);
+mxArray* mxCreateSparse(mwSize m, mwSize n, mwSize nzmax, mxComplexity complexity);
+mxArray* mxDuplicateArray(const mxArray* in);
+void mxDestroyArray(mxArray* pa);
+
+mxClassID mxGetClassID(const mxArray* pa);
+const char* mxGetClassName(const mxArray* pa);
+bool mxIsNumeric(const mxArray* pa);
+bool mxIsDouble(const mxArray* pa);
+bool mxIsSingle(const mxArray* pa);
+bool mxIsEmpty(const mxArray* pa);
+bool mxIsChar(const mxArray* pa);
+bool mxIsLogical(const mxArray* pa);
+bool mxIsLogicalScalarTrue(const mxArray* pa);
+bool mxIsComplex(const mxArray* pa);
+bool mxIsSparse(const mxArray* pa);
+bool mxIsStruct(const mxArray* pa);
+bool mxIsCell(const mxArray* pa);
+bool mxIsFromGlobalWS(const mxArray* pa);
+
+mwSize mxGetNumberOfDimensions(const mxArray* pa);
+const mwSize* mxGetDimensions(const mxArray* pa);
+int mxSetDimensions(mxArray* pa, const mwSize* dims, mwSize ndims);
+size_t mxGetM(const mxArray* pa);
+size_t mxGetN(const mxArray* pa);
+size_t mxGetNumberOfElements(const mxArray* pa);
+size_t mxGetElementSize(const mxArray* pa);
+
+double* mxGetPr(const mxArray* pa);
+double* mxGetPi(const mxArray* pa);
+void* mxGetData(const mxArray* pa);
+void* mxGetImagData(const mxArray* pa);
+mxLogical* mxGetLogicals(const mxArray* pa);
+mxChar* mxGetChars(const mxArray* pa);
+double mxGetScalar(const mxArray* pa);
+int mxGetString(const mxArray* pa, char* buf, mwSize buflen);
+char* mxArrayToString(const mxArray* pa);
+
+mwIndex* mxGetIr(const mxArray* pa);
+mwIndex* mxGetJc(const mxArray* pa);
+mwSize mxGetNzmax(const mxArray* pa);
+
+int mxGetNumberOfFields(const mxArray* pa);
+const char* mxGetFieldNameByNumber(const mxArray* pa, int n);
+int mxGetFieldNumber(const mxArray* pa, const char* name);
+int mxAddField(mxArray* pa, const char* name);
+mxArray* mxGetField(const mxArray* pa, mwIndex i, const char* fieldname);
+mxArray* mxGetFieldByNumber(const mxArray* pa, mwIndex i, int fieldnumber);
+void mxSetField(mxArray* pa, mwIndex i, const char* fieldname, mxArray* value);
+void mxSetFieldByNumber(mxArray* pa, mwIndex i, int fieldnumber, mxArray* value);
+mxArray* mxGetCell(const mxArray* pa, mwIndex i);
+void mxSetCell(mxArray* pa, mwIndex i, mxArray* value);
+
+#endif /* MX_STANDIN_MATRIX_H_ */
@@ -0,0 +1,465 @@
+/*
+ * mxStandIn.cpp
+ *
+ *  Created on: 17.10.2026
+ */
+
+// In-process implementation of the libmx subset declared in matrix.h.
+// The storage layout follows the separate complex (pre R2018a) API.
+
+#include "matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+struct mxArray_tag
+{
+	mxClassID classId;
+	bool isComplex;
+	bool isSparse;
+	std::vector<mwSize> dims;
+	size_t elementSize;
+	void* real;
+	void* imag;
+
+	// sparse storage
+	mwSize nzmax;
+	mwIndex* ir;
+	mwIndex* jc;
+
+	// struct and cell storage
+	std::vector<std::string> fieldNames;
+	std::vector<mxArray*> children;
+};
+
+namespace {
+
+// counted atomically, arrays may be created and destroyed on several threads
+std::atomic<size_t> arraysCreated(0);
+std::atomic<size_t> arraysDestroyed(0);
+std::atomic<size_t> allocations(0);
+std::atomic<size_t> bytesAllocated(0);
+
+size_t elementSizeOf(mxClassID classId)
+{
+	switch (classId)
+	{
+		case mxDOUBLE_CLASS: return sizeof(double);
+		case mxSINGLE_CLASS: return sizeof(float);
+		case mxINT8_CLASS: case mxUINT8_CLASS: return 1;
+		case mxINT16_CLASS: case mxUINT16_CLASS: return 2;
+		case mxINT32_CLASS: case mxUINT32_CLASS: return 4;
+		case mxINT64_CLASS: case mxUINT64_CLASS: return 8;
+		case mxLOGICAL_CLASS: return sizeof(mxLogical);
+		case mxCHAR_CLASS: return sizeof(mxChar);
+		case mxCELL_CLASS: case mxSTRUCT_CLASS: return sizeof(mxArray*);
+		default: return 0;
+	}
+}
+
+size_t product(const std::vector<mwSize>& dims)
+{
+	size_t n = 1;
+	for (size_t i=0; i<dims.size(); i++) { n *= dims[i]; }
+	return n;
+}
+
+mxArray* allocate(mxClassID classId, mwSize ndim, const mwSize* dims, mxComplexity complexity, bool initialize = true)
+{
+	mxArray* pa = new mxArray;
+	pa->classId = classId;
+	pa->isComplex = (complexity == mxCOMPLEX);
+	pa->isSparse = false;
+	pa->dims.assign(dims, dims + ndim);
+	// MATLAB never reports less than two dimensions and drops trailing singletons
+	while (pa->dims.size() < 2) { pa->dims.push_back(1); }
+	while (pa->dims.size() > 2 && pa->dims.back() == 1) { pa->dims.pop_back(); }
+	pa->elementSize = elementSizeOf(classId);
+#if MX_HAS_INTERLEAVED_COMPLEX
+	// the parts alternate, each element holds both of them
+	if (pa->isComplex) { pa->elementSize *= 2; }
+#endif
+	pa->nzmax = 0;
+	pa->ir = NULL;
+	pa->jc = NULL;
+	pa->real = NULL;
+	pa->imag = NULL;
+
+	size_t n = product(pa->dims);
+	if (classId == mxCELL_CLASS || classId == mxSTRUCT_CLASS)
+	{
+		pa->children.assign(n, NULL);
+	} else if (n > 0)
+	{
+		pa->real = initialize ? mxCalloc(n, pa->elementSize) : mxMalloc(n*pa->elementSize);
+		if (pa->isComplex && !MX_HAS_INTERLEAVED_COMPLEX) { pa->imag = initialize ? mxCalloc(n, pa->elementSize) : mxMalloc(n*pa->elementSize); }
+	}
+
+	arraysCreated++;
+	return pa;
+}
+
+} // anonymous namespace
+
+mxStandInStatistics mxStandInGetStatistics()
+{
+	mxStandInStatistics statistics;
+	statistics.arraysCreated = arraysCreated;
+	statistics.arraysDestroyed = arraysDestroyed;
+	statistics.allocations = allocations;
+	statistics.bytesAllocated = bytesAllocated;
+	return statistics;
+}
+
+void mxStandInResetStatistics()
+{
+	arraysCreated = 0;
+	arraysDestroyed = 0;
+	allocations = 0;
+	bytesAllocated = 0;
+}
+
+void* mxMalloc(size_t n)
+{
+	allocations++;
+	bytesAllocated += n;
+	return std::malloc(n == 0 ? 1 : n);
+}
+
+void* mxCalloc(size_t n, size_t size)
+{
+	allocations++;
+	bytesAllocated += n*size;
+	return std::calloc(n == 0 ? 1 : n, size == 0 ? 1 : size);
+}
+
+void mxFree(void* ptr) { std::free(ptr); }
+
+mxArray* mxCreateDoubleMatrix(mwSize m, mwSize n, mxComplexity complexity)
+{
+	mwSize dims[2] = {m, n};
+	return allocate(mxDOUBLE_CLASS, 2, dims, complexity);
+}
+
+mxArray* mxCreateDoubleScalar(double value)
+{
+	mxArray* pa = mxCreateDoubleMatrix(1, 1, mxREAL);
+	*static_cast<double*>(pa->real) = value;
+	return pa;
+}
+
+mxArray* mxCreateLogicalScalar(mxLogical value)
+{
+	mxArray* pa = mxCreateLogicalMatrix(1, 1);
+	*static_cast<mxLogical*>(pa->real) = value;
+	return pa;
+}
+
+mxArray* mxCreateLogicalMatrix(mwSize m, mwSize n)
+{
+	mwSize dims[2] = {m, n};
+	return allocate(mxLOGICAL_CLASS, 2, dims, mxREAL);
+}
+
+mxArray* mxCreateNumericMatrix(mwSize m, mwSize n, mxClassID classid, mxComplexity complexity)
+{
+	mwSize dims[2] = {m, n};
+	return allocate(classid, 2, dims, complexity);
+}
+
+mxArray* mxCreateUninitNumericMatrix(mwSize m, mwSize n, mxClassID classid, mxComplexity complexity)
+{
+	mwSize dims[2] = {m, n};
+	return allocate(classid, 2, dims, complexity, false);
+}
+
+mxArray* mxCreateUninitNumericArray(mwSize ndim, const mwSize* dims, mxClassID classid, mxComplexity complexity)
+{
+	return allocate(classid, ndim, dims, complexity, false);
+}
+
+mxArray* mxCreateNumericArray(mwSize ndim, const mwSize* dims, mxClassID classid, mxComplexity complexity)
+{
+	return allocate(classid, ndim, dims, complexity);
+}
+
+mxArray* mxCreateString(const char* str)
+{
+	size_t length = std::strlen(str);
+	mwSize dims[2] = {static_cast<mwSize>(length == 0 ? 0 : 1), length};
+	mxArray* pa = allocate(mxCHAR_CLASS, 2, dims, mxREAL);
+	mxChar* chars = static_cast<mxChar*>(pa->real);
+	for (size_t i=0; i<length; i++) { chars[i] = static_cast<unsigned char>(str[i]); }
+	return pa;
+}
+
+mxArray* mxCreateCharArray(mwSize ndim, const mwSize* dims)
+{
+	return allocate(mxCHAR_CLASS, ndim, dims, mxREAL);
+}
+
+mxArray* mxCreateCharMatrixFromStrings(mwSize m, const char** str)
+{
+	size_t width = 0;
+	for (size_t i=0; i<m; i++) { width = std::max(width, std::strlen(str[i])); }
+	mwSize dims[2] = {m, width};
+	mxArray* pa = allocate(mxCHAR_CLASS, 2, dims, mxREAL);
+	mxChar* chars = static_cast<mxChar*>(pa->real);
+	for (size_t i=0; i<m; i++)
+	{
+		size_t length = std::strlen(str[i]);
+		for (size_t j=0; j<width; j++)
+		{
+			chars[j*m + i] = j < length ? static_cast<unsigned char>(str[i][j]) : ' ';
+		}
+	}
+	return pa;
+}
+
+mxArray* mxCreateCellMatrix(mwSize m, mwSize n)
+{
+	mwSize dims[2] = {m, n};
+	return allocate(mxCELL_CLASS, 2, dims, mxREAL);
+}
+
+mxArray* mxCreateStructMatrix(mwSize m, mwSize n, int nfields, const char** fieldnames)
+{
+	mwSize dims[2] = {m, n};
+	mxArray* pa = allocate(mxSTRUCT_CLASS, 2, dims, mxREAL);
+	pa->fieldNames.assign(fieldnames, fieldnames + nfields);
+	pa->children.assign(m*n*nfields, NULL);
+	return pa;
+}
+
+mxArray* mxCreateSparse(mwSize m, mwSize n, mwSize nzmax, mxComplexity complexity)
+{
+	mwSize dims[2] = {m, n};
+	mxArray* pa = allocate(mxDOUBLE_CLASS, 2, dims, complexity);
+	mxFree(pa->real);
+	mxFree(pa->imag);
+	pa->imag = NULL;
+	if (nzmax == 0) { nzmax = 1; }
+	pa->isSparse = true;
+	pa->nzmax = nzmax;
+	pa->real = mxCalloc(nzmax, pa->elementSize);
+	if (pa->isComplex && !MX_HAS_INTERLEAVED_COMPLEX) { pa->imag = mxCalloc(nzmax, pa->elementSize); }
+	pa->ir = static_cast<mwIndex*>(mxCalloc(nzmax, sizeof(mwIndex)));
+	pa->jc = static_cast<mwIndex*>(mxCalloc(n+1, sizeof(mwIndex)));
+	return pa;
+}
+
+mxArray* mxDuplicateArray(const mxArray* in)
+{
+	if (in == NULL) { return NULL; }
+
+	mxArray* pa = new mxArray(*in);
+	arraysCreated++;
+
+	size_t n = in->isSparse ? in->nzmax : product(in->dims);
+	if (in->real)
+	{
+		pa->real = mxMalloc(n*in->elementSize);
+		std::memcpy(pa->real, in->real, n*in->elementSize);
+	}
+	if (in->imag)
+	{
+		pa->imag = mxMalloc(n*in->elementSize);
+		std::memcpy(pa->imag, in->imag, n*in->elementSize);
+	}
+	if (in->isSparse)
+	{
+		pa->ir = static_cast<mwIndex*>(mxMalloc(in->nzmax*sizeof(mwIndex)));
+		std::memcpy(pa->ir, in->ir, in->nzmax*sizeof(mwIndex));
+		pa->jc = static_cast<mwIndex*>(mxMalloc((in->dims[1]+1)*sizeof(mwIndex)));
+		std::memcpy(pa->jc, in->jc, (in->dims[1]+1)*sizeof(mwIndex));
+	}
+	for (size_t i=0; i<pa->children.size(); i++)
+	{
+		pa->children[i] = mxDuplicateArray(in->children[i]);
+	}
+	return pa;
+}
+
+void mxDestroyArray(mxArray* pa)
+{
+	if (pa == NULL) { return; }
+	mxFree(pa->real);
+	mxFree(pa->imag);
+	mxFree(pa->ir);
+	mxFree(pa->jc);
+	for (size_t i=0; i<pa->children.size(); i++)
+	{
+		mxDestroyArray(pa->children[i]);
+	}
+	arraysDestroyed++;
+	delete pa;
+}
+
+mxClassID mxGetClassID(const mxArray* pa) { return pa->classId; }
+
+const char* mxGetClassName(const mxArray* pa)
+{
+	static const char* names[] = {"unknown", "cell", "struct", "logical", "char", "void", "double", "single",
+		"int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64", "function_handle"};
+	return names[pa->classId];
+}
+
+bool mxIsNumeric(const mxArray* pa) { return pa->classId >= mxDOUBLE_CLASS && pa->classId <= mxUINT64_CLASS; }
+bool mxIsDouble(const mxArray* pa) { return pa->classId == mxDOUBLE_CLASS; }
+bool mxIsSingle(const mxArray* pa) { return pa->classId == mxSINGLE_CLASS; }
+bool mxIsEmpty(const mxArray* pa) { return product(pa->dims) == 0; }
+bool mxIsChar(const mxArray* pa) { return pa->classId == mxCHAR_CLASS; }
+bool mxIsLogical(const mxArray* pa) { return pa->classId == mxLOGICAL_CLASS; }
+bool mxIsLogicalScalarTrue(const mxArray* pa)
+{
+	return mxIsLogical(pa) && product(pa->dims) == 1 && *static_cast<mxLogical*>(pa->real);
+}
+bool mxIsComplex(const mxArray* pa) { return pa->isComplex; }
+bool mxIsSparse(const mxArray* pa) { return pa->isSparse; }
+bool mxIsStruct(const mxArray* pa) { return pa->classId == mxSTRUCT_CLASS; }
+bool mxIsCell(const mxArray* pa) { return pa->classId == mxCELL_CLASS; }
+bool mxIsFromGlobalWS(const mxArray* pa) { return false; }
+
+mwSize mxGetNumberOfDimensions(const mxArray* pa) { return pa->dims.size(); }
+const mwSize* mxGetDimensions(const mxArray* pa) { return pa->dims.data(); }
+
+int mxSetDimensions(mxArray* pa, const mwSize* dims, mwSize ndims)
+{
+	std::vector<mwSize> newDims(dims, dims + ndims);
+	while (newDims.size() < 2) { newDims.push_back(1); }
+	if (!pa->isSparse && product(newDims) != product(pa->dims)) { return 1; }
+	pa->dims = newDims;
+	return 0;
+}
+
+size_t mxGetM(const mxArray* pa) { return pa->dims[0]; }
+size_t mxGetN(const mxArray* pa) { return product(pa->dims) / (pa->dims[0] == 0 ? 1 : pa->dims[0]); }
+size_t mxGetNumberOfElements(const mxArray* pa) { return product(pa->dims); }
+size_t mxGetElementSize(const mxArray* pa) { return pa->elementSize; }
+
+double* mxGetPr(const mxArray* pa) { return static_cast<double*>(pa->real); }
+double* mxGetPi(const mxArray* pa) { return static_cast<double*>(pa->imag); }
+void* mxGetData(const mxArray* pa) { return pa->real; }
+void* mxGetImagData(const mxArray* pa) { return pa->imag; }
+mxLogical* mxGetLogicals(const mxArray* pa) { return static_cast<mxLogical*>(pa->real); }
+mxChar* mxGetChars(const mxArray* pa) { return static_cast<mxChar*>(pa->real); }
+
+double mxGetScalar(const mxArray* pa)
+{
+	if (pa->real == NULL) { return 0.0; }
+	switch (pa->classId)
+	{
+		case mxDOUBLE_CLASS: return *static_cast<double*>(pa->real);
+		case mxSINGLE_CLASS: return *static_cast<float*>(pa->real);
+		case mxINT8_CLASS: return *static_cast<signed char*>(pa->real);
+		case mxUINT8_CLASS: return *static_cast<unsigned char*>(pa->real);
+		case mxINT16_CLASS: return *static_cast<short*>(pa->real);
+		case mxUINT16_CLASS: return *static_cast<unsigned short*>(pa->real);
+		case mxINT32_CLASS: return *static_cast<int*>(pa->real);
+		case mxUINT32_CLASS: return *static_cast<unsigned int*>(pa->real);
+		case mxINT64_CLASS: return static_cast<double>(*static_cast<long long*>(pa->real));
+		case mxUINT64_CLASS: return static_cast<double>(*static_cast<unsigned long long*>(pa->real));
+		case mxLOGICAL_CLASS: return *static_cast<mxLogical*>(pa->real);
+		case mxCHAR_CLASS: return *static_cast<mxChar*>(pa->real);
+		default: return 0.0;
+	}
+}
+
+int mxGetString(const mxArray* pa, char* buf, mwSize buflen)
+{
+	if (!mxIsChar(pa) || buflen == 0) { return 1; }
+	size_t n = product(pa->dims);
+	const mxChar* chars = static_cast<const mxChar*>(pa->real);
+	size_t copied = std::min(n, static_cast<size_t>(buflen - 1));
+	for (size_t i=0; i<copied; i++) { buf[i] = static_cast<char>(chars[i]); }
+	buf[copied] = '\0';
+	return copied == n ? 0 : 1;
+}
+
+char* mxArrayToString(const mxArray* pa)
+{
+	if (!mxIsChar(pa)) { return NULL; }
+	size_t n = product(pa->dims);
+	char* buf = static_cast<char*>(mxMalloc(n+1));
+	mxGetString(pa, buf, n+1);
+	return buf;
+}
+
+mwIndex* mxGetIr(const mxArray* pa) { return pa->ir; }
+mwIndex* mxGetJc(const mxArray* pa) { return pa->jc; }
+mwSize mxGetNzmax(const mxArray* pa) { return pa->nzmax; }
+
+int mxGetNumberOfFields(const mxArray* pa) { return static_cast<int>(pa->fieldNames.size()); }
+
+const char* mxGetFieldNameByNumber(const mxArray* pa, int n)
+{
+	if (n < 0 || n >= mxGetNumberOfFields(pa)) { return NULL; }
+	return pa->fieldNames[n].c_str();
+}
+
+int mxGetFieldNumber(const mxArray* pa, const char* name)
+{
+	for (size_t i=0; i<pa->fieldNames.size(); i++)
+	{
+		if (pa->fieldNames[i] == name) { return static_cast<int>(i); }
+	}
+	return -1;
+}
+
+int mxAddField(mxArray* pa, const char* name)
+{
+	if (!mxIsStruct(pa)) { return -1; }
+	int existing = mxGetFieldNumber(pa, name);
+	if (existing >= 0) { return existing; }
+
+	size_t nFieldsOld = pa->fieldNames.size();
+	size_t n = product(pa->dims);
+	std::vector<mxArray*> children(n*(nFieldsOld+1), NULL);
+	for (size_t i=0; i<n; i++)
+	{
+		for (size_t f=0; f<nFieldsOld; f++)
+		{
+			children[i*(nFieldsOld+1) + f] = pa->children[i*nFieldsOld + f];
+		}
+	}
+	pa->children.swap(children);
+	pa->fieldNames.push_back(name);
+	return static_cast<int>(nFieldsOld);
+}
+
+mxArray* mxGetFieldByNumber(const mxArray* pa, mwIndex i, int fieldnumber)
+{
+	if (!mxIsStruct(pa) || fieldnumber < 0 || fieldnumber >= mxGetNumberOfFields(pa)) { return NULL; }
+	return pa->children[i*pa->fieldNames.size() + fieldnumber];
+}
+
+mxArray* mxGetField(const mxArray* pa, mwIndex i, const char* fieldname)
+{
+	return mxGetFieldByNumber(pa, i, mxGetFieldNumber(pa, fieldname));
+}
+
+void mxSetFieldByNumber(mxArray* pa, mwIndex i, int fieldnumber, mxArray* value)
+{
+	if (!mxIsStruct(pa) || fieldnumber < 0 || fieldnumber >= mxGetNumberOfFields(pa)) { return; }
+	pa->children[i*pa->fieldNames.size() + fieldnumber] = value;
+}
+
+void mxSetField(mxArray* pa, mwIndex i, const char* fieldname, mxArray* value)
+{
+	mxSetFieldByNumber(pa, i, mxGetFieldNumber(pa, fieldname), value);
+}
+
+mxArray* mxGetCell(const mxArray* pa, mwIndex i)
+{
+	if (!mxIsCell(pa) || i >= pa->children.size()) { return NULL; }
+	return pa->children[i];
+}
+
+void mxSetCell(mxArray* pa, mwIndex i, mxArray* value)
+{
+	if (!mxIsCell(pa) || i >= pa->children.size()) { return; }
+	pa->children[i] = value;
+}
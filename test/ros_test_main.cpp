@@ -6,6 +6,11 @@
 
 #include <MatlabInterfaceTests.hpp>
 #include <MatFileTest.hpp>
+#include <MatV5DirectoryTest.hpp>
+#include <MatSliceReaderTest.hpp>
+#include <MatV5CompressorTest.hpp>
+#include <EnginePoolTest.hpp>
+#include <LoopbackEngineTest.hpp>
 
 #include <ros/ros.h>
 
@@ -48,10 +53,15 @@ int main(int argc, char **argv){
 	std::cout<<"Starting matlab engine test"<<std::endl;
 	testInit();
 	testCommand();
+	testOutputCapture();
 	testPut();
 	testPutEigen();
 	testGet();
 	testGetEigen();
+	testPutEigenExpressions();
+	testPutNative();
+	testAsync();
+	testBatch();
 	testMixedPut();
 	testGui();
 	std::cout<<"Completed matlab engine test"<<std::endl;
@@ -61,5 +71,46 @@ int main(int argc, char **argv){
 	testWriteRead();
 	testWriteEigen();
 	testWriteScalarVectors();
+	testWriteNative();
+	testWriteNative(matlab::MatFile::WRITE_NATIVE_COMPRESSED);
+	testReadMapped();
+	testAppend();
+	testNativeStorage();
+	testStatistics();
+	testMatV5Directory();
+	testMatV5WriterStructs();
+	testMatV5WriterComplex();
+	testMatV5Strings();
+	testMatV5Slices();
+	testMatV5Append();
+	testMatSliceReader();
+	testMatV5Compressor();
+	testGetSlice();
+	testStructs();
+	testSparse();
+	testComplex();
+	testFixedSize();
+	testStrings();
+	testSlices();
 	std::cout<<"Completed mat-file test"<<std::endl;
+
+	std::cout<<"Starting engine pool test"<<std::endl;
+	testEnginePoolStandIn();
+	testEnginePool();
+	std::cout<<"Completed engine pool test"<<std::endl;
+
+	std::cout<<"Starting loopback engine test"<<std::endl;
+	testLoopbackEvaluator();
+	testLoopbackEngine();
+	testLoopbackDescribe();
+	testLoopbackStatistics();
+	testLoopbackStructs();
+	testLoopbackSparse();
+	testLoopbackComplex();
+	testLoopbackFixedSize();
+	testLoopbackArrayPool();
+	testLoopbackSharedMemory();
+	testLoopbackStrings();
+	testLoopbackSlices();
+	std::cout<<"Completed loopback engine test"<<std::endl;
 }